@@ -14,9 +14,12 @@
  *  - Size (bits) and number of hash functions are chosen via standard formulas given
  *    expected_items (n) and target false_positive_rate (p):
  *      m = ceil( -n * ln(p) / (ln(2)^2) ),  k = round( (m/n) * ln(2) )
- *  - Double hashing (Kirsch–Mitzenmacher) derives k positions from two 64-bit hashes:
- *      h_i = (h1 + i * h2) mod m
+ *  - Double hashing (Kirsch–Mitzenmacher) derives k positions from the two 64-bit
+ *    halves of one 128-bit hash, reduced onto [0, m) with fastrange (multiply-high):
+ *      h_i = fastrange(h1 + i * h2, m)
  *  - Serialization is little-endian and includes a magic/version header for safety.
+ *    Version 1 filters (two 64-bit hash passes, `% m` reduction) are still accepted
+ *    by Deserialize() and keep probing with their original scheme.
  */
 
 #include <cstddef>
@@ -78,7 +81,8 @@ public:
     /**
      * @brief Serialize to a portable byte buffer (little-endian).
      * @return Buffer in the format:
-     *   [magic: u32="VKBF"][version: u32=1][num_bits: u64][k: u32][pad: u32=0][bit-bytes...]
+     *   [magic: u32="VKBF"][version: u32][num_bits: u64][k: u32][pad: u32=0][bit-bytes...]
+     * where version is 2 for filters built by this code, or 1 if deserialized from v1 bytes.
      */
     std::string serialize() const;
 
@@ -86,21 +90,28 @@ public:
     std::size_t bit_size() const { return num_bits_; }
     std::size_t byte_size() const { return (num_bits_ + 7u) / 8u; }
     std::uint32_t num_hashes() const { return num_hashes_; }
+    std::uint32_t format_version() const { return version_; }
+
+    /// Serialized format / probe-scheme versions.
+    static constexpr std::uint32_t kLegacyVersion  = 1; ///< Two Hash64 passes + modulo.
+    static constexpr std::uint32_t kCurrentVersion = 2; ///< One Hash128 pass + fastrange.
 
 private:
     // Internal constructor used by Deserialize.
-    BloomFilter(std::size_t num_bits, std::uint32_t k, std::vector<std::uint8_t>&& bytes);
+    BloomFilter(std::size_t num_bits, std::uint32_t k, std::uint32_t version,
+                std::vector<std::uint8_t>&& bytes);
 
     // Internal helpers (implemented in .cpp)
     static std::size_t OptimalNumBits(std::size_t n, double p);
     static std::uint32_t OptimalNumHashes(std::size_t n, std::size_t m);
     void set_bit(std::size_t bit_index);
     bool get_bit(std::size_t bit_index) const;
-    void positions(std::string_view key, std::size_t* out, std::uint32_t k) const;
+    void legacy_positions(std::string_view key, std::size_t* out, std::uint32_t k) const;
 
     // State
     std::size_t num_bits_{0};            ///< Total number of bits (m).
     std::uint32_t num_hashes_{0};        ///< Number of hash functions (k).
+    std::uint32_t version_{kCurrentVersion}; ///< Probe scheme / serialized version.
     std::vector<std::uint8_t> bits_;     ///< Bit array (packed in bytes, LSB-first per byte).
 };
 
@@ -0,0 +1,97 @@
+#pragma once
+/**
+ * @file filter_budget.h
+ * @author Vrutik Halani
+ * @brief Per-level Bloom filter sizing under a global memory budget (Monkey-style).
+ *
+ * A point lookup for an absent key probes one filter per level (per sorted run).
+ * Spending the same bits-per-key everywhere is wasteful: the last level holds
+ * most keys, yet a false positive there costs the same single I/O as one in a
+ * tiny upper level. Minimizing the expected number of false-positive I/Os
+ *
+ *     sum_i p_i,   p_i = exp(-b_i * ln(2)^2)
+ *
+ * subject to the memory budget  sum_i n_i * b_i = M  gives FPRs proportional to
+ * the number of entries per level (p_i = K * n_i); levels whose optimal FPR
+ * reaches 1 get no filter and their share is redistributed.
+ *
+ * The budget is expressed as an *average* bits-per-key over all entries and may
+ * be changed at runtime; new values only affect tables built afterwards.
+ */
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace VrootKV::common {
+
+/**
+ * @class FilterBudget
+ * @brief Thread-safe source of bits-per-key for the table builder, by level.
+ *
+ * Usage:
+ *   FilterBudget budget(10.0);                 // average 10 bits per key
+ *   budget.SetLevelEntries({1e4, 1e5, 1e6});   // refreshed as the LSM shape changes
+ *   double bpk = budget.BitsPerKeyForLevel(2); // < 10 for the largest level
+ */
+class FilterBudget {
+public:
+    /// Upper bound on any single level's allocation (keeps k reasonable).
+    static constexpr double kMaxBitsPerKey = 32.0;
+
+    /**
+     * @brief Create a budget of `bits_per_key` bits on average over all entries.
+     */
+    explicit FilterBudget(double bits_per_key);
+
+    /**
+     * @brief Change the global budget (average bits per key). Applies to tables built afterwards.
+     */
+    void SetBitsPerKey(double bits_per_key);
+
+    /// Current global budget (average bits per key).
+    double bits_per_key() const;
+
+    /**
+     * @brief Publish the current number of entries per level (index = level).
+     */
+    void SetLevelEntries(std::vector<std::uint64_t> entries_per_level);
+
+    /**
+     * @brief Bits-per-key the table builder should use for a table at `level`.
+     * @return The Monkey allocation for that level, or the uniform budget when the
+     *         level shape is unknown / the level is empty. 0 means "no filter".
+     */
+    double BitsPerKeyForLevel(int level) const;
+
+    /**
+     * @brief Optimal bits-per-key per level for a total budget of `total_bits`.
+     * @param entries_per_level Entry count per level (zeros allowed).
+     * @param total_bits Total filter bits available across all levels.
+     * @return One value per level; 0 for empty levels or levels not worth filtering.
+     */
+    static std::vector<double> Allocate(const std::vector<std::uint64_t>& entries_per_level,
+                                        double total_bits);
+
+    /**
+     * @brief Expected false-positive I/Os for a lookup of an absent key.
+     * @return sum over non-empty levels of FalsePositiveRate(bits_per_key[i]).
+     */
+    static double ExpectedFalsePositives(const std::vector<std::uint64_t>& entries_per_level,
+                                         const std::vector<double>& bits_per_key);
+
+    /**
+     * @brief FPR of an optimally-hashed Bloom filter with `bits_per_key` bits per entry.
+     */
+    static double FalsePositiveRate(double bits_per_key);
+
+private:
+    void Recompute();  // requires mu_
+
+    mutable std::mutex mu_;
+    double bits_per_key_;
+    std::vector<std::uint64_t> entries_;   ///< Last published level shape.
+    std::vector<double> allocation_;       ///< Cached Allocate() result for entries_.
+};
+
+} // namespace VrootKV::common
@@ -0,0 +1,80 @@
+#pragma once
+/**
+ * @file histogram.h
+ * @author Vrutik Halani
+ * @brief Lock-free, log-linear histogram for latency and size distributions.
+ *
+ * Values (typically nanoseconds) fall into buckets that are exact below 16
+ * and otherwise split each power of two into 8 linear sub-buckets, so any
+ * reported percentile is within 12.5% of the true value. Recording is a
+ * handful of relaxed atomic increments, cheap enough for every I/O.
+ *
+ * Readers may run concurrently with writers; a snapshot taken while values
+ * are being added is approximate (counts and sums may disagree by the
+ * in-flight samples) but never torn within a single counter.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace VrootKV::common {
+
+/**
+ * @class Histogram
+ * @brief Thread-safe distribution of non-negative 64-bit values.
+ *
+ * Usage:
+ *   Histogram h;
+ *   h.Add(latency_ns);
+ *   uint64_t p99 = h.Percentile(99.0);
+ */
+class Histogram {
+public:
+    static constexpr size_t kNumBuckets = 16 + 60 * 8;
+
+    Histogram() { Clear(); }
+
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    /// Record one sample.
+    void Add(uint64_t value);
+
+    /// Add every sample of `other` to this histogram.
+    void Merge(const Histogram& other);
+
+    /// Forget all samples. Not atomic with respect to concurrent `Add()`.
+    void Clear();
+
+    uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t Sum() const { return sum_.load(std::memory_order_relaxed); }
+    /// Smallest sample, or 0 when empty.
+    uint64_t Min() const;
+    uint64_t Max() const { return max_.load(std::memory_order_relaxed); }
+    double Mean() const;
+
+    /**
+     * @brief Approximate value below which `p` percent of samples fall (0 when empty).
+     * @param p Percentile in [0, 100].
+     */
+    uint64_t Percentile(double p) const;
+
+    /// One-line summary: "count=... mean=... p50=... p99=... p99.9=... max=...".
+    std::string ToString() const;
+
+    /// Bucket index of `value` (exposed for tests).
+    static size_t BucketFor(uint64_t value);
+    /// Smallest value that maps to `bucket`.
+    static uint64_t BucketLowerBound(size_t bucket);
+
+private:
+    std::array<std::atomic<uint64_t>, kNumBuckets> buckets_;
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<uint64_t> min_;
+    std::atomic<uint64_t> max_;
+};
+
+} // namespace VrootKV::common
@@ -0,0 +1,54 @@
+#pragma once
+/**
+ * @file iterator.h
+ * @author Vrutik Halani
+ * @brief Bidirectional cursor over sorted key/value pairs.
+ *
+ * One interface for every ordered source: memtables, SSTables, the merge of
+ * several of them, and the database view handed to users by
+ * `DB::NewIterator()`. Keys are ordered bytewise (`std::string_view`
+ * comparison) and are unique within one iterator.
+ *
+ * Contract
+ * --------
+ *  - A new iterator is not positioned (`Valid()` is false) until one of the
+ *    Seek methods is called.
+ *  - `key()`, `value()`, `Next()` and `Prev()` require `Valid()`.
+ *  - The views returned by `key()` and `value()` stay valid until the
+ *    iterator is moved or destroyed.
+ *  - Read failures throw `std::runtime_error` (a failed block read must not
+ *    look like the end of the data).
+ *  - An iterator is not thread-safe; use one per thread.
+ */
+
+#include <string_view>
+
+namespace VrootKV::common {
+
+class Iterator {
+public:
+    virtual ~Iterator() = default;
+
+    /// True if positioned at an entry.
+    virtual bool Valid() const = 0;
+
+    /// Position at the first entry (invalid if empty).
+    virtual void SeekToFirst() = 0;
+
+    /// Position at the last entry (invalid if empty).
+    virtual void SeekToLast() = 0;
+
+    /// Position at the first entry with key >= `target`.
+    virtual void Seek(std::string_view target) = 0;
+
+    /// Move to the next entry (invalid past the last).
+    virtual void Next() = 0;
+
+    /// Move to the previous entry (invalid before the first).
+    virtual void Prev() = 0;
+
+    virtual std::string_view key() const = 0;
+    virtual std::string_view value() const = 0;
+};
+
+} // namespace VrootKV::common
@@ -0,0 +1,92 @@
+#pragma once
+/**
+ * @file range_filter.h
+ * @author Vrutik Halani
+ * @brief Prefix-truncation range filter: "might any key in [lo, hi] exist?"
+ *
+ * Bloom filters only answer point queries, so a short scan must open a data
+ * block in every overlapping SSTable. This filter stores the sorted, de-duplicated
+ * set of key prefixes truncated to `prefix_len` bytes (a flattened trie level).
+ *
+ * Query:
+ *   Truncation is monotone, so any key k in [lo, hi] satisfies
+ *     trunc(lo) <= trunc(k) <= trunc(hi).
+ *   A range may match iff some stored prefix lies in [trunc(lo), trunc(hi)],
+ *   found with one binary search. No false negatives; false positives only when
+ *   the gap between keys is narrower than the prefix resolution.
+ *
+ * Size / precision trade-off:
+ *   Longer prefixes separate more key clusters but store more distinct prefixes.
+ *   On sparse (clustered) key spaces a short prefix already rules out most gaps.
+ *
+ * Serialization (little-endian):
+ *   [magic: u32="VKRF"][version: u32=1][prefix_len: u32][count: u32]
+ *   [offsets: u32 * (count + 1)][prefix bytes...]
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace VrootKV::common {
+
+/**
+ * @class RangeFilter
+ * @brief Sorted set of truncated key prefixes with range-emptiness queries.
+ *
+ * Usage:
+ *   RangeFilter rf(8);
+ *   rf.add("user:000123"); ...
+ *   if (!rf.may_contain_range("user:5", "user:6")) {  skip this table  }
+ */
+class RangeFilter {
+public:
+    /**
+     * @brief Create an empty filter keeping the first `prefix_len` bytes of each key.
+     * @param prefix_len Truncation length; clamped to >= 1.
+     */
+    explicit RangeFilter(std::size_t prefix_len);
+
+    /**
+     * @brief Deserialize a filter produced by serialize().
+     * @throws std::runtime_error on malformed input.
+     */
+    static RangeFilter Deserialize(std::string_view bytes);
+
+    /**
+     * @brief Insert a key. Keys must arrive in non-decreasing order (as in a table build).
+     * @throws std::runtime_error if `key` sorts before the previously added key.
+     */
+    void add(std::string_view key);
+
+    /**
+     * @brief Range query over the inclusive interval [lo, hi].
+     * @return false if no inserted key can lie in [lo, hi]; true otherwise.
+     */
+    bool may_contain_range(std::string_view lo, std::string_view hi) const;
+
+    /**
+     * @brief Point query (equivalent to may_contain_range(key, key)).
+     */
+    bool might_contain(std::string_view key) const { return may_contain_range(key, key); }
+
+    /**
+     * @brief Serialize to a portable byte buffer (see file header for layout).
+     */
+    std::string serialize() const;
+
+    // -------- Introspection (for tests / diagnostics) --------
+    std::size_t prefix_len() const { return prefix_len_; }
+    std::size_t num_prefixes() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+
+private:
+    std::string_view prefix_at(std::size_t i) const;
+
+    std::size_t prefix_len_;
+    std::string data_;                   ///< Sorted distinct prefixes, concatenated.
+    std::vector<std::uint32_t> offsets_; ///< Prefix i is data_[offsets_[i], offsets_[i+1]).
+};
+
+} // namespace VrootKV::common
@@ -0,0 +1,207 @@
+#pragma once
+/**
+ * @file db.h
+ * @author Vrutik Halani
+ * @brief Public key-value store API: `DB::Open()` plus Put/Get/Delete/Write/NewIterator.
+ *
+ * Architecture
+ * ------------
+ *  - Writes are appended to the write-ahead log as one transaction per call
+ *    (`WriteBatch`) and then applied to the active memtable.
+ *  - When the memtable reaches `Options::write_buffer_size` it becomes
+ *    immutable, a fresh memtable and log take over, and a background thread
+ *    writes the immutable one out as a level-0 SSTable. Writers stall only if
+ *    the previous flush has not finished yet.
+ *  - The set of live tables and the log still needed for recovery are
+ *    recorded in the MANIFEST, which is replaced atomically (write + rename).
+ *  - Reads consult the memtable, the immutable memtable, then the tables
+ *    newest-first; the first hit (value or tombstone) decides.
+ *  - Leveled compaction keeps the table count bounded: level 0 (overlapping
+ *    flushed tables) is merged into level 1 once it holds
+ *    `level0_file_num_compaction_trigger` files, and each level L >= 1 is
+ *    merged into L+1 once it exceeds its byte target
+ *    (`max_bytes_for_level_base` × `max_bytes_for_level_multiplier`^(L-1)).
+ *    The level with the highest score (size / target) goes first; up to
+ *    `max_background_compactions` compactions over disjoint tables run in
+ *    parallel. A point read therefore touches at most the L0 tables plus one
+ *    table per deeper level: with the defaults, 1 TB fits in six levels.
+ *  - `CompactionStyle::kUniversal` instead treats every level-0 table and
+ *    every non-empty deeper level as one sorted run and merges runs of
+ *    similar size (size-tiered), rewriting each byte far fewer times at the
+ *    cost of more runs per read and more space held by overwritten data.
+ *  - `Open()` replays the logs the MANIFEST still references, applying only
+ *    committed transactions and stopping at a torn tail, then flushes what it
+ *    recovered to level 0.
+ *
+ * Threading
+ * ---------
+ * A `DB` is thread-safe. Iterators are not (one per thread), see the state
+ * of the database as of their creation, and must be destroyed before the DB.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "VrootKV/common/filter_budget.h"
+#include "VrootKV/common/iterator.h"
+#include "VrootKV/db/write_batch.h"
+#include "VrootKV/io/file_manager.h"
+
+namespace VrootKV::db {
+
+enum class CompactionStyle {
+    kLeveled,    ///< Bounded read and space amplification; high write amplification.
+    kUniversal,  ///< Size-tiered runs; low write amplification for ingest-heavy loads.
+};
+
+struct Options {
+    /// File system to use; not owned, must outlive the DB. Null: the default manager.
+    io::IFileManager* file_manager = nullptr;
+
+    /// Create the database if the directory holds none.
+    bool create_if_missing = true;
+    /// Fail if a database already exists.
+    bool error_if_exists = false;
+
+    /// Memtable size (approximate bytes) at which it is flushed to an SSTable.
+    std::size_t write_buffer_size = 4 << 20;
+    /// Keys expected per memtable; sizes a Bloom filter that lets lookups of
+    /// absent keys skip the memtable search. 0 disables it.
+    std::size_t memtable_bloom_expected_entries = 0;
+    /// Target false-positive rate of the memtable Bloom filter.
+    double memtable_bloom_false_positive_rate = 0.01;
+
+    /// Upper bound on simultaneously open table files.
+    std::size_t max_open_tables = 1000;
+    /// Shared data-block cache budget; 0 disables the cache.
+    std::size_t block_cache_size = 8 << 20;
+    /// Row (point-lookup result) cache budget; 0 disables it.
+    std::size_t row_cache_size = 0;
+
+    /// Bloom filter bits per key in new tables; <= 0 disables filters.
+    double bits_per_key = 10.0;
+    /// Per-level filter sizing; not owned, must outlive the DB. When set it
+    /// replaces `bits_per_key`, may be retuned while the DB runs, and is kept
+    /// up to date with the size of each level.
+    common::FilterBudget* filter_budget = nullptr;
+    /// Target uncompressed data-block size of new tables.
+    std::size_t block_size = 4096;
+
+    // ---- Compaction ----
+
+    CompactionStyle compaction_style = CompactionStyle::kLeveled;
+    /// Background threads running compactions (flushes have their own thread).
+    int max_background_compactions = 1;
+    /// Threads one compaction may be split across: its key space is cut
+    /// into up to this many ranges, each merged in parallel into its own
+    /// tables. Mainly speeds up large level-0 compactions, which otherwise
+    /// run on one thread while level 0 fills and writes stall.
+    int max_subcompactions = 1;
+    /// Number of level-0 tables that triggers a level-0 compaction
+    /// (universal style: number of sorted runs that triggers a merge).
+    int level0_file_num_compaction_trigger = 4;
+    /// Writes wait while level 0 holds this many tables.
+    int level0_stop_writes_trigger = 12;
+    /// Target size of level 1.
+    uint64_t max_bytes_for_level_base = 10ull << 20;
+    /// Each level's target is this many times the one above it.
+    double max_bytes_for_level_multiplier = 10.0;
+    /// Compaction output is cut into tables of about this size.
+    uint64_t target_file_size = 2ull << 20;
+
+    // ---- Universal compaction (compaction_style == kUniversal) ----
+
+    /// Runs are "similar" (merged together) if each is at most (100 + ratio)%
+    /// of the size of the newest run in the group.
+    int universal_size_ratio = 100;
+    /// Fewest runs merged by one tiering compaction (the fan-in per tier),
+    /// and the most.
+    int universal_min_merge_width = 4;
+    int universal_max_merge_width = 1 << 30;
+    /// Merge every run into one when the runs above the oldest one exceed
+    /// this percentage of its size (caps space amplification).
+    int universal_max_size_amplification_percent = 200;
+};
+
+struct ReadOptions {
+    /// Insert blocks read for this operation into the block cache.
+    /// Turn off for one-off scans.
+    bool fill_cache = true;
+};
+
+struct WriteOptions {
+    /// Sync the log before acknowledging the write. Without it a write
+    /// survives a process crash but may be lost on power failure.
+    bool sync = false;
+};
+
+/**
+ * @class DB
+ * @brief Persistent ordered map from byte-string keys to byte-string values.
+ */
+class DB {
+public:
+    /**
+     * @brief Open (recovering if needed) or create the database in `path`.
+     * @throws std::runtime_error if the database cannot be opened or is corrupt.
+     */
+    static std::unique_ptr<DB> Open(const std::string& path, const Options& options = Options());
+
+    virtual ~DB() = default;
+
+    /**
+     * @brief Set `key` to `value`.
+     * @return false if the log write failed (the write is not applied).
+     */
+    virtual bool Put(std::string_view key, std::string_view value,
+                     const WriteOptions& options = WriteOptions()) = 0;
+
+    /**
+     * @brief Remove `key` (not an error if absent).
+     * @return false if the log write failed.
+     */
+    virtual bool Delete(std::string_view key, const WriteOptions& options = WriteOptions()) = 0;
+
+    /**
+     * @brief Apply every operation of `batch` atomically.
+     * @return false if the log write failed (nothing is applied).
+     */
+    virtual bool Write(const WriteBatch& batch, const WriteOptions& options = WriteOptions()) = 0;
+
+    /**
+     * @brief Point lookup.
+     * @return true and fills `value` if `key` is present.
+     * @throws std::runtime_error if a table read fails.
+     */
+    virtual bool Get(std::string_view key, std::string& value,
+                     const ReadOptions& options = ReadOptions()) = 0;
+
+    /**
+     * @brief Ordered iterator over the live keys, as of now.
+     * @throws std::runtime_error if a table cannot be opened.
+     */
+    virtual std::unique_ptr<common::Iterator> NewIterator(const ReadOptions& options = ReadOptions()) = 0;
+
+    /**
+     * @brief Write the memtable out as an SSTable and wait for it.
+     * @return false if the flush failed.
+     */
+    virtual bool Flush() = 0;
+
+    /// Number of table files at `level`.
+    virtual int NumFilesAtLevel(int level) = 0;
+
+    /// Total table bytes at `level`.
+    virtual uint64_t NumBytesAtLevel(int level) = 0;
+
+    /**
+     * @brief Block until no compaction is running or needed.
+     * @return false if background work failed.
+     */
+    virtual bool WaitForCompactions() = 0;
+};
+
+} // namespace VrootKV::db
@@ -0,0 +1,59 @@
+#pragma once
+/**
+ * @file write_batch.h
+ * @author Vrutik Halani
+ * @brief Ordered group of Put/Delete operations applied atomically by `DB::Write()`.
+ *
+ * A batch is logged as one WAL transaction (BEGIN, the operations, COMMIT),
+ * so after a crash either all of its operations are recovered or none.
+ * Operations apply in insertion order: a later operation on the same key
+ * wins.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace VrootKV::db {
+
+class WriteBatch {
+public:
+    enum class OpType : uint8_t { kPut, kDelete };
+
+    struct Op {
+        OpType type;
+        std::string key;
+        std::string value;  ///< Empty for deletions.
+    };
+
+    void Put(std::string_view key, std::string_view value) {
+        bytes_ += key.size() + value.size();
+        ops_.push_back(Op{OpType::kPut, std::string(key), std::string(value)});
+    }
+
+    void Delete(std::string_view key) {
+        bytes_ += key.size();
+        ops_.push_back(Op{OpType::kDelete, std::string(key), std::string()});
+    }
+
+    void Clear() {
+        ops_.clear();
+        bytes_ = 0;
+    }
+
+    /// Number of operations in the batch.
+    std::size_t Count() const { return ops_.size(); }
+
+    /// Sum of key and value bytes.
+    std::size_t ApproximateSize() const { return bytes_; }
+
+    const std::vector<Op>& ops() const { return ops_; }
+
+private:
+    std::vector<Op> ops_;
+    std::size_t bytes_ = 0;
+};
+
+} // namespace VrootKV::db
@@ -0,0 +1,102 @@
+/**
+ * @file async_io.h
+ * @author Vrutik Halani
+ * @brief Asynchronous, batched block reads over `IRandomAccessFile`.
+ *
+ * A synchronous `pread` per block caps the I/O queue depth at the number of
+ * calling threads and costs a context switch per block. `IAsyncIO` lets a
+ * caller hand over many reads at once (e.g. every data block a MultiGet needs,
+ * or a compaction's readahead window) and wait for the whole batch.
+ *
+ * Backends
+ * --------
+ *  - **io_uring** (Linux, when the kernel allows it): the batch is written to
+ *    the submission ring and submitted with one `io_uring_enter`; a reaper
+ *    thread drains completions and runs callbacks.
+ *  - **Thread pool** (everywhere else, or on request): each read is a task
+ *    doing a blocking `IRandomAccessFile::Read` on one of N workers.
+ *
+ * Files that cannot be read by the kernel on our behalf (memory-mapped or
+ * in-memory files, or files without a descriptor) are served inline on the
+ * submitting thread; they never block on the device anyway.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string_view>
+
+#include "VrootKV/io/file_manager.h"
+
+namespace VrootKV::io {
+
+/**
+ * @brief One positional read in an async batch.
+ *
+ * The caller fills the inputs and keeps the request (and `scratch`) alive until
+ * the batch's future is ready; the engine fills the outputs.
+ */
+struct AsyncReadRequest {
+    // Inputs
+    const IRandomAccessFile* file = nullptr;
+    uint64_t offset = 0;
+    size_t n = 0;
+    char* scratch = nullptr;  ///< At least `n` bytes; may be null if `file->ReadsInPlace()`.
+
+    // Outputs
+    std::string_view result;  ///< Bytes read; shorter than `n` only at EOF.
+    bool ok = false;          ///< False on I/O error.
+};
+
+/**
+ * @brief Which engine `NewAsyncIO()` should build.
+ */
+enum class AsyncIOBackend {
+    kAuto,        ///< io_uring if available, otherwise the thread pool.
+    kThreadPool,  ///< Always use the portable thread-pool engine.
+};
+
+struct AsyncIOOptions {
+    AsyncIOBackend backend = AsyncIOBackend::kAuto;
+    /// io_uring submission-queue size (rounded up to a power of two by the kernel).
+    unsigned queue_depth = 64;
+    /// Worker count for the thread-pool engine.
+    size_t pool_threads = 4;
+};
+
+/**
+ * @brief Asynchronous read engine. Thread-safe: any thread may submit.
+ */
+class IAsyncIO {
+public:
+    using Callback = std::function<void(AsyncReadRequest&)>;
+
+    virtual ~IAsyncIO() = default;
+
+    /**
+     * @brief Submit `count` reads as one batch.
+     * @param requests Array of requests; must stay valid until the future is ready.
+     * @param on_complete Optional per-request callback. It runs on an engine
+     *        thread (or inline on the caller for in-place files) and must not
+     *        block; it may submit further batches but not wait for them.
+     * @return Future that becomes ready after every request has completed and
+     *         its callback has returned.
+     */
+    virtual std::future<void> SubmitReads(AsyncReadRequest* requests, size_t count,
+                                          Callback on_complete = nullptr) = 0;
+
+    /// Short engine name ("io_uring" or "thread_pool").
+    virtual const char* Name() const = 0;
+};
+
+/**
+ * @brief Build an async I/O engine. Never returns null: falls back to the
+ * thread pool when io_uring is not compiled in or the kernel refuses it.
+ */
+std::unique_ptr<IAsyncIO> NewAsyncIO(const AsyncIOOptions& options = AsyncIOOptions());
+
+} // namespace VrootKV::io
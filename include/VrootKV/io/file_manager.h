@@ -4,18 +4,102 @@
  * @brief Defines the interfaces for file I/O operations.
  *
  * This file contains the definitions for the interfaces that are used for file
- * I/O operations. This includes interfaces for writable files, readable files,
- * and a file manager that can be used to create, delete, and manipulate files.
+ * I/O operations. This includes interfaces for writable files, sequentially
+ * readable files, random-access (positional) files, and a file manager that can
+ * be used to create, delete, and manipulate files.
  */
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <string_view>
 
+#include "VrootKV/io/rate_limiter.h"
+
 namespace VrootKV::io {
 
+/**
+ * @brief Expected access pattern of a file, passed to the OS as a hint.
+ */
+enum class AccessPattern {
+    kNormal,     ///< No hint; OS default readahead.
+    kRandom,     ///< Point lookups (e.g. SSTables serving Get): disable readahead.
+    kSequential, ///< Front-to-back scans (e.g. compaction inputs): aggressive readahead.
+};
+
+/**
+ * @brief Per-open tuning knobs for files created by an `IFileManager`.
+ *
+ * Implementations may ignore options they do not support; the defaults give
+ * page-cache I/O with a 64 KiB append buffer.
+ */
+struct FileOptions {
+    /**
+     * @brief Serve random-access reads from a read-only memory mapping.
+     *
+     * Reads then return views into the mapping instead of copying into the
+     * caller's scratch buffer. Best for tables that fit in the page cache.
+     * The mapping lives until the file is closed or destroyed.
+     */
+    bool use_mmap_reads = false;
+
+    /// Access-pattern hint (`madvise` for mappings, open flags on Windows).
+    AccessPattern access_pattern = AccessPattern::kNormal;
+
+    /**
+     * @brief User-space append buffer for writable files, in bytes.
+     *
+     * Small appends are coalesced and reach the OS on `Flush()`, `Sync()`,
+     * `Close()` or when the buffer fills. 0 makes every `Write()` a syscall.
+     */
+    size_t write_buffer_size = 64 * 1024;
+
+    /**
+     * @brief Bypass the OS page cache (O_DIRECT) for random-access and writable files.
+     *
+     * Meant for compaction inputs and outputs, so bulk background I/O does not
+     * evict the pages foreground lookups depend on. Alignment is handled
+     * internally. Opening fails on file systems that reject O_DIRECT.
+     * Ignored on Windows and when `use_mmap_reads` is set.
+     */
+    bool use_direct_io = false;
+
+    /**
+     * @brief Start background write-back every this many bytes written (0 = off).
+     *
+     * Keeps dirty pages draining while a large SSTable or WAL file is written,
+     * so its final `Sync()` does not flush hundreds of MB at once and stall
+     * other fsyncs on the device. Uses `sync_file_range` on Linux and
+     * `fdatasync` on other POSIX systems; ignored on Windows and for direct I/O.
+     */
+    uint64_t bytes_per_sync = 0;
+
+    /**
+     * @brief User-space readahead for sequential readable files, in bytes (0 = off).
+     *
+     * Reads smaller than this are served from one larger read, so scanning a
+     * file in small records (WAL recovery) costs few syscalls.
+     */
+    size_t readahead_size = 0;
+
+    /**
+     * @brief Token bucket charged for this file's I/O (not owned; may be null).
+     *
+     * Writes are always charged when set; reads only with `rate_limit_reads`.
+     * Intended for background files (flush and compaction output/input).
+     */
+    RateLimiter* rate_limiter = nullptr;
+
+    /// Priority lane used with `rate_limiter` (flushes should use kHigh).
+    IOPriority io_priority = IOPriority::kLow;
+
+    /// Also charge reads to `rate_limiter` (e.g. compaction inputs).
+    bool rate_limit_reads = false;
+};
+
 /**
  * @brief An interface for a file that can be written to sequentially.
  *
@@ -28,27 +112,32 @@ public:
 
     /**
      * @brief Appends data to the end of the file.
+     *
+     * The data may be held in a user-space buffer until the next Flush(),
+     * Sync() or Close().
      * @param data The data to append.
      * @return True on success, false on failure.
      */
     virtual bool Write(std::string_view data) = 0;
 
     /**
-     * @brief Flushes the file's buffered data to the operating system.
+     * @brief Flushes the file's buffered data to the operating system, making
+     * it visible to other readers of the file.
      * @return True on success, false on failure.
      */
     virtual bool Flush() = 0;
 
     /**
-     * @brief Ensures that all data written to the file is physically persisted
-     * to the storage device. This is a stronger guarantee than Flush().
+     * @brief Flushes, then ensures that all data written to the file is physically
+     * persisted to the storage device. This is a stronger guarantee than Flush().
      * @return True on success, false on failure.
      */
     virtual bool Sync() = 0;
 
     /**
-     * @brief Closes the file, releasing any associated resources.
-     * @return True on success, false on failure.
+     * @brief Flushes buffered data and closes the file, releasing any
+     * associated resources.
+     * @return True on success, false on failure (including a failed flush).
      */
     virtual bool Close() = 0;
 };
@@ -61,12 +150,32 @@ public:
     virtual ~IReadableFile() = default;
 
     /**
-     * @brief Reads up to 'n' bytes from the file.
+     * @brief Reads up to 'n' bytes from the file into caller-owned memory.
+     * @param n The maximum number of bytes to read.
+     * @param scratch Caller-provided buffer of at least 'n' bytes.
+     * @param result On success, set to the bytes read (points into 'scratch').
+     *        It is shorter than 'n' only when the read reaches EOF.
+     * @return True on success (including a short or empty read at EOF), false on error.
+     */
+    virtual bool Read(size_t n, char* scratch, std::string_view* result) = 0;
+
+    /**
+     * @brief Convenience wrapper: reads up to 'n' bytes into '*result'.
      * @param n The maximum number of bytes to read.
      * @param result A pointer to a string where the read data will be stored.
      * @return The number of bytes read. Returns 0 on EOF or error.
      */
-    virtual size_t Read(size_t n, std::string* result) = 0;
+    size_t Read(size_t n, std::string* result) {
+        if (!result) return 0;
+        result->resize(n);
+        std::string_view got;
+        if (!Read(n, result->data(), &got)) {
+            result->clear();
+            return 0;
+        }
+        result->resize(got.size());
+        return got.size();
+    }
 
     /**
      * @brief Closes the file, releasing any associated resources.
@@ -75,6 +184,54 @@ public:
     virtual bool Close() = 0;
 };
 
+/**
+ * @brief An interface for a file that is read at arbitrary offsets.
+ *
+ * Unlike `IReadableFile`, there is no file position: every read names its
+ * offset, so one open file can serve many threads concurrently (e.g. point
+ * lookups into the same SSTable).
+ */
+class IRandomAccessFile {
+public:
+    virtual ~IRandomAccessFile() = default;
+
+    /**
+     * @brief Reads up to 'n' bytes starting at 'offset'. Thread-safe.
+     * @param offset Absolute byte offset in the file.
+     * @param n The maximum number of bytes to read.
+     * @param scratch Caller-provided buffer of at least 'n' bytes. The data is
+     *        read into it unless the implementation can return it in place.
+     * @param result On success, set to the bytes read. It points either into
+     *        'scratch' or, for memory-mapped files, into the mapping (valid
+     *        until Close()). It is shorter than 'n' only when the read reaches EOF.
+     * @return True on success (including short reads at EOF), false on error.
+     */
+    virtual bool Read(uint64_t offset, size_t n, char* scratch, std::string_view* result) const = 0;
+
+    /**
+     * @brief Returns the size of the file in bytes, as of when it was opened.
+     */
+    virtual uint64_t Size() const = 0;
+
+    /**
+     * @brief True if Read() always returns views into the file's own storage
+     * (e.g. a memory mapping), in which case 'scratch' may be null.
+     */
+    virtual bool ReadsInPlace() const { return false; }
+
+    /**
+     * @brief POSIX descriptor for kernel-side async reads (see `IAsyncIO`),
+     * or -1 if the file has none (mapped, in-memory, Windows, closed).
+     */
+    virtual int FileDescriptor() const { return -1; }
+
+    /**
+     * @brief Closes the file. Must not race with in-flight reads.
+     * @return True on success, false on failure.
+     */
+    virtual bool Close() = 0;
+};
+
 /**
  * @brief An interface for managing file system operations.
  *
@@ -90,17 +247,31 @@ public:
      * contents are truncated.
      * @param fname The name of the file to create.
      * @param result A unique_ptr to hold the created writable file object.
+     * @param options Buffering options for this file.
      * @return True on success, false on failure.
      */
-    virtual bool NewWritableFile(const std::string& fname, std::unique_ptr<IWritableFile>& result) = 0;
+    virtual bool NewWritableFile(const std::string& fname, std::unique_ptr<IWritableFile>& result,
+                                 const FileOptions& options = FileOptions()) = 0;
 
     /**
      * @brief Opens an existing file for reading.
      * @param fname The name of the file to open.
      * @param result A unique_ptr to hold the created readable file object.
+     * @param options Readahead options for this file.
      * @return True on success, false on failure.
      */
-    virtual bool NewReadableFile(const std::string& fname, std::unique_ptr<IReadableFile>& result) = 0;
+    virtual bool NewReadableFile(const std::string& fname, std::unique_ptr<IReadableFile>& result,
+                                 const FileOptions& options = FileOptions()) = 0;
+
+    /**
+     * @brief Opens an existing file for positional (random-access) reads.
+     * @param fname The name of the file to open.
+     * @param result A unique_ptr to hold the created random-access file object.
+     * @param options Mapping and access-pattern options for this file.
+     * @return True on success, false on failure.
+     */
+    virtual bool NewRandomAccessFile(const std::string& fname, std::unique_ptr<IRandomAccessFile>& result,
+                                     const FileOptions& options = FileOptions()) = 0;
 
     /**
      * @brief Checks if a file with the given name exists.
@@ -123,6 +294,17 @@ public:
      * @return True on success, false on failure.
      */
     virtual bool RenameFile(const std::string& src, const std::string& target) = 0;
+
+    /**
+     * @brief Creates a directory (and missing parents); succeeds if it already exists.
+     * Managers without directories (e.g. in-memory ones) keep this default no-op.
+     * @param dirname The directory path.
+     * @return True on success, false on failure.
+     */
+    virtual bool CreateDir(const std::string& dirname) {
+        (void)dirname;
+        return true;
+    }
 };
 
 /**
@@ -0,0 +1,142 @@
+/**
+ * @file rate_limiter.h
+ * @author Vrutik Halani
+ * @brief Token-bucket I/O rate limiter with priority lanes and latency-driven auto-tuning.
+ *
+ * Background I/O (flush, compaction) charges its bytes here before reaching
+ * the device, so a long compaction cannot saturate the disk and inflate
+ * foreground read latency.
+ *
+ * Model
+ * -----
+ *  - Every `refill_period_us` the bucket is refilled with
+ *    `bytes_per_sec * refill_period_us / 1e6` tokens (at most one period's
+ *    worth is ever banked, which bounds bursts).
+ *  - `Request(bytes, priority)` takes tokens or blocks. Large requests are
+ *    split into chunks of at most one refill.
+ *  - Waiters queue per priority. On each refill, `kHigh` (flush) is served
+ *    before `kLow` (compaction), except that every `fairness`-th refill
+ *    serves `kLow` first so it cannot starve.
+ *  - One waiter at a time (the "leader") sleeps until the next refill and
+ *    then grants tokens to queued requests in order; others sleep on their
+ *    own condition variable until granted.
+ *
+ * Auto-tuning
+ * -----------
+ * With `foreground_latency_target_us > 0`, callers report foreground
+ * latencies via `RecordForegroundLatency()`. Once per `tune_interval_us`
+ * the p99 of the window is compared with the target: above it, the rate is
+ * cut by 20% (not below `min_bytes_per_sec`); below it, while background
+ * work is actually being throttled, the rate grows by 10% (up to
+ * `max_bytes_per_sec`).
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace VrootKV::io {
+
+/**
+ * @brief Priority lane for rate-limited I/O.
+ */
+enum class IOPriority {
+    kLow = 0,   ///< Compaction and other bulk background work.
+    kHigh = 1,  ///< Flushes: they unblock writers, so they preempt compaction.
+};
+
+struct RateLimiterOptions {
+    /// Initial budget in bytes per second (> 0).
+    int64_t bytes_per_sec = 64ll << 20;
+    /// Token refill interval; also the longest a request can burst.
+    int64_t refill_period_us = 100 * 1000;
+    /// Every `fairness`-th refill serves the low-priority queue first.
+    int32_t fairness = 10;
+
+    // Auto-tuning (disabled while foreground_latency_target_us == 0).
+    int64_t foreground_latency_target_us = 0;
+    int64_t min_bytes_per_sec = 1ll << 20;
+    /// Upper bound for auto-tuning; 0 means the initial `bytes_per_sec`.
+    int64_t max_bytes_per_sec = 0;
+    int64_t tune_interval_us = 1000 * 1000;
+};
+
+/**
+ * @class RateLimiter
+ * @brief Thread-safe token bucket shared by every file that should be throttled.
+ *
+ * The limiter must outlive all files and threads that use it, and no
+ * `Request()` may be in progress when it is destroyed.
+ */
+class RateLimiter {
+public:
+    explicit RateLimiter(const RateLimiterOptions& options = RateLimiterOptions());
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    /**
+     * @brief Block until `bytes` may be transferred at `priority`.
+     */
+    void Request(int64_t bytes, IOPriority priority);
+
+    /**
+     * @brief Change the budget; applies from the next refill.
+     */
+    void SetBytesPerSecond(int64_t bytes_per_sec);
+    int64_t GetBytesPerSecond() const;
+
+    /**
+     * @brief Report one foreground operation latency (drives auto-tuning).
+     */
+    void RecordForegroundLatency(std::chrono::microseconds latency);
+
+    /// Bytes granted at `priority` since construction.
+    int64_t GetTotalBytesThrough(IOPriority priority) const;
+    /// `Request()` calls at `priority` since construction.
+    int64_t GetTotalRequests(IOPriority priority) const;
+    /// Number of refills that had requests waiting on them (the budget was binding).
+    int64_t GetThrottledRefills() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Waiter {
+        explicit Waiter(int64_t b) : remaining(b) {}
+        int64_t remaining;
+        bool granted = false;
+        std::condition_variable cv;
+    };
+
+    void RequestChunk(int64_t bytes, IOPriority priority);
+    void RefillAndGrant(Clock::time_point now);
+    void WakeNextLeader();
+    int64_t RefillBytes() const;   ///< Caller holds mu_.
+    int64_t ChunkLimit() const;    ///< Locks mu_.
+    void MaybeTune(Clock::time_point now);
+
+    const RateLimiterOptions options_;
+
+    mutable std::mutex mu_;
+    int64_t bytes_per_sec_;
+    int64_t available_;
+    Clock::time_point next_refill_;
+    int64_t refill_count_ = 0;
+    int64_t throttled_refills_ = 0;
+    bool leader_active_ = false;
+    std::deque<Waiter*> queues_[2];
+    int64_t total_bytes_[2] = {0, 0};
+    int64_t total_requests_[2] = {0, 0};
+
+    // Auto-tuning window (guarded by mu_).
+    std::vector<int64_t> latency_samples_us_;
+    Clock::time_point next_tune_;
+    int64_t throttled_refills_at_last_tune_ = 0;
+};
+
+} // namespace VrootKV::io
@@ -14,8 +14,8 @@
  *      stored as an absolute file offset and byte size.
  *
  *   2) `SSTableFooter` — a fixed-size structure written at the very end of the
- *      file that stores the `BlockHandle` for the Filter Block and Index Block,
- *      plus a magic number for quick file-type validation.
+ *      file that stores the `BlockHandle` for the Filter Block (or Meta-Index
+ *      Block) and Index Block, plus a magic number for file-type validation.
  *
  * Encoding
  * --------
@@ -36,6 +36,12 @@
  *   introduce explicit byte-order conversion helpers before serialization.
  * - `SSTableFooter` is located by **seeking to the final 40 bytes** of the file.
  *   Reading it allows a single I/O to discover where the Filter and Index reside.
+ * - The magic selects how `filter_handle` is interpreted:
+ *     * `kLegacyMagic`    — it points directly at a serialized Bloom filter.
+ *     * `kMetaIndexMagic` — it points at a **meta-index block** (index-block
+ *       encoding) mapping meta block names (e.g. "filter.bloom",
+ *       "filter.range") to their handles, so optional blocks can be added
+ *       without changing the footer size.
  *
  * Example (writer)
  * ----------------
@@ -148,6 +154,15 @@ struct BlockHandle {
     }
 };
 
+/// Meta-index entry naming the Bloom filter block.
+inline constexpr std::string_view kBloomFilterMetaName = "filter.bloom";
+
+/// Meta-index entry naming the top-level index of a partitioned Bloom filter.
+inline constexpr std::string_view kPartitionedFilterMetaName = "filter.partitioned";
+
+/// Meta-index entry naming the range filter block.
+inline constexpr std::string_view kRangeFilterMetaName = "filter.range";
+
 /**
  * @struct SSTableFooter
  * @brief
@@ -171,18 +186,28 @@ struct BlockHandle {
  * Versioning
  * ----------
  * The `magic` number (`0xF00DBAADF00DBAAD`) is **deliberately distinctive**.
- * If the format evolves, consider changing this field or extending the footer
- * in a backward-compatible way (e.g., larger trailing region with a new magic).
+ * Tables that carry a meta-index use `kMetaIndexMagic` instead; the footer size
+ * is identical, only the meaning of `filter_handle` changes.
  */
 struct SSTableFooter {
-    /// Handle to the optional filter block. May be {0,0} if no filter is present.
+    /// Original layout: `filter_handle` is the Bloom filter block itself.
+    static constexpr uint64_t kLegacyMagic = 0xF00DBAADF00DBAADull;
+
+    /// Meta-index layout: `filter_handle` is the meta-index block.
+    static constexpr uint64_t kMetaIndexMagic = 0xF00DBAADF00D0002ull;
+
+    /// Handle to the optional filter block (legacy magic) or to the meta-index
+    /// block (`kMetaIndexMagic`). May be {0,0} if neither is present.
     BlockHandle filter_handle;
 
     /// Handle to the index block. Must be a valid block.
     BlockHandle index_handle;
 
     /// File-type / version identifier to quickly sanity-check reads.
-    uint64_t magic = 0xF00DBAADF00DBAADull;
+    uint64_t magic = kLegacyMagic;
+
+    /// True if `magic` is one of the recognized values.
+    bool HasValidMagic() const { return magic == kLegacyMagic || magic == kMetaIndexMagic; }
 
     /// Number of bytes in the serialized form of an `SSTableFooter`.
     static constexpr size_t kEncodedLength = 16 + 16 + 8; // 40
@@ -5,7 +5,9 @@
  *
  * Implementation highlights:
  *  - Portable little-endian encoding helpers for header fields.
- *  - Fast 64-bit hashing (SplitMix64-style mixer) used for double hashing.
+ *  - Single-pass 128-bit hashing (multiply-fold mixer) supplies both h1 and h2.
+ *  - Probe positions are reduced with fastrange (multiply-high) instead of `%`.
+ *  - Version 1 filters (two SplitMix64-style passes + modulo) remain readable.
  *  - No external dependencies; suitable for embedding as the SSTable Filter Block
  */
 
@@ -16,6 +18,10 @@
 #include <stdexcept>
 #include <vector>
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
 namespace VrootKV::common {
 
 // ====================== Portable little-endian helpers ======================
@@ -64,7 +70,7 @@ inline std::uint64_t GetU64(const char* p) {
 }
 
 /**
- * @brief Fast 64-bit hash (SplitMix64-style mixing) for arbitrary byte strings.
+ * @brief Fast 64-bit hash (SplitMix64-style mixing) used by version 1 filters.
  * @param s Input bytes
  * @param seed Per-hash seed to decorrelate h1 and h2
  * @return 64-bit hash
@@ -108,6 +114,112 @@ inline std::uint64_t Hash64(std::string_view s, std::uint64_t seed) {
     return x;
 }
 
+// ------------------------- Version 2 hashing -------------------------------
+
+constexpr std::uint64_t kMix0 = 0xA0761D6478BD642Full;
+constexpr std::uint64_t kMix1 = 0xE7037ED1A0B428DBull;
+constexpr std::uint64_t kMix2 = 0x8EBC6AF09C88C6E3ull;
+constexpr std::uint64_t kMix3 = 0x589965CC75374CC3ull;
+
+/**
+ * @brief Full 64x64 -> 128-bit multiply.
+ * @param a,b Operands.
+ * @param lo,hi Receive the low / high 64 bits of the product.
+ */
+inline void Mul128(std::uint64_t a, std::uint64_t b, std::uint64_t* lo, std::uint64_t* hi) {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+    *lo = static_cast<std::uint64_t>(r);
+    *hi = static_cast<std::uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *lo = _umul128(a, b, hi);
+#else
+    // Portable schoolbook multiply on 32-bit halves.
+    const std::uint64_t a_lo = a & 0xFFFFFFFFull, a_hi = a >> 32;
+    const std::uint64_t b_lo = b & 0xFFFFFFFFull, b_hi = b >> 32;
+    const std::uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi;
+    const std::uint64_t hl = a_hi * b_lo, hh = a_hi * b_hi;
+    const std::uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFull) + (hl & 0xFFFFFFFFull);
+    *lo = (mid << 32) | (ll & 0xFFFFFFFFull);
+    *hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+/**
+ * @brief Multiply-fold mixer: xor of the two halves of a 128-bit product.
+ */
+inline std::uint64_t Fold(std::uint64_t a, std::uint64_t b) {
+    std::uint64_t lo, hi;
+    Mul128(a, b, &lo, &hi);
+    return lo ^ hi;
+}
+
+/**
+ * @brief Map a uniformly distributed 64-bit value onto [0, m) without division.
+ *
+ * "fastrange": the high 64 bits of h * m are uniform over [0, m) when h is
+ * uniform over [0, 2^64).
+ */
+inline std::uint64_t FastRange(std::uint64_t h, std::uint64_t m) {
+    std::uint64_t lo, hi;
+    Mul128(h, m, &lo, &hi);
+    return hi;
+}
+
+inline std::uint64_t Load64(const unsigned char* p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, 8);
+    return v;
+}
+
+inline std::uint64_t Load32(const unsigned char* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+/**
+ * @brief Single-pass 128-bit hash of a byte string.
+ * @param s  Input bytes
+ * @param h1 Receives the first 64-bit half (probe base)
+ * @param h2 Receives the second 64-bit half (probe step)
+ *
+ * 16-byte chunks are folded into one accumulator with a single 128-bit multiply
+ * each; the final 1..16 bytes are read with (possibly overlapping) wide loads.
+ * Both halves come from the same pass, so a key is only read once per probe
+ * sequence. Not cryptographic.
+ */
+inline void Hash128(std::string_view s, std::uint64_t* h1, std::uint64_t* h2) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(s.data());
+    std::size_t n = s.size();
+    std::uint64_t a = kMix0 ^ (static_cast<std::uint64_t>(n) * kMix1);
+    std::uint64_t b = kMix2;
+
+    while (n > 16) {
+        a = Fold(Load64(p) ^ kMix1, Load64(p + 8) ^ a);
+        p += 16;
+        n -= 16;
+    }
+
+    // Tail: 0..16 bytes.
+    if (n >= 8) {
+        b ^= Load64(p);
+        a ^= Load64(p + n - 8);
+    } else if (n >= 4) {
+        b ^= Load32(p);
+        a ^= Load32(p + n - 4) << 32;
+    } else if (n > 0) {
+        b ^= (static_cast<std::uint64_t>(p[0]) << 16) |
+             (static_cast<std::uint64_t>(p[n >> 1]) << 8) |
+              static_cast<std::uint64_t>(p[n - 1]);
+    }
+
+    std::uint64_t lo, hi;
+    Mul128(a ^ kMix2, b ^ kMix3, &lo, &hi);
+    *h1 = Fold(lo ^ kMix0, hi ^ kMix1);
+    *h2 = Fold(hi ^ kMix3, lo ^ kMix2);
+}
+
 } // namespace detail
 
 // =============================== Sizing =====================================
@@ -160,8 +272,9 @@ BloomFilter::BloomFilter(std::size_t expected_items, double false_positive_rate)
 /**
  * @brief Internal constructor used by Deserialize().
  */
-BloomFilter::BloomFilter(std::size_t num_bits, std::uint32_t k, std::vector<std::uint8_t>&& bytes)
-    : num_bits_(num_bits), num_hashes_(k), bits_(std::move(bytes)) {}
+BloomFilter::BloomFilter(std::size_t num_bits, std::uint32_t k, std::uint32_t version,
+                         std::vector<std::uint8_t>&& bytes)
+    : num_bits_(num_bits), num_hashes_(k), version_(version), bits_(std::move(bytes)) {}
 
 // ================================ Bit I/O ===================================
 
@@ -186,17 +299,18 @@ bool BloomFilter::get_bit(std::size_t bit_index) const {
 // ============================== Hash positions ==============================
 
 /**
- * @brief Compute k bit positions for key using double hashing.
+ * @brief Compute k bit positions for key using the version 1 scheme.
  * @param key Arbitrary bytes to hash.
  * @param out Caller-provided array of size >= k to receive positions.
  * @param k   Number of positions to generate.
  *
- * We compute two independent 64-bit hashes and produce:
+ * Kept only so filters serialized before version 2 stay queryable. We compute
+ * two independent 64-bit hashes and produce:
  *   pos_i = (h1 + i * step) % m
  * where step is derived from h2 and forced odd to ensure full residue coverage
  * even if h2 has a poor lower bit distribution.
  */
-void BloomFilter::positions(std::string_view key, std::size_t* out, std::uint32_t k) const {
+void BloomFilter::legacy_positions(std::string_view key, std::size_t* out, std::uint32_t k) const {
     const std::uint64_t h1 = detail::Hash64(key, 0x243F6A8885A308D3ull);
     const std::uint64_t h2 = detail::Hash64(key, 0x13198A2E03707344ull);
     const std::uint64_t m  = static_cast<std::uint64_t>(num_bits_);
@@ -218,22 +332,36 @@ void BloomFilter::positions(std::string_view key, std::size_t* out, std::uint32_
 
 /**
  * @brief Insert a key by setting k derived bit positions.
+ *
+ * Version 2 probes: h_i = h1 + i * (h2 | 1) over the full 64-bit ring, each
+ * reduced onto [0, m) with fastrange. No division anywhere on the path.
  */
 void BloomFilter::add(std::string_view key) {
     if (num_bits_ == 0) return;
 
-    // Use stack buffer for typical small k; spill to vector if needed.
-    std::size_t idxs_stack[64];
-    std::size_t* idxs = idxs_stack;
-    std::vector<std::size_t> dyn;
-    if (num_hashes_ > 64) {
-        dyn.resize(num_hashes_);
-        idxs = dyn.data();
+    if (version_ == kLegacyVersion) {
+        // Use stack buffer for typical small k; spill to vector if needed.
+        std::size_t idxs_stack[64];
+        std::size_t* idxs = idxs_stack;
+        std::vector<std::size_t> dyn;
+        if (num_hashes_ > 64) {
+            dyn.resize(num_hashes_);
+            idxs = dyn.data();
+        }
+        legacy_positions(key, idxs, num_hashes_);
+        for (std::uint32_t i = 0; i < num_hashes_; ++i) {
+            set_bit(idxs[i]);
+        }
+        return;
     }
 
-    positions(key, idxs, num_hashes_);
+    std::uint64_t h, step;
+    detail::Hash128(key, &h, &step);
+    step |= 1u;
+    const std::uint64_t m = static_cast<std::uint64_t>(num_bits_);
     for (std::uint32_t i = 0; i < num_hashes_; ++i) {
-        set_bit(idxs[i]);
+        set_bit(static_cast<std::size_t>(detail::FastRange(h, m)));
+        h += step;
     }
 }
 
@@ -244,17 +372,28 @@ void BloomFilter::add(std::string_view key) {
 bool BloomFilter::might_contain(std::string_view key) const {
     if (num_bits_ == 0) return false;
 
-    std::size_t idxs_stack[64];
-    std::size_t* idxs = idxs_stack;
-    std::vector<std::size_t> dyn;
-    if (num_hashes_ > 64) {
-        dyn.resize(num_hashes_);
-        idxs = dyn.data();
+    if (version_ == kLegacyVersion) {
+        std::size_t idxs_stack[64];
+        std::size_t* idxs = idxs_stack;
+        std::vector<std::size_t> dyn;
+        if (num_hashes_ > 64) {
+            dyn.resize(num_hashes_);
+            idxs = dyn.data();
+        }
+        legacy_positions(key, idxs, num_hashes_);
+        for (std::uint32_t i = 0; i < num_hashes_; ++i) {
+            if (!get_bit(idxs[i])) return false;
+        }
+        return true;
     }
 
-    positions(key, idxs, num_hashes_);
+    std::uint64_t h, step;
+    detail::Hash128(key, &h, &step);
+    step |= 1u;
+    const std::uint64_t m = static_cast<std::uint64_t>(num_bits_);
     for (std::uint32_t i = 0; i < num_hashes_; ++i) {
-        if (!get_bit(idxs[i])) return false;
+        if (!get_bit(static_cast<std::size_t>(detail::FastRange(h, m)))) return false;
+        h += step;
     }
     return true;
 }
@@ -264,15 +403,16 @@ bool BloomFilter::might_contain(std::string_view key) const {
  */
 std::string BloomFilter::serialize() const {
     // Format:
-    // [magic: u32 'VKBF'][version: u32=1][num_bits: u64][k: u32][pad: u32=0][bits...]
+    // [magic: u32 'VKBF'][version: u32][num_bits: u64][k: u32][pad: u32=0][bits...]
+    // The version is the probe scheme the bits were built with, so a filter
+    // deserialized from version 1 bytes re-serializes as version 1.
     std::string out;
     out.reserve(24 + bits_.size());
 
     const std::uint32_t kMagic   = 0x46424B56u; // 'V''K''B''F' in little-endian
-    const std::uint32_t kVersion = 1u;
 
     detail::PutU32(out, kMagic);
-    detail::PutU32(out, kVersion);
+    detail::PutU32(out, version_);
     detail::PutU64(out, static_cast<std::uint64_t>(num_bits_));
     detail::PutU32(out, static_cast<std::uint32_t>(num_hashes_));
     detail::PutU32(out, 0u); // pad for future-proofing/alignment
@@ -300,7 +440,7 @@ BloomFilter BloomFilter::Deserialize(std::string_view bytes) {
     // p + 20 is a pad field (ignored)
 
     const std::uint32_t kMagic = 0x46424B56u;
-    if (magic != kMagic || version != 1u) {
+    if (magic != kMagic || (version != kLegacyVersion && version != kCurrentVersion)) {
         throw std::runtime_error("BloomFilter: bad magic or version");
     }
     if (m_bits == 0 || k == 0) {
@@ -315,7 +455,7 @@ BloomFilter BloomFilter::Deserialize(std::string_view bytes) {
     std::vector<std::uint8_t> buf(needed);
     std::memcpy(buf.data(), p + 24, needed);
 
-    return BloomFilter(static_cast<std::size_t>(m_bits), k, std::move(buf));
+    return BloomFilter(static_cast<std::size_t>(m_bits), k, version, std::move(buf));
 }
 
 } // namespace VrootKV::common
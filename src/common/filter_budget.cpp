@@ -0,0 +1,114 @@
+/**
+ * @file filter_budget.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of the Monkey-style per-level filter allocation.
+ *
+ * With c = ln(2)^2 and p_i = K * n_i, the budget constraint
+ *     sum_i n_i * (-ln(K * n_i) / c) = M
+ * solves in closed form for the active set of levels:
+ *     ln K = -(c * M + sum_i n_i ln n_i) / sum_i n_i
+ * Levels whose p_i comes out >= 1 are dropped from the active set (no filter)
+ * and the solve is repeated until every active level has p_i < 1.
+ */
+
+#include "VrootKV/common/filter_budget.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace VrootKV::common {
+
+namespace {
+const double kLn2Squared = std::log(2.0) * std::log(2.0);
+} // namespace
+
+FilterBudget::FilterBudget(double bits_per_key)
+    : bits_per_key_(std::max(0.0, bits_per_key)) {}
+
+void FilterBudget::SetBitsPerKey(double bits_per_key) {
+    std::lock_guard<std::mutex> lock(mu_);
+    bits_per_key_ = std::max(0.0, bits_per_key);
+    Recompute();
+}
+
+double FilterBudget::bits_per_key() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return bits_per_key_;
+}
+
+void FilterBudget::SetLevelEntries(std::vector<std::uint64_t> entries_per_level) {
+    std::lock_guard<std::mutex> lock(mu_);
+    entries_ = std::move(entries_per_level);
+    Recompute();
+}
+
+double FilterBudget::BitsPerKeyForLevel(int level) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (level < 0 || static_cast<std::size_t>(level) >= allocation_.size() ||
+        entries_[static_cast<std::size_t>(level)] == 0) {
+        return std::min(bits_per_key_, kMaxBitsPerKey);
+    }
+    return allocation_[static_cast<std::size_t>(level)];
+}
+
+void FilterBudget::Recompute() {
+    double total_keys = 0;
+    for (std::uint64_t n : entries_) total_keys += static_cast<double>(n);
+    allocation_ = Allocate(entries_, bits_per_key_ * total_keys);
+}
+
+std::vector<double> FilterBudget::Allocate(const std::vector<std::uint64_t>& entries_per_level,
+                                           double total_bits) {
+    std::vector<double> bits(entries_per_level.size(), 0.0);
+    std::vector<bool> active(entries_per_level.size(), false);
+    for (std::size_t i = 0; i < entries_per_level.size(); ++i) {
+        active[i] = entries_per_level[i] > 0;
+    }
+    if (total_bits <= 0) return bits;
+
+    for (;;) {
+        double n_sum = 0, n_ln_n = 0;
+        for (std::size_t i = 0; i < entries_per_level.size(); ++i) {
+            if (!active[i]) continue;
+            const double n = static_cast<double>(entries_per_level[i]);
+            n_sum += n;
+            n_ln_n += n * std::log(n);
+        }
+        if (n_sum == 0) return bits;
+
+        const double ln_k = -(kLn2Squared * total_bits + n_ln_n) / n_sum;
+
+        // Drop levels whose optimal FPR is >= 1 and re-solve without them.
+        bool dropped = false;
+        for (std::size_t i = 0; i < entries_per_level.size(); ++i) {
+            if (!active[i]) continue;
+            const double ln_p = ln_k + std::log(static_cast<double>(entries_per_level[i]));
+            if (ln_p >= 0) {
+                active[i] = false;
+                bits[i] = 0;
+                dropped = true;
+            } else {
+                bits[i] = std::min(-ln_p / kLn2Squared, kMaxBitsPerKey);
+            }
+        }
+        if (!dropped) return bits;
+    }
+}
+
+double FilterBudget::ExpectedFalsePositives(const std::vector<std::uint64_t>& entries_per_level,
+                                            const std::vector<double>& bits_per_key) {
+    double total = 0;
+    for (std::size_t i = 0; i < entries_per_level.size(); ++i) {
+        if (entries_per_level[i] == 0) continue;
+        const double b = i < bits_per_key.size() ? bits_per_key[i] : 0.0;
+        total += FalsePositiveRate(b);
+    }
+    return total;
+}
+
+double FilterBudget::FalsePositiveRate(double bits_per_key) {
+    if (bits_per_key <= 0) return 1.0;
+    return std::exp(-bits_per_key * kLn2Squared);
+}
+
+} // namespace VrootKV::common
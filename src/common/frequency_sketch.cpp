@@ -0,0 +1,77 @@
+/**
+ * @file frequency_sketch.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of the 4-bit count-min `FrequencySketch`.
+ */
+
+#include "frequency_sketch.h"
+
+#include <algorithm>
+
+namespace VrootKV::common {
+
+namespace {
+
+constexpr uint64_t kRowSeeds[4] = {
+    0x9E3779B97F4A7C15ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull, 0xD6E8FEB86659FD93ull,
+};
+
+/// Halve all sixteen 4-bit counters of a word at once.
+constexpr uint64_t kHalveMask = 0x7777777777777777ull;
+
+} // namespace
+
+FrequencySketch::FrequencySketch(std::size_t expected_entries)
+    : num_counters_(64),
+      sample_size_(10 * std::max<uint64_t>(expected_entries, 1)) {
+    // About 16 counters (8 bytes) per expected entry, spread over four rows.
+    while (num_counters_ < 16 * expected_entries) num_counters_ <<= 1;
+    table_.reset(new std::atomic<uint64_t>[num_counters_ / 16]);
+    for (std::size_t i = 0; i < num_counters_ / 16; ++i) table_[i].store(0, std::memory_order_relaxed);
+}
+
+std::size_t FrequencySketch::CounterIndex(uint64_t hash, int row) const {
+    uint64_t h = (hash + kRowSeeds[row]) * kRowSeeds[(row + 1) % kRows];
+    h ^= h >> 31;
+    return static_cast<std::size_t>(h & (num_counters_ - 1));
+}
+
+void FrequencySketch::Increment(uint64_t hash) {
+    bool added = false;
+    for (int row = 0; row < kRows; ++row) {
+        const std::size_t idx = CounterIndex(hash, row);
+        std::atomic<uint64_t>& word = table_[idx / 16];
+        const int shift = static_cast<int>(idx % 16) * 4;
+        uint64_t old = word.load(std::memory_order_relaxed);
+        while (((old >> shift) & 0xf) < kMaxCount) {
+            if (word.compare_exchange_weak(old, old + (uint64_t{1} << shift), std::memory_order_relaxed)) {
+                added = true;
+                break;
+            }
+        }
+    }
+    // Saturated keys do not advance the aging clock (as in TinyLFU).
+    if (added && additions_.fetch_add(1, std::memory_order_relaxed) + 1 == sample_size_) Halve();
+}
+
+uint32_t FrequencySketch::Estimate(uint64_t hash) const {
+    uint32_t estimate = kMaxCount;
+    for (int row = 0; row < kRows; ++row) {
+        const std::size_t idx = CounterIndex(hash, row);
+        const uint64_t word = table_[idx / 16].load(std::memory_order_relaxed);
+        estimate = std::min(estimate, static_cast<uint32_t>((word >> ((idx % 16) * 4)) & 0xf));
+    }
+    return estimate;
+}
+
+void FrequencySketch::Halve() {
+    for (std::size_t i = 0; i < num_counters_ / 16; ++i) {
+        uint64_t old = table_[i].load(std::memory_order_relaxed);
+        while (!table_[i].compare_exchange_weak(old, (old >> 1) & kHalveMask, std::memory_order_relaxed)) {
+        }
+    }
+    additions_.fetch_sub(sample_size_ / 2, std::memory_order_relaxed);
+    resets_.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace VrootKV::common
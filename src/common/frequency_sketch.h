@@ -0,0 +1,69 @@
+#pragma once
+/**
+ * @file frequency_sketch.h
+ * @author Vrutik Halani
+ * @brief Approximate, aging access-frequency counter (TinyLFU sketch).
+ *
+ * A count-min sketch of 4-bit saturating counters: each key hash selects one
+ * counter in each of four rows and its estimate is the minimum of the four.
+ * After `10 * expected_entries` increments every counter is halved, so the
+ * sketch tracks recent popularity rather than all-time totals.
+ *
+ * Caches use it for admission: when an insert would evict a victim, the new
+ * entry is admitted only if its estimated frequency beats the victim's. A
+ * one-pass scan touches each block once, so its blocks never displace
+ * entries that are read repeatedly.
+ *
+ * All operations are lock-free. Concurrent increments may occasionally be
+ * lost (and racing with a halving may skip one), which only blurs an
+ * estimate that is approximate anyway.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace VrootKV::common {
+
+/**
+ * @class FrequencySketch
+ * @brief Thread-safe popularity estimate for 64-bit key hashes.
+ */
+class FrequencySketch {
+public:
+    /// Largest value a counter (and so an estimate) can reach.
+    static constexpr uint32_t kMaxCount = 15;
+
+    /**
+     * @param expected_entries Roughly how many entries the owning cache holds;
+     *        sizes the table (~8 bytes per entry) and the aging period.
+     */
+    explicit FrequencySketch(std::size_t expected_entries);
+
+    FrequencySketch(const FrequencySketch&) = delete;
+    FrequencySketch& operator=(const FrequencySketch&) = delete;
+
+    /// Record one access to `hash`.
+    void Increment(uint64_t hash);
+
+    /// Estimated recent accesses to `hash`, in [0, kMaxCount].
+    uint32_t Estimate(uint64_t hash) const;
+
+    /// Number of halvings so far.
+    uint64_t resets() const { return resets_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int kRows = 4;
+
+    std::size_t CounterIndex(uint64_t hash, int row) const;
+    void Halve();
+
+    std::size_t num_counters_;  ///< Power of two; 16 counters per word.
+    std::unique_ptr<std::atomic<uint64_t>[]> table_;
+    const uint64_t sample_size_;
+    std::atomic<uint64_t> additions_{0};
+    std::atomic<uint64_t> resets_{0};
+};
+
+} // namespace VrootKV::common
@@ -0,0 +1,124 @@
+/**
+ * @file histogram.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of the log-linear `Histogram`.
+ *
+ * Bucket layout: values 0..15 get one bucket each. A larger value with its
+ * highest set bit at position e (4 <= e <= 63) goes to
+ *     16 + (e - 4) * 8 + (the 3 bits below the leading one),
+ * i.e. 8 equal-width buckets per power of two.
+ */
+
+#include "VrootKV/common/histogram.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+namespace VrootKV::common {
+
+namespace {
+
+int HighestBit(uint64_t v) {
+    int e = 0;
+    while (v >>= 1) ++e;
+    return e;
+}
+
+} // namespace
+
+size_t Histogram::BucketFor(uint64_t value) {
+    if (value < 16) return static_cast<size_t>(value);
+    const int e = HighestBit(value);
+    const uint64_t sub = (value >> (e - 3)) & 7;
+    return 16 + static_cast<size_t>(e - 4) * 8 + static_cast<size_t>(sub);
+}
+
+uint64_t Histogram::BucketLowerBound(size_t bucket) {
+    if (bucket < 16) return bucket;
+    const int e = static_cast<int>((bucket - 16) / 8) + 4;
+    const uint64_t sub = (bucket - 16) % 8;
+    return (uint64_t{1} << e) | (sub << (e - 3));
+}
+
+void Histogram::Add(uint64_t value) {
+    buckets_[BucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t cur = min_.load(std::memory_order_relaxed);
+    while (value < cur && !min_.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+    cur = max_.load(std::memory_order_relaxed);
+    while (value > cur && !max_.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+}
+
+void Histogram::Merge(const Histogram& other) {
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+        const uint64_t n = other.buckets_[i].load(std::memory_order_relaxed);
+        if (n != 0) buckets_[i].fetch_add(n, std::memory_order_relaxed);
+    }
+    count_.fetch_add(other.Count(), std::memory_order_relaxed);
+    sum_.fetch_add(other.Sum(), std::memory_order_relaxed);
+
+    const uint64_t omin = other.min_.load(std::memory_order_relaxed);
+    uint64_t cur = min_.load(std::memory_order_relaxed);
+    while (omin < cur && !min_.compare_exchange_weak(cur, omin, std::memory_order_relaxed)) {}
+    const uint64_t omax = other.Max();
+    cur = max_.load(std::memory_order_relaxed);
+    while (omax > cur && !max_.compare_exchange_weak(cur, omax, std::memory_order_relaxed)) {}
+}
+
+void Histogram::Clear() {
+    for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t Histogram::Min() const {
+    return Count() == 0 ? 0 : min_.load(std::memory_order_relaxed);
+}
+
+double Histogram::Mean() const {
+    const uint64_t n = Count();
+    return n == 0 ? 0.0 : static_cast<double>(Sum()) / static_cast<double>(n);
+}
+
+uint64_t Histogram::Percentile(double p) const {
+    uint64_t total = 0;
+    for (const auto& b : buckets_) total += b.load(std::memory_order_relaxed);
+    if (total == 0) return 0;
+
+    const double target = std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(total);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+        const uint64_t n = buckets_[i].load(std::memory_order_relaxed);
+        if (n == 0) continue;
+        if (static_cast<double>(seen + n) >= target) {
+            // Interpolate linearly inside the bucket, then clamp to observed range.
+            const double lo = static_cast<double>(BucketLowerBound(i));
+            const double hi = i + 1 < kNumBuckets ? static_cast<double>(BucketLowerBound(i + 1))
+                                                  : static_cast<double>(Max());
+            const double frac = (target - static_cast<double>(seen)) / static_cast<double>(n);
+            const auto v = static_cast<uint64_t>(lo + (hi - lo) * frac);
+            return std::clamp(v, Min(), Max());
+        }
+        seen += n;
+    }
+    return Max();
+}
+
+std::string Histogram::ToString() const {
+    char buf[192];
+    std::snprintf(buf, sizeof(buf),
+                  "count=%llu mean=%.1f p50=%llu p99=%llu p99.9=%llu max=%llu",
+                  static_cast<unsigned long long>(Count()), Mean(),
+                  static_cast<unsigned long long>(Percentile(50.0)),
+                  static_cast<unsigned long long>(Percentile(99.0)),
+                  static_cast<unsigned long long>(Percentile(99.9)),
+                  static_cast<unsigned long long>(Max()));
+    return buf;
+}
+
+} // namespace VrootKV::common
@@ -0,0 +1,164 @@
+/**
+ * @file lz_codec.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of the LZ77 block codec.
+ */
+
+#include "lz_codec.h"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace VrootKV::common {
+
+namespace {
+
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashBits = 12;
+
+uint32_t Load32(const char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint32_t HashOf(uint32_t v) {
+    return (v * 2654435761u) >> (32 - kHashBits);
+}
+
+/// Length of the common prefix of `a` and `b`, with `b` bounded by `b_end`.
+size_t MatchLength(const char* a, const char* b, const char* b_end) {
+    const char* start = b;
+    while (b_end - b >= 8) {
+        uint64_t x, y;
+        std::memcpy(&x, a, 8);
+        std::memcpy(&y, b, 8);
+        if (x != y) break;  // the byte loop below finds the mismatch
+        a += 8;
+        b += 8;
+    }
+    while (b < b_end && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return static_cast<size_t>(b - start);
+}
+
+void PutLength(std::string* out, size_t extra) {
+    while (extra >= 255) {
+        out->push_back(static_cast<char>(255));
+        extra -= 255;
+    }
+    out->push_back(static_cast<char>(extra));
+}
+
+void EmitSequence(std::string* out, const char* literals, size_t lit_len, size_t offset, size_t match_len) {
+    const size_t lit_nib = lit_len < 15 ? lit_len : 15;
+    const size_t match_extra = match_len >= kMinMatch ? match_len - kMinMatch : 0;
+    const size_t match_nib = match_extra < 15 ? match_extra : 15;
+    out->push_back(static_cast<char>((lit_nib << 4) | match_nib));
+    if (lit_nib == 15) PutLength(out, lit_len - 15);
+    out->append(literals, lit_len);
+    if (match_len == 0) return;  // final, literal-only sequence
+    out->push_back(static_cast<char>(offset & 0xff));
+    out->push_back(static_cast<char>(offset >> 8));
+    if (match_nib == 15) PutLength(out, match_extra - 15);
+}
+
+size_t GetLength(const unsigned char*& p, const unsigned char* end) {
+    size_t n = 0;
+    for (;;) {
+        if (p >= end) throw std::runtime_error("LZDecompress: truncated length");
+        const unsigned char b = *p++;
+        n += b;
+        if (b != 255) return n;
+    }
+}
+
+} // namespace
+
+void LZCompress(std::string_view input, std::string* output) {
+    // Header: varint32 size.
+    uint32_t size = static_cast<uint32_t>(input.size());
+    while (size >= 0x80) {
+        output->push_back(static_cast<char>(size | 0x80));
+        size >>= 7;
+    }
+    output->push_back(static_cast<char>(size));
+
+    const char* base = input.data();
+    const size_t n = input.size();
+    uint32_t table[1u << kHashBits];
+    std::memset(table, 0xff, sizeof(table));  // 0xffffffff = empty
+
+    size_t anchor = 0;  // start of pending literals
+    size_t i = 0;
+    while (n >= kMinMatch && i + kMinMatch <= n) {
+        const uint32_t seq = Load32(base + i);
+        const uint32_t h = HashOf(seq);
+        const uint32_t cand = table[h];
+        table[h] = static_cast<uint32_t>(i);
+        if (cand != 0xffffffffu && i - cand <= kMaxOffset && Load32(base + cand) == seq) {
+            const size_t len = kMinMatch + MatchLength(base + cand + kMinMatch, base + i + kMinMatch,
+                                                       base + n);
+            EmitSequence(output, base + anchor, i - anchor, i - cand, len);
+            i += len;
+            anchor = i;
+        } else {
+            ++i;
+        }
+    }
+    EmitSequence(output, base + anchor, n - anchor, 0, 0);
+}
+
+void LZDecompress(std::string_view input, std::string* output) {
+    const auto* p = reinterpret_cast<const unsigned char*>(input.data());
+    const auto* end = p + input.size();
+
+    uint32_t size = 0;
+    for (int shift = 0;; shift += 7) {
+        if (p >= end || shift > 28) throw std::runtime_error("LZDecompress: bad header");
+        const unsigned char b = *p++;
+        size |= static_cast<uint32_t>(b & 0x7f) << shift;
+        if ((b & 0x80) == 0) break;
+    }
+
+    output->resize(size);
+    char* out = output->data();
+    size_t pos = 0;
+    while (p < end) {
+        const unsigned char token = *p++;
+        size_t lit_len = token >> 4;
+        if (lit_len == 15) lit_len += GetLength(p, end);
+        if (lit_len > static_cast<size_t>(end - p) || lit_len > size - pos) {
+            throw std::runtime_error("LZDecompress: literal overrun");
+        }
+        std::memcpy(out + pos, p, lit_len);
+        p += lit_len;
+        pos += lit_len;
+        if (p == end) break;  // final sequence has no match
+
+        if (end - p < 2) throw std::runtime_error("LZDecompress: truncated offset");
+        const size_t offset = static_cast<size_t>(p[0]) | (static_cast<size_t>(p[1]) << 8);
+        p += 2;
+        size_t match_len = (token & 0x0f);
+        if (match_len == 15) match_len += GetLength(p, end);
+        match_len += kMinMatch;
+        if (offset == 0 || offset > pos || match_len > size - pos) {
+            throw std::runtime_error("LZDecompress: bad match");
+        }
+        const char* src = out + pos - offset;
+        if (offset >= match_len) {
+            std::memcpy(out + pos, src, match_len);
+        } else {
+            // Overlapping match (offset < length) repeats the last `offset` bytes.
+            for (size_t k = 0; k < match_len; ++k) out[pos + k] = src[k];
+        }
+        pos += match_len;
+    }
+    if (pos != size) throw std::runtime_error("LZDecompress: size mismatch");
+}
+
+} // namespace VrootKV::common
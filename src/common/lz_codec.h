@@ -0,0 +1,40 @@
+#pragma once
+/**
+ * @file lz_codec.h
+ * @author Vrutik Halani
+ * @brief Small, dependency-free LZ77 block codec (LZ4-style format).
+ *
+ * Built for speed over ratio: greedy matching through a 4096-entry hash of
+ * 4-byte sequences, 64 KiB window. Used where a decompression is much cheaper
+ * than the alternative (e.g. the compressed secondary block cache, where a
+ * hit saves a device read).
+ *
+ * Format
+ * ------
+ *   varint32 uncompressed_size
+ *   sequence*:
+ *     token: u8   (literal_len:4 high bits | (match_len - 4):4 low bits)
+ *     [255-continued extra literal length]
+ *     literal bytes
+ *     -- the last sequence stops here (no match) --
+ *     offset: u16 little-endian (1..65535, distance back from the output end)
+ *     [255-continued extra match length]
+ */
+
+#include <string>
+#include <string_view>
+
+namespace VrootKV::common {
+
+/**
+ * @brief Compress `input` and append the encoding to `*output`.
+ */
+void LZCompress(std::string_view input, std::string* output);
+
+/**
+ * @brief Decode a buffer produced by `LZCompress()` into `*output` (replaced).
+ * @throws std::runtime_error if the encoding is malformed or truncated.
+ */
+void LZDecompress(std::string_view input, std::string* output);
+
+} // namespace VrootKV::common
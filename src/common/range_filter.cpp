@@ -0,0 +1,120 @@
+/**
+ * @file range_filter.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of the prefix-truncation range filter.
+ */
+
+#include "VrootKV/common/range_filter.h"
+
+#include <stdexcept>
+
+namespace VrootKV::common {
+
+namespace {
+
+constexpr std::uint32_t kMagic   = 0x46524B56u; // 'V''K''R''F' in little-endian
+constexpr std::uint32_t kVersion = 1u;
+
+void PutU32(std::string& dst, std::uint32_t v) {
+    char b[4];
+    for (int i = 0; i < 4; ++i) b[i] = static_cast<char>((v >> (8 * i)) & 0xFFu);
+    dst.append(b, 4);
+}
+
+std::uint32_t GetU32(const char* p) {
+    return  (static_cast<std::uint32_t>(static_cast<unsigned char>(p[0]))       ) |
+            (static_cast<std::uint32_t>(static_cast<unsigned char>(p[1])) <<  8) |
+            (static_cast<std::uint32_t>(static_cast<unsigned char>(p[2])) << 16) |
+            (static_cast<std::uint32_t>(static_cast<unsigned char>(p[3])) << 24);
+}
+
+} // namespace
+
+RangeFilter::RangeFilter(std::size_t prefix_len)
+    : prefix_len_(prefix_len == 0 ? 1 : prefix_len), offsets_{0} {}
+
+std::string_view RangeFilter::prefix_at(std::size_t i) const {
+    return std::string_view(data_).substr(offsets_[i], offsets_[i + 1] - offsets_[i]);
+}
+
+/**
+ * @brief Append the truncated key unless it repeats the last stored prefix.
+ */
+void RangeFilter::add(std::string_view key) {
+    const std::string_view p = key.substr(0, prefix_len_);
+    const std::size_t n = num_prefixes();
+    if (n > 0) {
+        const std::string_view last = prefix_at(n - 1);
+        if (p == last) return;
+        if (p < last) {
+            throw std::runtime_error("RangeFilter: keys must be added in sorted order");
+        }
+    }
+    data_.append(p.data(), p.size());
+    offsets_.push_back(static_cast<std::uint32_t>(data_.size()));
+}
+
+bool RangeFilter::may_contain_range(std::string_view lo, std::string_view hi) const {
+    if (hi < lo) return false;
+    const std::string_view lo_p = lo.substr(0, prefix_len_);
+    const std::string_view hi_p = hi.substr(0, prefix_len_);
+
+    // First stored prefix >= trunc(lo).
+    std::size_t left = 0, right = num_prefixes();
+    while (left < right) {
+        const std::size_t mid = left + (right - left) / 2;
+        if (prefix_at(mid) < lo_p) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left < num_prefixes() && prefix_at(left) <= hi_p;
+}
+
+std::string RangeFilter::serialize() const {
+    std::string out;
+    out.reserve(16 + offsets_.size() * 4 + data_.size());
+    PutU32(out, kMagic);
+    PutU32(out, kVersion);
+    PutU32(out, static_cast<std::uint32_t>(prefix_len_));
+    PutU32(out, static_cast<std::uint32_t>(num_prefixes()));
+    for (std::uint32_t off : offsets_) PutU32(out, off);
+    out.append(data_);
+    return out;
+}
+
+RangeFilter RangeFilter::Deserialize(std::string_view bytes) {
+    if (bytes.size() < 16) {
+        throw std::runtime_error("RangeFilter: truncated header");
+    }
+    const char* p = bytes.data();
+    if (GetU32(p) != kMagic || GetU32(p + 4) != kVersion) {
+        throw std::runtime_error("RangeFilter: bad magic or version");
+    }
+    const std::uint32_t prefix_len = GetU32(p + 8);
+    const std::uint32_t count      = GetU32(p + 12);
+    if (prefix_len == 0 || count > (bytes.size() - 16) / 4) {
+        throw std::runtime_error("RangeFilter: invalid parameters");
+    }
+
+    const std::size_t table_bytes = (static_cast<std::size_t>(count) + 1) * 4;
+    if (bytes.size() < 16 + table_bytes) {
+        throw std::runtime_error("RangeFilter: truncated offsets");
+    }
+    RangeFilter rf(prefix_len);
+    rf.offsets_.resize(count + 1);
+    for (std::uint32_t i = 0; i <= count; ++i) {
+        rf.offsets_[i] = GetU32(p + 16 + i * 4);
+        if (i > 0 && rf.offsets_[i] < rf.offsets_[i - 1]) {
+            throw std::runtime_error("RangeFilter: corrupt offsets");
+        }
+    }
+    rf.data_.assign(bytes.substr(16 + table_bytes));
+    if (rf.offsets_[0] != 0 || rf.offsets_[count] != rf.data_.size()) {
+        throw std::runtime_error("RangeFilter: size mismatch");
+    }
+    return rf;
+}
+
+} // namespace VrootKV::common
@@ -0,0 +1,495 @@
+#pragma once
+/**
+ * @file sharded_cache.h
+ * @author Vrutik Halani
+ * @brief Sharded, capacity-bounded maps from keys to shared (pinned) values.
+ *
+ * Entries are spread over 2^num_shard_bits shards by key hash; each shard has
+ * its own lock and index, so lookups for different keys rarely contend.
+ * Capacity is measured in caller-supplied "charge" units (1 per entry for an
+ * object count, the byte size for a byte budget) and split evenly across
+ * shards.
+ *
+ * Values are handed out as `std::shared_ptr`: holding one pins the value, so
+ * eviction only drops the cache's reference and a reader still using an
+ * evicted value is never invalidated.
+ *
+ * Two eviction policies share that interface:
+ *  - `ShardedLRUCache`: exact LRU. Every hit moves the entry to the list
+ *    head, so even lookups take the shard mutex exclusively.
+ *  - `ShardedClockCache`: CLOCK (second chance). A hit only sets the entry's
+ *    reference bit, so lookups take the shard lock shared and many threads
+ *    can hit the same hot entry in parallel; inserts sweep a clock hand over
+ *    the slots, evicting the first entry not referenced since the last pass.
+ *
+ * Both also support
+ *  - Low-priority accesses (`CachePriority::kLow`, e.g. for scans): a
+ *    low-priority lookup does not refresh the entry's recency, and a
+ *    low-priority insert lands where the next eviction will take it, so a
+ *    scan can reuse its blocks without displacing the hot set.
+ *  - An admission policy: when an insert would have to evict, the policy
+ *    sees the candidate and the would-be victim and may reject the candidate
+ *    (TinyLFU-style admission, see frequency_sketch.h).
+ *  - An eviction callback (e.g. demotion to a secondary cache).
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace VrootKV::common {
+
+/**
+ * @brief Counters reported by the sharded caches (summed over shards).
+ */
+struct CacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t inserts = 0;
+    std::uint64_t evictions = 0;
+    std::uint64_t admission_rejects = 0;  ///< Inserts refused by the admission policy.
+};
+
+/**
+ * @brief How an access should affect the eviction order.
+ */
+enum class CachePriority {
+    kHigh,  ///< Normal access: refreshes recency; inserts as most recently used.
+    kLow,   ///< Scan-style access: no refresh; inserts as the next eviction victim.
+};
+
+namespace detail {
+
+/// Shard index for a key hash (std::hash is the identity for integers, so mix first).
+inline std::size_t ShardIndex(std::size_t hash, std::size_t num_shards) {
+    const std::uint64_t h = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull;
+    return static_cast<std::size_t>(h >> 32) & (num_shards - 1);
+}
+
+} // namespace detail
+
+/**
+ * @class ShardedLRUCache
+ * @brief Thread-safe LRU cache of `std::shared_ptr<Value>` keyed by `Key`.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ShardedLRUCache {
+public:
+    /**
+     * @param capacity Total charge the cache may hold (split across shards).
+     * @param num_shard_bits log2 of the shard count.
+     */
+    explicit ShardedLRUCache(std::size_t capacity, int num_shard_bits = 4)
+        : num_shards_(std::size_t{1} << num_shard_bits),
+          shards_(new Shard[num_shards_]),
+          capacity_(capacity) {
+        const std::size_t per_shard = (capacity + num_shards_ - 1) / num_shards_;
+        for (std::size_t i = 0; i < num_shards_; ++i) shards_[i].capacity = per_shard;
+    }
+
+    ShardedLRUCache(const ShardedLRUCache&) = delete;
+    ShardedLRUCache& operator=(const ShardedLRUCache&) = delete;
+
+    /// Receives each entry evicted for capacity (not `Erase()`d ones).
+    using EvictionCallback = std::function<void(const Key&, std::shared_ptr<Value>)>;
+
+    /**
+     * @brief Install `callback`; it runs on the inserting thread after the
+     * shard lock is released. Set before the cache is shared between threads.
+     */
+    void SetEvictionCallback(EvictionCallback callback) { on_evict_ = std::move(callback); }
+
+    /// Returns whether `candidate` may displace `victim`; runs under the shard lock.
+    using AdmissionPolicy = std::function<bool(const Key& candidate, const Key& victim)>;
+
+    /// Install `policy` (null admits everything). Set before concurrent use.
+    void SetAdmissionPolicy(AdmissionPolicy policy) { admit_ = std::move(policy); }
+
+    /**
+     * @brief Return the cached value for `key`, or null.
+     *
+     * A `kHigh` hit marks the entry most recently used; a `kLow` hit leaves
+     * its position alone.
+     */
+    std::shared_ptr<Value> Lookup(const Key& key, CachePriority priority = CachePriority::kHigh) {
+        Shard& shard = ShardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mu);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            ++shard.stats.misses;
+            return nullptr;
+        }
+        ++shard.stats.hits;
+        if (priority == CachePriority::kHigh) shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return it->second->value;
+    }
+
+    /**
+     * @brief Insert `value` under `key` unless the key is already cached.
+     *
+     * Least recently used entries are evicted until the shard fits its
+     * capacity again (the new entry itself is always kept). A `kHigh` entry
+     * goes in as most recently used, a `kLow` one as least recently used.
+     * @return The value now cached for `key`: `value`, or the entry another
+     *         thread inserted first. If the admission policy rejects the
+     *         entry, `value` is returned but not cached.
+     * @param admitted If non-null, set to false when the admission policy
+     *        rejected the entry and to true otherwise.
+     */
+    std::shared_ptr<Value> Insert(const Key& key, std::shared_ptr<Value> value, std::size_t charge = 1,
+                                  CachePriority priority = CachePriority::kHigh, bool* admitted = nullptr) {
+        if (admitted != nullptr) *admitted = true;
+        Shard& shard = ShardFor(key);
+        std::vector<std::pair<Key, std::shared_ptr<Value>>> evicted;
+        std::shared_ptr<Value> result;
+        {
+            std::lock_guard<std::mutex> lock(shard.mu);
+            auto it = shard.index.find(key);
+            if (it != shard.index.end()) {
+                if (priority == CachePriority::kHigh) shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+                return it->second->value;
+            }
+            if (admit_ && shard.usage + charge > shard.capacity && !shard.lru.empty() &&
+                !admit_(key, shard.lru.back().key)) {
+                ++shard.stats.admission_rejects;
+                if (admitted != nullptr) *admitted = false;
+                return value;
+            }
+            const auto pos = priority == CachePriority::kHigh ? shard.lru.begin() : shard.lru.end();
+            const auto entry = shard.lru.insert(pos, Entry{key, std::move(value), charge});
+            shard.index.emplace(key, entry);
+            shard.usage += charge;
+            ++shard.stats.inserts;
+            result = entry->value;
+            while (shard.usage > shard.capacity && shard.lru.size() > 1) {
+                auto victim = std::prev(shard.lru.end());
+                if (victim == entry) --victim;
+                shard.usage -= victim->charge;
+                shard.index.erase(victim->key);
+                if (on_evict_) evicted.emplace_back(std::move(victim->key), std::move(victim->value));
+                shard.lru.erase(victim);
+                ++shard.stats.evictions;
+            }
+        }
+        for (auto& victim : evicted) on_evict_(victim.first, std::move(victim.second));
+        return result;
+    }
+
+    /**
+     * @brief Drop `key` from the cache (pinned holders keep their value).
+     */
+    void Erase(const Key& key) {
+        Shard& shard = ShardFor(key);
+        std::lock_guard<std::mutex> lock(shard.mu);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) return;
+        shard.usage -= it->second->charge;
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+    }
+
+    /// Number of cached entries.
+    std::size_t Size() const {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < num_shards_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mu);
+            n += shards_[i].lru.size();
+        }
+        return n;
+    }
+
+    /// Sum of the charges of cached entries.
+    std::size_t TotalCharge() const {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < num_shards_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mu);
+            n += shards_[i].usage;
+        }
+        return n;
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+    /// Hit/miss/insert/eviction counters since construction.
+    CacheStats GetStats() const {
+        CacheStats total;
+        for (std::size_t i = 0; i < num_shards_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mu);
+            total.hits += shards_[i].stats.hits;
+            total.misses += shards_[i].stats.misses;
+            total.inserts += shards_[i].stats.inserts;
+            total.evictions += shards_[i].stats.evictions;
+            total.admission_rejects += shards_[i].stats.admission_rejects;
+        }
+        return total;
+    }
+
+private:
+    struct Entry {
+        Key key;
+        std::shared_ptr<Value> value;
+        std::size_t charge;
+    };
+    using List = std::list<Entry>;
+
+    struct Shard {
+        mutable std::mutex mu;
+        List lru;  ///< Front = most recently used.
+        std::unordered_map<Key, typename List::iterator, Hash> index;
+        std::size_t usage = 0;
+        std::size_t capacity = 0;
+        CacheStats stats;
+    };
+
+    Shard& ShardFor(const Key& key) { return shards_[detail::ShardIndex(Hash()(key), num_shards_)]; }
+
+    const std::size_t num_shards_;
+    std::unique_ptr<Shard[]> shards_;
+    const std::size_t capacity_;
+    EvictionCallback on_evict_;
+    AdmissionPolicy admit_;
+};
+
+/**
+ * @class ShardedClockCache
+ * @brief Thread-safe CLOCK cache of `std::shared_ptr<Value>` keyed by `Key`.
+ *
+ * Same interface and pinning semantics as `ShardedLRUCache`; see the file
+ * comment for how the policies differ.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ShardedClockCache {
+public:
+    explicit ShardedClockCache(std::size_t capacity, int num_shard_bits = 4)
+        : num_shards_(std::size_t{1} << num_shard_bits),
+          shards_(new Shard[num_shards_]),
+          capacity_(capacity) {
+        const std::size_t per_shard = (capacity + num_shards_ - 1) / num_shards_;
+        for (std::size_t i = 0; i < num_shards_; ++i) shards_[i].capacity = per_shard;
+    }
+
+    ShardedClockCache(const ShardedClockCache&) = delete;
+    ShardedClockCache& operator=(const ShardedClockCache&) = delete;
+
+    /// Receives each entry evicted for capacity (not `Erase()`d ones).
+    using EvictionCallback = std::function<void(const Key&, std::shared_ptr<Value>)>;
+
+    /**
+     * @brief Install `callback`; it runs on the inserting thread after the
+     * shard lock is released. Set before the cache is shared between threads.
+     */
+    void SetEvictionCallback(EvictionCallback callback) { on_evict_ = std::move(callback); }
+
+    /// Returns whether `candidate` may displace `victim`; runs under the shard lock.
+    using AdmissionPolicy = std::function<bool(const Key& candidate, const Key& victim)>;
+
+    /// Install `policy` (null admits everything). Set before concurrent use.
+    void SetAdmissionPolicy(AdmissionPolicy policy) { admit_ = std::move(policy); }
+
+    /**
+     * @brief Return the cached value for `key`, or null. A `kHigh` hit sets
+     * the entry's reference bit; a `kLow` hit does not.
+     */
+    std::shared_ptr<Value> Lookup(const Key& key, CachePriority priority = CachePriority::kHigh) {
+        Shard& shard = ShardFor(key);
+        std::shared_lock<std::shared_mutex> lock(shard.mu);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            shard.misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        shard.hits.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = shard.slots[it->second];
+        // Skip the store when already set so hot entries do not bounce the line.
+        if (priority == CachePriority::kHigh && !slot.referenced.load(std::memory_order_relaxed)) {
+            slot.referenced.store(true, std::memory_order_relaxed);
+        }
+        return slot.value;
+    }
+
+    /**
+     * @brief Insert `value` under `key` unless the key is already cached.
+     *
+     * A `kLow` entry is left under the clock hand, so it is the next victim
+     * unless a `kHigh` lookup references it first.
+     * @return The value now cached for `key` (or `value`, uncached, if the
+     *         admission policy rejects it).
+     * @param admitted If non-null, set to false on rejection, true otherwise.
+     */
+    std::shared_ptr<Value> Insert(const Key& key, std::shared_ptr<Value> value, std::size_t charge = 1,
+                                  CachePriority priority = CachePriority::kHigh, bool* admitted = nullptr) {
+        if (admitted != nullptr) *admitted = true;
+        Shard& shard = ShardFor(key);
+        std::vector<std::pair<Key, std::shared_ptr<Value>>> evicted;
+        std::unique_lock<std::shared_mutex> lock(shard.mu);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            if (priority == CachePriority::kHigh) {
+                shard.slots[it->second].referenced.store(true, std::memory_order_relaxed);
+            }
+            return shard.slots[it->second].value;
+        }
+        if (admit_ && shard.usage + charge > shard.capacity && !shard.index.empty()) {
+            // The sweep below starts at the hand, so this is its first victim.
+            const std::size_t victim = AdvanceHand(shard);
+            if (!admit_(key, shard.slots[victim].key)) {
+                ++shard.admission_rejects;
+                if (admitted != nullptr) *admitted = false;
+                return value;
+            }
+        }
+
+        std::size_t idx;
+        if (!shard.free.empty()) {
+            idx = shard.free.back();
+            shard.free.pop_back();
+        } else {
+            idx = shard.slots.size();
+            shard.slots.emplace_back();
+        }
+        Slot& slot = shard.slots[idx];
+        slot.key = key;
+        slot.value = std::move(value);
+        slot.charge = charge;
+        slot.used = true;
+        slot.referenced.store(false, std::memory_order_relaxed);
+        shard.index.emplace(key, idx);
+        shard.usage += charge;
+        ++shard.inserts;
+
+        // Sweep: clear reference bits until an unreferenced victim turns up.
+        // Two full passes always suffice, since the first clears every bit.
+        std::size_t steps = 0;
+        const std::size_t max_steps = 2 * shard.slots.size();
+        while (shard.usage > shard.capacity && shard.index.size() > 1 && steps++ < max_steps) {
+            const std::size_t victim = shard.hand;
+            shard.hand = (shard.hand + 1) % shard.slots.size();
+            Slot& s = shard.slots[victim];
+            if (!s.used || victim == idx) continue;
+            if (s.referenced.load(std::memory_order_relaxed)) {
+                s.referenced.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            if (on_evict_) evicted.emplace_back(s.key, s.value);
+            EraseSlot(shard, victim);
+            ++shard.evictions;
+        }
+        if (priority == CachePriority::kLow) shard.hand = idx;
+        std::shared_ptr<Value> result = slot.value;
+        lock.unlock();
+        for (auto& victim : evicted) on_evict_(victim.first, std::move(victim.second));
+        return result;
+    }
+
+    /**
+     * @brief Drop `key` from the cache (pinned holders keep their value).
+     */
+    void Erase(const Key& key) {
+        Shard& shard = ShardFor(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mu);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) return;
+        EraseSlot(shard, it->second);
+    }
+
+    std::size_t Size() const {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < num_shards_; ++i) {
+            std::shared_lock<std::shared_mutex> lock(shards_[i].mu);
+            n += shards_[i].index.size();
+        }
+        return n;
+    }
+
+    std::size_t TotalCharge() const {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < num_shards_; ++i) {
+            std::shared_lock<std::shared_mutex> lock(shards_[i].mu);
+            n += shards_[i].usage;
+        }
+        return n;
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+    CacheStats GetStats() const {
+        CacheStats total;
+        for (std::size_t i = 0; i < num_shards_; ++i) {
+            std::shared_lock<std::shared_mutex> lock(shards_[i].mu);
+            total.hits += shards_[i].hits.load(std::memory_order_relaxed);
+            total.misses += shards_[i].misses.load(std::memory_order_relaxed);
+            total.inserts += shards_[i].inserts;
+            total.evictions += shards_[i].evictions;
+            total.admission_rejects += shards_[i].admission_rejects;
+        }
+        return total;
+    }
+
+private:
+    struct Slot {
+        Key key{};
+        std::shared_ptr<Value> value;
+        std::size_t charge = 0;
+        bool used = false;
+        std::atomic<bool> referenced{false};
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mu;
+        std::deque<Slot> slots;  ///< Stable addresses; freed slots are reused.
+        std::vector<std::size_t> free;
+        std::unordered_map<Key, std::size_t, Hash> index;
+        std::size_t hand = 0;
+        std::size_t usage = 0;
+        std::size_t capacity = 0;
+        // Lookups run under the shared lock, so their counters are atomic.
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+        std::uint64_t inserts = 0;
+        std::uint64_t evictions = 0;
+        std::uint64_t admission_rejects = 0;
+    };
+
+    /**
+     * @brief Move the hand to the next unreferenced entry, clearing the
+     * reference bits it passes, and return its slot. Shard must be non-empty.
+     */
+    static std::size_t AdvanceHand(Shard& shard) {
+        for (std::size_t steps = 0; steps < 2 * shard.slots.size(); ++steps) {
+            Slot& s = shard.slots[shard.hand];
+            if (s.used && !s.referenced.load(std::memory_order_relaxed)) break;
+            s.referenced.store(false, std::memory_order_relaxed);
+            shard.hand = (shard.hand + 1) % shard.slots.size();
+        }
+        return shard.hand;
+    }
+
+    static void EraseSlot(Shard& shard, std::size_t idx) {
+        Slot& s = shard.slots[idx];
+        shard.index.erase(s.key);
+        shard.usage -= s.charge;
+        s.value.reset();
+        s.used = false;
+        shard.free.push_back(idx);
+    }
+
+    Shard& ShardFor(const Key& key) { return shards_[detail::ShardIndex(Hash()(key), num_shards_)]; }
+
+    const std::size_t num_shards_;
+    std::unique_ptr<Shard[]> shards_;
+    const std::size_t capacity_;
+    EvictionCallback on_evict_;
+    AdmissionPolicy admit_;
+};
+
+} // namespace VrootKV::common
@@ -0,0 +1,71 @@
+/**
+ * @file thread_pool.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of `ThreadPool`.
+ */
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace VrootKV::common {
+
+ThreadPool::ThreadPool(std::size_t num_threads) {
+    const std::size_t n = std::max<std::size_t>(1, num_threads);
+    workers_.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        workers_.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::Schedule(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        queue_.push_back(std::move(task));
+    }
+    work_cv_.notify_one();
+}
+
+void ThreadPool::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mu_);
+    idle_cv_.wait(lock, [this] { return queue_.empty() && active_ == 0; });
+}
+
+std::size_t ThreadPool::QueueLength() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return queue_.size();
+}
+
+void ThreadPool::WorkerLoop() {
+    std::unique_lock<std::mutex> lock(mu_);
+    for (;;) {
+        work_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return; // stopping_ and drained
+        }
+        std::function<void()> task = std::move(queue_.front());
+        queue_.pop_front();
+        ++active_;
+        lock.unlock();
+        task();
+        lock.lock();
+        --active_;
+        if (queue_.empty() && active_ == 0) {
+            idle_cv_.notify_all();
+        }
+    }
+}
+
+} // namespace VrootKV::common
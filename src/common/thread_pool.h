@@ -0,0 +1,68 @@
+#pragma once
+/**
+ * @file thread_pool.h
+ * @author Vrutik Halani
+ * @brief Fixed-size worker pool used for background and blocking work.
+ *
+ * Tasks run in FIFO order on `num_threads` workers. The destructor finishes
+ * every task already scheduled before joining, so callers never lose work
+ * they handed off (e.g. an I/O completion that must fulfil a promise).
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VrootKV::common {
+
+/**
+ * @class ThreadPool
+ * @brief Minimal FIFO thread pool. Thread-safe.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Start `num_threads` workers (at least one).
+     */
+    explicit ThreadPool(std::size_t num_threads);
+
+    /**
+     * @brief Run all queued tasks to completion, then join the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queue `task` to run on a worker.
+     */
+    void Schedule(std::function<void()> task);
+
+    /**
+     * @brief Block until the queue is empty and no task is running.
+     */
+    void WaitIdle();
+
+    std::size_t num_threads() const { return workers_.size(); }
+
+    /// Tasks queued but not yet started.
+    std::size_t QueueLength() const;
+
+private:
+    void WorkerLoop();
+
+    mutable std::mutex mu_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::deque<std::function<void()>> queue_;
+    std::size_t active_ = 0;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace VrootKV::common
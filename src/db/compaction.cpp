@@ -0,0 +1,274 @@
+/**
+ * @file compaction.cpp
+ * @author Vrutik Halani
+ * @brief `Compaction` helpers and the leveled and universal pickers.
+ */
+
+#include "compaction.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace VrootKV::db {
+
+// ============================================================================
+// Compaction
+// ============================================================================
+
+bool Compaction::IsTrivialMove() const {
+    return NumInputFiles() == 1 && inputs.size() == 1 && inputs[0].level != output_level;
+}
+
+uint64_t Compaction::InputBytes() const {
+    uint64_t total = 0;
+    for (const CompactionInput& in : inputs) {
+        for (const FileMetaPtr& f : in.files) total += f->file_size;
+    }
+    return total;
+}
+
+uint64_t Compaction::NumInputFiles() const {
+    uint64_t n = 0;
+    for (const CompactionInput& in : inputs) n += in.files.size();
+    return n;
+}
+
+std::string Compaction::Smallest() const {
+    const std::string* smallest = nullptr;
+    for (const CompactionInput& in : inputs) {
+        for (const FileMetaPtr& f : in.files) {
+            if (smallest == nullptr || f->smallest < *smallest) smallest = &f->smallest;
+        }
+    }
+    return smallest ? *smallest : std::string();
+}
+
+std::string Compaction::Largest() const {
+    const std::string* largest = nullptr;
+    for (const CompactionInput& in : inputs) {
+        for (const FileMetaPtr& f : in.files) {
+            if (largest == nullptr || f->largest > *largest) largest = &f->largest;
+        }
+    }
+    return largest ? *largest : std::string();
+}
+
+uint64_t MaxBytesForLevel(const Options& options, int level) {
+    double bytes = static_cast<double>(options.max_bytes_for_level_base);
+    for (int l = 1; l < level; ++l) bytes *= options.max_bytes_for_level_multiplier;
+    return static_cast<uint64_t>(bytes);
+}
+
+std::vector<std::string> SubcompactionBoundaries(std::vector<KeySample> samples, int n) {
+    std::vector<std::string> bounds;
+    if (n <= 1 || samples.empty()) return bounds;
+    std::sort(samples.begin(), samples.end(),
+              [](const KeySample& a, const KeySample& b) { return a.key < b.key; });
+    uint64_t total = 0;
+    for (const KeySample& s : samples) total += s.bytes;
+
+    // Range i ends at the first sample preceded by i/n of the bytes; no range is empty.
+    uint64_t before = 0;
+    int next = 1;
+    for (const KeySample& s : samples) {
+        if (next >= n) break;
+        const uint64_t target = total / static_cast<uint64_t>(n) * static_cast<uint64_t>(next);
+        const std::string& prev = bounds.empty() ? samples.front().key : bounds.back();
+        if (before >= target && s.key > prev) {
+            bounds.push_back(s.key);
+            while (next < n && before >= total / static_cast<uint64_t>(n) * static_cast<uint64_t>(next)) ++next;
+        }
+        before += s.bytes;
+    }
+    return bounds;
+}
+
+// ============================================================================
+// Leveled picker
+// ============================================================================
+
+namespace {
+
+bool AnyBusy(const std::vector<FileMetaPtr>& files, const std::set<uint64_t>& busy) {
+    for (const FileMetaPtr& f : files) {
+        if (busy.count(f->number)) return true;
+    }
+    return false;
+}
+
+class LeveledCompactionPicker final : public CompactionPicker {
+public:
+    explicit LeveledCompactionPicker(const Options& options) : options_(options) {}
+
+    std::unique_ptr<Compaction> Pick(const Version& version, const std::set<uint64_t>& busy) override {
+        std::vector<std::pair<double, int>> scores;
+        for (int level = 0; level < kNumLevels - 1; ++level) {
+            const double score = Score(version, level);
+            if (score >= 1.0) scores.emplace_back(score, level);
+        }
+        std::sort(scores.begin(), scores.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+        for (const auto& [score, level] : scores) {
+            (void)score;
+            auto c = level == 0 ? PickLevel0(version, busy) : PickLevel(version, level, busy);
+            if (c != nullptr) return c;
+        }
+        return nullptr;
+    }
+
+    bool NeedsCompaction(const Version& version) const override {
+        for (int level = 0; level < kNumLevels - 1; ++level) {
+            if (Score(version, level) >= 1.0) return true;
+        }
+        return false;
+    }
+
+private:
+    double Score(const Version& version, int level) const {
+        if (level == 0) {
+            return static_cast<double>(version.files[0].size()) /
+                   std::max(1, options_.level0_file_num_compaction_trigger);
+        }
+        return static_cast<double>(version.LevelBytes(level)) /
+               static_cast<double>(std::max<uint64_t>(1, MaxBytesForLevel(options_, level)));
+    }
+
+    std::unique_ptr<Compaction> PickLevel0(const Version& version, const std::set<uint64_t>& busy) const {
+        const auto& l0 = version.files[0];
+        if (l0.empty() || AnyBusy(l0, busy)) return nullptr;
+        auto c = std::make_unique<Compaction>();
+        c->output_level = 1;
+        c->inputs.push_back(CompactionInput{0, l0});
+        auto l1 = version.Overlapping(1, c->Smallest(), c->Largest());
+        if (AnyBusy(l1, busy)) return nullptr;
+        if (!l1.empty()) c->inputs.push_back(CompactionInput{1, std::move(l1)});
+        return c;
+    }
+
+    std::unique_ptr<Compaction> PickLevel(const Version& version, int level, const std::set<uint64_t>& busy) {
+        const auto& files = version.files[level];
+        if (files.empty()) return nullptr;
+        // Round-robin: start after the last key compacted at this level.
+        size_t start = 0;
+        while (start < files.size() && files[start]->largest <= compact_pointer_[level]) ++start;
+        for (size_t n = 0; n < files.size(); ++n) {
+            const FileMetaPtr& f = files[(start + n) % files.size()];
+            if (busy.count(f->number)) continue;
+            auto next = version.Overlapping(level + 1, f->smallest, f->largest);
+            if (AnyBusy(next, busy)) continue;
+            auto c = std::make_unique<Compaction>();
+            c->output_level = level + 1;
+            c->inputs.push_back(CompactionInput{level, {f}});
+            if (!next.empty()) c->inputs.push_back(CompactionInput{level + 1, std::move(next)});
+            compact_pointer_[level] = f->largest;
+            return c;
+        }
+        return nullptr;
+    }
+
+    const Options options_;
+    std::string compact_pointer_[kNumLevels];
+};
+
+// ============================================================================
+// Universal (size-tiered) picker
+// ============================================================================
+
+struct SortedRun {
+    int level = 0;
+    std::vector<FileMetaPtr> files;
+    uint64_t size = 0;
+};
+
+class UniversalCompactionPicker final : public CompactionPicker {
+public:
+    explicit UniversalCompactionPicker(const Options& options) : options_(options) {}
+
+    std::unique_ptr<Compaction> Pick(const Version& version, const std::set<uint64_t>& busy) override {
+        if (!busy.empty()) return nullptr;
+        const std::vector<SortedRun> runs = Runs(version);
+        size_t first = 0, last = 0;
+        if (!PickRuns(runs, &first, &last)) return nullptr;
+        auto c = std::make_unique<Compaction>();
+        for (size_t i = first; i <= last; ++i) c->inputs.push_back(CompactionInput{runs[i].level, runs[i].files});
+        c->output_level = last + 1 == runs.size() ? kNumLevels - 1 : std::max(0, runs[last + 1].level - 1);
+        return c;
+    }
+
+    bool NeedsCompaction(const Version& version) const override {
+        size_t first = 0, last = 0;
+        return PickRuns(Runs(version), &first, &last);
+    }
+
+private:
+    static std::vector<SortedRun> Runs(const Version& version) {
+        std::vector<SortedRun> runs;
+        for (const FileMetaPtr& f : version.files[0]) runs.push_back(SortedRun{0, {f}, f->file_size});
+        for (int level = 1; level < kNumLevels; ++level) {
+            if (version.files[level].empty()) continue;
+            runs.push_back(SortedRun{level, version.files[level], version.LevelBytes(level)});
+        }
+        return runs;
+    }
+
+    /// Choose runs [first, last] to merge (see the rules in compaction.h).
+    bool PickRuns(const std::vector<SortedRun>& runs, size_t* first, size_t* last) const {
+        const size_t n = runs.size();
+        if (n < 2) return false;
+
+        uint64_t newer = 0;
+        for (size_t i = 0; i + 1 < n; ++i) newer += runs[i].size;
+        if (static_cast<double>(newer) * 100.0 >
+            static_cast<double>(std::max<uint64_t>(1, runs.back().size)) *
+                options_.universal_max_size_amplification_percent) {
+            *first = 0;
+            *last = n - 1;
+            return true;
+        }
+
+        const size_t trigger = static_cast<size_t>(std::max(2, options_.level0_file_num_compaction_trigger));
+        if (n < trigger) return false;
+
+        const size_t min_width = static_cast<size_t>(std::max(2, options_.universal_min_merge_width));
+        const size_t max_width = std::max(min_width, static_cast<size_t>(std::max(2, options_.universal_max_merge_width)));
+        const double ratio = (100.0 + options_.universal_size_ratio) / 100.0;
+        for (size_t i = 0; i + 1 < n; ++i) {
+            // Older runs join while they are similar in size to the newest run of the group.
+            const double limit = static_cast<double>(runs[i].size) * ratio;
+            size_t end = i + 1;
+            while (end < n && end - i < max_width && static_cast<double>(runs[end].size) <= limit) ++end;
+            if (end - i >= min_width) {
+                *first = i;
+                *last = end - 1;
+                return true;
+            }
+        }
+
+        // Too many runs for reads (writers are stalling on level 0): merge the newest ones.
+        const size_t stop = static_cast<size_t>(std::max(2, options_.level0_stop_writes_trigger));
+        if (n >= stop) {
+            *first = 0;
+            *last = n - trigger + 1;
+            return true;
+        }
+        return false;
+    }
+
+    const Options options_;
+};
+
+} // namespace
+
+std::unique_ptr<CompactionPicker> NewLeveledCompactionPicker(const Options& options) {
+    return std::make_unique<LeveledCompactionPicker>(options);
+}
+
+std::unique_ptr<CompactionPicker> NewUniversalCompactionPicker(const Options& options) {
+    return std::make_unique<UniversalCompactionPicker>(options);
+}
+
+std::unique_ptr<CompactionPicker> NewCompactionPicker(const Options& options) {
+    if (options.compaction_style == CompactionStyle::kUniversal) return NewUniversalCompactionPicker(options);
+    return NewLeveledCompactionPicker(options);
+}
+
+} // namespace VrootKV::db
@@ -0,0 +1,123 @@
+/**
+ * @file compaction.h
+ * @author Vrutik Halani
+ * @brief What to compact next: `Compaction` descriptions and the pickers that choose them.
+ *
+ * A `Compaction` names its input tables, grouped by level and ordered newest
+ * first, and the level its output goes to. The DB merges the inputs (newest
+ * value of each key wins), writes the result as new tables at the output
+ * level and installs the edit atomically.
+ *
+ * Pickers only read a `Version` and the set of tables already claimed by
+ * running compactions (`busy`); they never return a compaction that touches
+ * a busy table, which is what lets several compactions run in parallel.
+ *
+ * Leveled picking
+ * ---------------
+ *  - Score of level 0: table count / `level0_file_num_compaction_trigger`.
+ *  - Score of level L >= 1: bytes / MaxBytesForLevel(L). The last level is
+ *    never compacted.
+ *  - Levels with score >= 1 are tried from the highest score down.
+ *  - Level 0 compacts all of its tables (they overlap) plus the overlapping
+ *    level-1 tables; only one level-0 compaction runs at a time.
+ *  - Level L >= 1 compacts one table, chosen round-robin after the last key
+ *    compacted at that level, plus the overlapping tables at L+1.
+ *
+ * Universal picking
+ * -----------------
+ * Sorted runs, newest first, are the level-0 tables followed by each
+ * non-empty level >= 1 (so each such level holds exactly one run). A
+ * compaction merges consecutive runs; its output replaces them at the level
+ * just above the next older run (level 0 if that run is at level 0 or 1),
+ * or at the last level when the oldest run is included.
+ *  1. Space amplification: if the runs above the oldest exceed
+ *     `universal_max_size_amplification_percent` of it, merge everything.
+ *  2. Tiering (once there are `level0_file_num_compaction_trigger` runs):
+ *     from the newest run, find `universal_min_merge_width` or more
+ *     consecutive runs each at most (100 + `universal_size_ratio`)% of the
+ *     first one's size, and merge them. Runs thus grow by about the merge
+ *     width per tier, and a byte is rewritten once per tier.
+ *  3. With `level0_stop_writes_trigger` runs or more, merge the newest runs
+ *     to get back under the trigger, so stalled writers always make progress.
+ * Level-0 output is written as a single table (one table = one run there).
+ * Ordering of runs depends on each other's positions, so only one universal
+ * compaction runs at a time.
+ *
+ * Subcompactions
+ * --------------
+ * A compaction of at least two output tables' worth of input may be split
+ * into up to `max_subcompactions` disjoint key ranges, merged in parallel
+ * and installed together. The split points come from the index-block keys
+ * of the inputs, each weighted by the bytes of its data block, so every
+ * range gets about the same amount of input. Level-0 output is never split.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "version.h"
+#include "VrootKV/db/db.h"
+
+namespace VrootKV::db {
+
+struct CompactionInput {
+    int level = 0;
+    std::vector<FileMetaPtr> files;  ///< Level 0: newest first. Otherwise sorted by key.
+};
+
+struct Compaction {
+    std::vector<CompactionInput> inputs;  ///< Newest level first.
+    int output_level = 1;
+
+    /// A single input table with nothing to merge against: move it instead of rewriting.
+    bool IsTrivialMove() const;
+    uint64_t InputBytes() const;
+    uint64_t NumInputFiles() const;
+    /// Key range covered by all inputs.
+    std::string Smallest() const;
+    std::string Largest() const;
+};
+
+/// Byte target of `level` (>= 1).
+uint64_t MaxBytesForLevel(const Options& options, int level);
+
+/// A key from the compaction inputs standing for `bytes` of input data.
+struct KeySample {
+    std::string key;
+    uint64_t bytes = 0;
+};
+
+/**
+ * @brief Split points dividing the sampled inputs into `n` key ranges of
+ *        about equal size, for subcompactions.
+ * @return At most n - 1 strictly increasing keys `b`; range i covers
+ *         [b[i-1], b[i]), with the first and last ranges unbounded.
+ */
+std::vector<std::string> SubcompactionBoundaries(std::vector<KeySample> samples, int n);
+
+class CompactionPicker {
+public:
+    virtual ~CompactionPicker() = default;
+
+    /**
+     * @brief Choose the most urgent compaction that avoids `busy` tables.
+     * @return Null if nothing needs (or can) run now.
+     */
+    virtual std::unique_ptr<Compaction> Pick(const Version& version, const std::set<uint64_t>& busy) = 0;
+
+    /// True if `version` warrants a compaction, ignoring what is running.
+    virtual bool NeedsCompaction(const Version& version) const = 0;
+};
+
+std::unique_ptr<CompactionPicker> NewLeveledCompactionPicker(const Options& options);
+std::unique_ptr<CompactionPicker> NewUniversalCompactionPicker(const Options& options);
+
+/// Picker for `options.compaction_style`.
+std::unique_ptr<CompactionPicker> NewCompactionPicker(const Options& options);
+
+} // namespace VrootKV::db
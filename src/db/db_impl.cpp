@@ -0,0 +1,781 @@
+/**
+ * @file db_impl.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of `DBImpl` and `DB::Open()`.
+ *
+ * Log records
+ * -----------
+ * Each `Write()` appends BEGIN_TX(seq), one PUT / DELETE_ frame per
+ * operation and COMMIT_TX(seq) in a single file write. Replay applies a
+ * transaction only once its COMMIT has been read, and stops at the first
+ * frame that fails to parse (a torn tail from a crash mid-append).
+ *
+ * File lifecycle
+ * --------------
+ *  - Switching memtables allocates the next log number and records the
+ *    bumped `next_file_number` in the MANIFEST before creating the log, so
+ *    recovery always knows every log that might exist.
+ *  - Installing a flushed table records it together with the current log as
+ *    the oldest one needed; older logs are then deleted.
+ *  - Compaction outputs get fresh numbers; the inputs they replace are
+ *    deleted once no `Version` references them any more.
+ *
+ * Compaction
+ * ----------
+ * Inputs are merged newest first, so the first (and only) entry the merge
+ * yields per key is its newest version. A tombstone is dropped when no table
+ * below the output level can hold an older value of its key. Output is cut
+ * into tables of about `target_file_size`.
+ */
+
+#include "db_impl.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "db_iter.h"
+#include "filename.h"
+#include "level_iterator.h"
+#include "merging_iterator.h"
+#include "../io/table_builder.h"
+#include "../wal/wal_format.h"
+
+namespace VrootKV::db {
+
+namespace {
+
+using memtable::MemTable;
+
+std::string Frame(uint64_t txn_id, wal::RecordType type, std::string_view key, std::string_view value) {
+    wal::WALRecord record;
+    record.txn_id = txn_id;
+    record.type = type;
+    record.key.assign(key);
+    record.value.assign(value);
+    return record.SerializeFrame();
+}
+
+io::ReadOptions TableReadOptions(const ReadOptions& options) {
+    io::ReadOptions read_options;
+    read_options.fill_cache = options.fill_cache;
+    return read_options;
+}
+
+std::shared_ptr<MemTable> NewMemTable(const Options& options) {
+    memtable::MemTableOptions mem_options;
+    mem_options.bloom_expected_entries = options.memtable_bloom_expected_entries;
+    mem_options.bloom_false_positive_rate = options.memtable_bloom_false_positive_rate;
+    return std::make_shared<MemTable>(mem_options);
+}
+
+io::TableBuilderOptions BuilderOptions(const Options& options, int level) {
+    io::TableBuilderOptions builder_options;
+    builder_options.block_size = options.block_size;
+    builder_options.bits_per_key = options.bits_per_key;
+    builder_options.filter_budget = options.filter_budget;
+    builder_options.level = level;
+    return builder_options;
+}
+
+/**
+ * @brief Tell the filter budget (if any) how big each level of `version` is.
+ *
+ * Bytes stand in for entry counts: the allocation depends only on the levels'
+ * relative sizes, and entry sizes are similar across levels.
+ */
+void PublishLevelShape(common::FilterBudget* budget, const Version& version) {
+    if (budget == nullptr) return;
+    std::vector<uint64_t> bytes(kNumLevels, 0);
+    for (int level = 0; level < kNumLevels; ++level) {
+        for (const FileMetaPtr& f : version.files[level]) bytes[level] += f->file_size;
+    }
+    budget->SetLevelEntries(std::move(bytes));
+}
+
+} // namespace
+
+// ============================================================================
+// Construction, recovery, shutdown
+// ============================================================================
+
+DBImpl::DBImpl(const std::string& dbname, const Options& options)
+    : dbname_(dbname),
+      options_(options),
+      fm_(options.file_manager),
+      mem_(NewMemTable(options)),
+      current_(std::make_shared<const Version>()) {
+    if (fm_ == nullptr) {
+        owned_file_manager_ = io::NewDefaultFileManager();
+        fm_ = owned_file_manager_.get();
+    }
+    io::TableCacheOptions table_options;
+    table_options.max_open_tables = options_.max_open_tables;
+    if (options_.block_cache_size > 0) {
+        io::BlockCacheOptions block_options;
+        block_options.capacity = options_.block_cache_size;
+        block_cache_ = std::make_shared<io::BlockCache>(block_options);
+        table_options.table_options.block_cache = block_cache_;
+    }
+    table_cache_ = std::make_unique<io::TableCache>(fm_, dbname_, table_options);
+    if (options_.row_cache_size > 0) {
+        io::RowCacheOptions row_options;
+        row_options.capacity = options_.row_cache_size;
+        row_cache_ = std::make_unique<io::RowCache>(row_options);
+    }
+    picker_ = NewCompactionPicker(options_);
+    compaction_pool_ = std::make_unique<common::ThreadPool>(
+        static_cast<std::size_t>(std::max(1, options_.max_background_compactions)));
+    bg_pool_ = std::make_unique<common::ThreadPool>(1);
+}
+
+DBImpl::~DBImpl() {
+    shutting_down_ = true;  // running compactions abandon their output
+    bg_pool_.reset();       // finishes a pending flush
+    compaction_pool_.reset();
+    std::lock_guard<std::mutex> lock(mu_);
+    PurgeObsoleteFilesLocked();
+    if (log_ != nullptr) log_->Close();
+}
+
+uint64_t DBImpl::NewFileNumber() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return next_file_number_++;
+}
+
+void DBImpl::Recover() {
+    if (!fm_->CreateDir(dbname_)) {
+        throw std::runtime_error("DB: cannot create directory " + dbname_);
+    }
+    ManifestState state;
+    const bool exists = ReadManifest(fm_, dbname_, &state);
+    if (exists && options_.error_if_exists) {
+        throw std::runtime_error("DB: database already exists in " + dbname_);
+    }
+    if (!exists && !options_.create_if_missing) {
+        throw std::runtime_error("DB: no database in " + dbname_);
+    }
+    next_file_number_ = state.next_file_number;
+    last_sequence_ = state.last_sequence;
+
+    // Logs and tables share the number space; only existing .log names are replayed.
+    MemTable recovered;
+    for (uint64_t number = state.log_number; number < next_file_number_; ++number) {
+        const std::string fname = LogFileName(dbname_, number);
+        if (fm_->FileExists(fname)) ReplayLog(fname, &recovered);
+    }
+
+    auto version = std::make_shared<Version>(state.version);
+    if (!recovered.empty()) {
+        auto meta = std::make_shared<FileMetaData>();
+        if (!WriteLevel0Table(recovered, next_file_number_++, meta.get())) {
+            throw std::runtime_error("DB: cannot write recovered table");
+        }
+        version->files[0].insert(version->files[0].begin(), std::move(meta));
+    }
+    current_ = std::move(version);
+    PublishLevelShape(options_.filter_budget, *current_);
+
+    log_number_ = next_file_number_++;
+    if (!WriteManifest(fm_, dbname_, StateLocked(current_, log_number_))) {
+        throw std::runtime_error("DB: cannot write MANIFEST");
+    }
+    if (!fm_->NewWritableFile(LogFileName(dbname_, log_number_), log_)) {
+        throw std::runtime_error("DB: cannot create log");
+    }
+    manifest_log_number_ = log_number_;
+    DeleteObsoleteLogs(state.log_number, log_number_);
+
+    std::lock_guard<std::mutex> lock(mu_);
+    MaybeScheduleCompactionsLocked();
+}
+
+/**
+ * @brief Apply the committed transactions of one log to `mem`.
+ */
+void DBImpl::ReplayLog(const std::string& fname, MemTable* mem) {
+    std::string contents;
+    if (!ReadFileToString(fm_, fname, &contents)) {
+        throw std::runtime_error("DB: cannot read log " + fname);
+    }
+    std::string_view in(contents);
+    std::vector<wal::WALRecord> pending;
+    bool in_txn = false;
+    uint64_t txn_id = 0;
+    while (!in.empty()) {
+        wal::WALRecord record;
+        try {
+            record = wal::WALRecord::ParseFrame(in);
+        } catch (const std::runtime_error&) {
+            break;  // torn tail: everything after it was never acknowledged
+        }
+        switch (record.type) {
+            case wal::RecordType::BEGIN_TX:
+                pending.clear();
+                in_txn = true;
+                txn_id = record.txn_id;
+                break;
+            case wal::RecordType::PUT:
+            case wal::RecordType::DELETE_:
+                if (in_txn && record.txn_id == txn_id) pending.push_back(std::move(record));
+                break;
+            case wal::RecordType::COMMIT_TX:
+                if (in_txn && record.txn_id == txn_id) {
+                    for (const wal::WALRecord& op : pending) {
+                        if (op.type == wal::RecordType::PUT) {
+                            mem->Put(op.key, op.value);
+                        } else {
+                            mem->Delete(op.key);
+                        }
+                    }
+                    last_sequence_ = std::max(last_sequence_, txn_id);
+                }
+                pending.clear();
+                in_txn = false;
+                break;
+            case wal::RecordType::ABORT_TX:
+                pending.clear();
+                in_txn = false;
+                break;
+        }
+    }
+}
+
+ManifestState DBImpl::StateLocked(std::shared_ptr<const Version> version, uint64_t log_number) const {
+    ManifestState state;
+    state.next_file_number = next_file_number_;
+    state.log_number = log_number;
+    state.last_sequence = last_sequence_;
+    state.version = *version;
+    return state;
+}
+
+void DBImpl::DeleteObsoleteLogs(uint64_t begin, uint64_t end) {
+    for (uint64_t number = begin; number < end; ++number) {
+        const std::string fname = LogFileName(dbname_, number);
+        if (fm_->FileExists(fname)) fm_->DeleteFile(fname);
+    }
+}
+
+// ============================================================================
+// Write path
+// ============================================================================
+
+bool DBImpl::Put(std::string_view key, std::string_view value, const WriteOptions& options) {
+    WriteBatch batch;
+    batch.Put(key, value);
+    return Write(batch, options);
+}
+
+bool DBImpl::Delete(std::string_view key, const WriteOptions& options) {
+    WriteBatch batch;
+    batch.Delete(key);
+    return Write(batch, options);
+}
+
+bool DBImpl::Write(const WriteBatch& batch, const WriteOptions& options) {
+    if (batch.Count() == 0) return true;
+    std::unique_lock<std::mutex> lock(mu_);
+    if (!MakeRoomForWrite(lock, /*force=*/false)) return false;
+
+    const uint64_t seq = last_sequence_ + 1;
+    std::string frames = Frame(seq, wal::RecordType::BEGIN_TX, {}, {});
+    for (const WriteBatch::Op& op : batch.ops()) {
+        frames += op.type == WriteBatch::OpType::kPut ? Frame(seq, wal::RecordType::PUT, op.key, op.value)
+                                                      : Frame(seq, wal::RecordType::DELETE_, op.key, {});
+    }
+    frames += Frame(seq, wal::RecordType::COMMIT_TX, {}, {});
+    if (!log_->Write(frames) || !(options.sync ? log_->Sync() : log_->Flush())) {
+        // The log may now end in a partial transaction; appending after it is unsafe.
+        bg_error_ = true;
+        return false;
+    }
+    last_sequence_ = seq;
+
+    for (const WriteBatch::Op& op : batch.ops()) {
+        if (op.type == WriteBatch::OpType::kPut) {
+            mem_->Put(op.key, op.value);
+        } else {
+            mem_->Delete(op.key);
+        }
+        if (row_cache_ != nullptr) row_cache_->Invalidate(op.key);
+    }
+    return true;
+}
+
+/**
+ * @brief Ensure the active memtable has room, switching to a new one if full
+ *        (or if `force` and it is non-empty). Caller holds `lock`.
+ */
+bool DBImpl::MakeRoomForWrite(std::unique_lock<std::mutex>& lock, bool force) {
+    while (true) {
+        if (bg_error_) return false;
+        if (mem_->empty() || (!force && mem_->ApproximateMemoryUsage() < options_.write_buffer_size)) {
+            return true;
+        }
+        if (imm_ != nullptr) {
+            bg_cv_.wait(lock);  // previous flush still running
+            continue;
+        }
+        if (static_cast<int>(current_->files[0].size()) >= options_.level0_stop_writes_trigger) {
+            bg_cv_.wait(lock);  // let compaction drain level 0 first
+            continue;
+        }
+
+        const uint64_t new_log_number = next_file_number_++;
+        if (!WriteManifest(fm_, dbname_, StateLocked(current_, manifest_log_number_))) return false;
+        std::unique_ptr<io::IWritableFile> new_log;
+        if (!fm_->NewWritableFile(LogFileName(dbname_, new_log_number), new_log)) return false;
+        if (!log_->Close()) {
+            bg_error_ = true;
+            return false;
+        }
+        log_ = std::move(new_log);
+        log_number_ = new_log_number;
+        imm_ = std::move(mem_);
+        mem_ = NewMemTable(options_);
+        bg_pool_->Schedule([this] { BackgroundFlush(); });
+        return true;
+    }
+}
+
+// ============================================================================
+// Flush
+// ============================================================================
+
+bool DBImpl::Flush() {
+    std::unique_lock<std::mutex> lock(mu_);
+    if (!MakeRoomForWrite(lock, /*force=*/true)) return false;
+    bg_cv_.wait(lock, [this] { return imm_ == nullptr || bg_error_; });
+    return !bg_error_;
+}
+
+void DBImpl::BackgroundFlush() {
+    std::shared_ptr<MemTable> imm;
+    uint64_t number = 0;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        imm = imm_;
+        number = next_file_number_++;
+    }
+
+    auto meta = std::make_shared<FileMetaData>();
+    bool ok = false;
+    try {
+        ok = WriteLevel0Table(*imm, number, meta.get());
+    } catch (const std::exception&) {
+        ok = false;
+    }
+
+    std::lock_guard<std::mutex> lock(mu_);
+    if (ok) {
+        auto version = std::make_shared<Version>(*current_);
+        version->files[0].insert(version->files[0].begin(), std::move(meta));
+        // The flushed memtable's log is no longer needed: only the active one is.
+        ok = WriteManifest(fm_, dbname_, StateLocked(version, log_number_));
+        if (ok) {
+            current_ = std::move(version);
+            PublishLevelShape(options_.filter_budget, *current_);
+            DeleteObsoleteLogs(manifest_log_number_, log_number_);
+            manifest_log_number_ = log_number_;
+            imm_.reset();
+            PurgeObsoleteFilesLocked();
+            MaybeScheduleCompactionsLocked();
+        }
+    }
+    if (!ok) {
+        fm_->DeleteFile(io::TableFileName(dbname_, number));
+        bg_error_ = true;
+    }
+    bg_cv_.notify_all();
+}
+
+/**
+ * @brief Write `mem` as table `number` (values keep their tags). Runs unlocked.
+ */
+bool DBImpl::WriteLevel0Table(const MemTable& mem, uint64_t number, FileMetaData* meta) {
+    std::unique_ptr<io::IWritableFile> file;
+    if (!fm_->NewWritableFile(io::TableFileName(dbname_, number), file)) return false;
+
+    io::TableBuilder builder(BuilderOptions(options_, 0), file.get());
+
+    std::string tagged;
+    for (auto it = mem.Begin(); it.Valid(); it.Next()) {
+        if (builder.NumEntries() == 0) meta->smallest = it.key();
+        meta->largest = it.key();
+        tagged.assign(1, it.IsDeletion() ? MemTable::kTypeDeletion : MemTable::kTypeValue);
+        tagged.append(it.value());
+        builder.Add(it.key(), tagged);
+    }
+    if (!builder.Finish() || !file->Sync() || !file->Close()) return false;
+    meta->number = number;
+    meta->file_size = builder.FileSize();
+    return true;
+}
+
+// ============================================================================
+// Read path
+// ============================================================================
+
+bool DBImpl::Get(std::string_view key, std::string& value, const ReadOptions& options) {
+    const std::string k(key);
+    std::shared_ptr<const Version> version;
+    uint64_t row_sequence = 0;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        for (const MemTable* mem : {mem_.get(), imm_.get()}) {
+            if (mem == nullptr) continue;
+            switch (mem->Get(k, value)) {
+                case MemTable::LookupResult::kFound:    return true;
+                case MemTable::LookupResult::kDeleted:  return false;
+                case MemTable::LookupResult::kNotFound: break;
+            }
+        }
+        version = current_;
+        if (row_cache_ != nullptr) row_sequence = row_cache_->Sequence();
+    }
+
+    if (row_cache_ != nullptr) {
+        if (auto row = row_cache_->Lookup(k)) {
+            if (row->found) value = row->value;
+            return row->found;
+        }
+    }
+
+    std::string tagged;
+    const bool found = GetFromTables(*version, k, &tagged, TableReadOptions(options)) &&
+                       tagged[0] == MemTable::kTypeValue;
+    if (found) value.assign(tagged, 1, std::string::npos);
+    if (row_cache_ != nullptr && options.fill_cache) {
+        row_cache_->Insert(k, found, found ? value : std::string(), row_sequence);
+    }
+    return found;
+}
+
+/**
+ * @brief Newest table entry (tagged value or tombstone) for `key`, if any.
+ */
+bool DBImpl::GetFromTables(const Version& version, const std::string& key, std::string* tagged,
+                           const io::ReadOptions& read_options) {
+    for (const FileMetaPtr& f : version.files[0]) {
+        if (key < f->smallest || key > f->largest) continue;
+        if (table_cache_->Get(f->number, key, *tagged, read_options)) {
+            if (tagged->empty()) throw std::runtime_error("DB: untagged table value");
+            return true;
+        }
+    }
+    for (int level = 1; level < kNumLevels; ++level) {
+        const auto& files = version.files[level];
+        auto it = FindFile(files, key);
+        if (it == files.end() || key < (*it)->smallest) continue;
+        if (table_cache_->Get((*it)->number, key, *tagged, read_options)) {
+            if (tagged->empty()) throw std::runtime_error("DB: untagged table value");
+            return true;
+        }
+    }
+    return false;
+}
+
+std::unique_ptr<common::Iterator> DBImpl::NewIterator(const ReadOptions& options) {
+    std::vector<std::unique_ptr<common::Iterator>> children;
+    std::shared_ptr<MemTable> imm;
+    std::shared_ptr<const Version> version;
+    {
+        // Creating the memtable iterator fixes which writes it shows, so it is
+        // done under the lock, between batches. It copies nothing and is read
+        // unlocked afterwards, concurrently with later writes.
+        std::lock_guard<std::mutex> lock(mu_);
+        children.push_back(mem_->NewIterator(mem_));
+        imm = imm_;
+        version = current_;
+    }
+    if (imm != nullptr) children.push_back(imm->NewIterator(imm));
+
+    const io::ReadOptions read_options = TableReadOptions(options);
+    for (const FileMetaPtr& f : version->files[0]) {
+        children.push_back(table_cache_->NewIterator(f->number, read_options));
+    }
+    for (int level = 1; level < kNumLevels; ++level) {
+        if (version->files[level].empty()) continue;
+        children.push_back(NewLevelIterator(version->files[level], table_cache_.get(), read_options));
+    }
+    return NewDBIterator(NewMergingIterator(std::move(children)), std::move(version));
+}
+
+int DBImpl::NumFilesAtLevel(int level) {
+    if (level < 0 || level >= kNumLevels) return 0;
+    std::lock_guard<std::mutex> lock(mu_);
+    return static_cast<int>(current_->files[level].size());
+}
+
+uint64_t DBImpl::NumBytesAtLevel(int level) {
+    if (level < 0 || level >= kNumLevels) return 0;
+    std::lock_guard<std::mutex> lock(mu_);
+    return current_->LevelBytes(level);
+}
+
+// ============================================================================
+// Compaction
+// ============================================================================
+
+/**
+ * @brief Start as many compactions as the picker finds and the pool allows.
+ */
+void DBImpl::MaybeScheduleCompactionsLocked() {
+    while (!shutting_down_ && !bg_error_ && running_compactions_ < options_.max_background_compactions) {
+        std::shared_ptr<Compaction> c = picker_->Pick(*current_, compacting_);
+        if (c == nullptr) return;
+        for (const CompactionInput& in : c->inputs) {
+            for (const FileMetaPtr& f : in.files) compacting_.insert(f->number);
+        }
+        ++running_compactions_;
+        compaction_pool_->Schedule([this, c] { BackgroundCompaction(c); });
+    }
+}
+
+void DBImpl::BackgroundCompaction(std::shared_ptr<Compaction> c) {
+    std::shared_ptr<const Version> base;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        base = current_;
+    }
+
+    std::vector<FileMetaPtr> outputs;
+    bool ok = true;
+    if (c->IsTrivialMove()) {
+        outputs = c->inputs[0].files;
+    } else {
+        try {
+            ok = DoCompactionWork(*c, *base, &outputs);
+        } catch (const std::exception&) {
+            ok = false;
+        }
+    }
+    base.reset();
+
+    std::lock_guard<std::mutex> lock(mu_);
+    if (ok) ok = InstallCompactionLocked(*c, outputs);
+    if (!ok && !c->IsTrivialMove()) {
+        for (const FileMetaPtr& f : outputs) fm_->DeleteFile(io::TableFileName(dbname_, f->number));
+    }
+    // An abandoned compaction at shutdown is not an error: its inputs are intact.
+    if (!ok && !shutting_down_) bg_error_ = true;
+    for (const CompactionInput& in : c->inputs) {
+        for (const FileMetaPtr& f : in.files) compacting_.erase(f->number);
+    }
+    c->inputs.clear();  // drop our references so the inputs can be purged now
+    outputs.clear();
+    --running_compactions_;
+    PurgeObsoleteFilesLocked();
+    MaybeScheduleCompactionsLocked();
+    bg_cv_.notify_all();
+}
+
+/**
+ * @brief Merge the inputs of `c` into new tables at its output level. Runs unlocked.
+ * @param base Version the compaction was picked from (decides tombstone drops).
+ * @param outputs Receives every table written, also on failure (so the caller
+ *        can delete them), in key order.
+ *
+ * Large compactions are split into key ranges; ranges after the first run on
+ * threads of their own while this thread merges the first one.
+ */
+bool DBImpl::DoCompactionWork(const Compaction& c, const Version& base, std::vector<FileMetaPtr>* outputs) {
+    const std::vector<std::string> bounds = SubcompactionBoundariesFor(c);
+    if (bounds.empty()) return DoSubcompaction(c, base, nullptr, nullptr, outputs);
+
+    const size_t n = bounds.size() + 1;
+    std::vector<std::vector<FileMetaPtr>> range_outputs(n);
+    std::vector<char> range_ok(n, 0);
+    auto run = [&](size_t i) {
+        const std::string* begin = i == 0 ? nullptr : &bounds[i - 1];
+        const std::string* end = i + 1 == n ? nullptr : &bounds[i];
+        try {
+            range_ok[i] = DoSubcompaction(c, base, begin, end, &range_outputs[i]);
+        } catch (const std::exception&) {
+            range_ok[i] = false;
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < n; ++i) threads.emplace_back(run, i);
+    run(0);
+    for (std::thread& t : threads) t.join();
+
+    bool ok = true;
+    for (size_t i = 0; i < n; ++i) {
+        ok = ok && range_ok[i];
+        outputs->insert(outputs->end(), range_outputs[i].begin(), range_outputs[i].end());
+    }
+    return ok;
+}
+
+/**
+ * @brief Split points for `c`, or none if it should run as one range.
+ *
+ * Every input table contributes its index keys (at most `kMaxSamplesPerTable`
+ * of them, evenly spaced), each weighted by its share of the table's bytes.
+ * Ranges are sized to fill at least one output table each.
+ */
+std::vector<std::string> DBImpl::SubcompactionBoundariesFor(const Compaction& c) {
+    constexpr size_t kMaxSamplesPerTable = 128;
+    if (options_.max_subcompactions <= 1 || c.output_level == 0) return {};
+    const uint64_t max_ranges = c.InputBytes() / std::max<uint64_t>(1, options_.target_file_size);
+    const int n = static_cast<int>(std::min<uint64_t>(static_cast<uint64_t>(options_.max_subcompactions), max_ranges));
+    if (n <= 1) return {};
+
+    std::vector<KeySample> samples;
+    for (const CompactionInput& in : c.inputs) {
+        for (const FileMetaPtr& f : in.files) {
+            const std::vector<std::string> keys = table_cache_->FindTable(f->number)->IndexKeys();
+            if (keys.empty()) continue;
+            const size_t stride = (keys.size() + kMaxSamplesPerTable - 1) / kMaxSamplesPerTable;
+            const uint64_t bytes = f->file_size / keys.size() * stride;
+            for (size_t i = 0; i < keys.size(); i += stride) samples.push_back(KeySample{keys[i], bytes});
+        }
+    }
+    return SubcompactionBoundaries(std::move(samples), n);
+}
+
+/**
+ * @brief Merge the inputs of `c` within [begin, end) (null: unbounded) into
+ *        new tables appended to `outputs`. Runs unlocked.
+ */
+bool DBImpl::DoSubcompaction(const Compaction& c, const Version& base, const std::string* begin,
+                             const std::string* end, std::vector<FileMetaPtr>* outputs) {
+    io::ReadOptions read_options;
+    read_options.fill_cache = false;  // compaction inputs are read once
+    std::vector<std::unique_ptr<common::Iterator>> children;
+    for (const CompactionInput& in : c.inputs) {
+        if (in.level == 0) {
+            for (const FileMetaPtr& f : in.files) children.push_back(table_cache_->NewIterator(f->number, read_options));
+        } else {
+            children.push_back(NewLevelIterator(in.files, table_cache_.get(), read_options));
+        }
+    }
+    auto input = NewMergingIterator(std::move(children));
+
+    const io::TableBuilderOptions builder_options = BuilderOptions(options_, c.output_level);
+
+    std::unique_ptr<io::IWritableFile> file;
+    std::unique_ptr<io::TableBuilder> builder;
+    std::shared_ptr<FileMetaData> meta;
+    auto finish_output = [&]() -> bool {
+        const bool done = builder->Finish() && file->Sync() && file->Close();
+        meta->file_size = builder->FileSize();
+        builder.reset();
+        file.reset();
+        return done;
+    };
+
+    std::string key, value;
+    if (begin != nullptr) {
+        input->Seek(*begin);
+    } else {
+        input->SeekToFirst();
+    }
+    for (; input->Valid(); input->Next()) {
+        if (shutting_down_) return false;
+        if (end != nullptr && input->key() >= *end) break;
+        key.assign(input->key());
+        value.assign(input->value());
+        if (value.empty()) throw std::runtime_error("DB: untagged table value");
+        // Level-0 output (universal style) may sit above older level-0 runs: keep its tombstones.
+        if (value[0] == MemTable::kTypeDeletion && c.output_level > 0 &&
+            !base.KeyMayExistBelow(c.output_level, key)) {
+            continue;
+        }
+
+        if (builder == nullptr) {
+            meta = std::make_shared<FileMetaData>();
+            meta->number = NewFileNumber();
+            meta->smallest = key;
+            outputs->push_back(meta);
+            if (!fm_->NewWritableFile(io::TableFileName(dbname_, meta->number), file)) return false;
+            builder = std::make_unique<io::TableBuilder>(builder_options, file.get());
+        }
+        builder->Add(key, value);
+        meta->largest = key;
+        // A level-0 run must stay one table; deeper levels are cut to size.
+        if (c.output_level > 0 && builder->FileSize() >= options_.target_file_size && !finish_output()) {
+            return false;
+        }
+    }
+    return builder == nullptr || finish_output();
+}
+
+/**
+ * @brief Replace the inputs of `c` with `outputs` in a new version and persist it.
+ */
+bool DBImpl::InstallCompactionLocked(const Compaction& c, const std::vector<FileMetaPtr>& outputs) {
+    auto version = std::make_shared<Version>(*current_);
+    std::set<uint64_t> inputs;
+    for (const CompactionInput& in : c.inputs) {
+        for (const FileMetaPtr& f : in.files) inputs.insert(f->number);
+    }
+    auto is_input = [&](const FileMetaPtr& f) { return inputs.count(f->number) > 0; };
+
+    // Level 0 is ordered by age: output landing there takes the place of its inputs.
+    auto& l0 = version->files[0];
+    const size_t l0_slot = static_cast<size_t>(std::find_if(l0.begin(), l0.end(), is_input) - l0.begin());
+    for (auto& files : version->files) {
+        files.erase(std::remove_if(files.begin(), files.end(), is_input), files.end());
+    }
+    auto& out = version->files[c.output_level];
+    if (c.output_level == 0) {
+        out.insert(out.begin() + static_cast<std::ptrdiff_t>(std::min(l0_slot, out.size())),
+                   outputs.begin(), outputs.end());
+    } else {
+        out.insert(out.end(), outputs.begin(), outputs.end());
+        std::sort(out.begin(), out.end(),
+                  [](const FileMetaPtr& a, const FileMetaPtr& b) { return a->smallest < b->smallest; });
+    }
+
+    if (!WriteManifest(fm_, dbname_, StateLocked(version, manifest_log_number_))) return false;
+    current_ = std::move(version);
+    PublishLevelShape(options_.filter_budget, *current_);
+    if (!c.IsTrivialMove()) {
+        for (const CompactionInput& in : c.inputs) {
+            obsolete_files_.insert(obsolete_files_.end(), in.files.begin(), in.files.end());
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Delete replaced tables that no version references any more.
+ *
+ * Versions are only ever copied from `current_`, which no longer lists these
+ * tables, so a use count of one (this list) cannot grow again.
+ */
+void DBImpl::PurgeObsoleteFilesLocked() {
+    auto unused = [](const FileMetaPtr& f) { return f.use_count() == 1; };
+    for (const FileMetaPtr& f : obsolete_files_) {
+        if (!unused(f)) continue;
+        table_cache_->Evict(f->number);
+        fm_->DeleteFile(io::TableFileName(dbname_, f->number));
+    }
+    obsolete_files_.erase(std::remove_if(obsolete_files_.begin(), obsolete_files_.end(), unused),
+                          obsolete_files_.end());
+}
+
+bool DBImpl::WaitForCompactions() {
+    std::unique_lock<std::mutex> lock(mu_);
+    bg_cv_.wait(lock, [this] {
+        return bg_error_ || (imm_ == nullptr && running_compactions_ == 0 && !picker_->NeedsCompaction(*current_));
+    });
+    return !bg_error_;
+}
+
+// ============================================================================
+// DB::Open
+// ============================================================================
+
+std::unique_ptr<DB> DB::Open(const std::string& path, const Options& options) {
+    auto db = std::make_unique<DBImpl>(path, options);
+    db->Recover();
+    return db;
+}
+
+} // namespace VrootKV::db
@@ -0,0 +1,129 @@
+/**
+ * @file db_impl.h
+ * @author Vrutik Halani
+ * @brief `DB` implementation: WAL + memtable write path, flush to level 0, recovery.
+ *
+ * Locking
+ * -------
+ * `mu_` guards the memtables, the log, the file counters and `current_`.
+ * Writes hold it for the whole log append + memtable insert (one writer at a
+ * time). Reads hold it only to probe the memtables and grab `current_`; the
+ * table part of a lookup runs unlocked against that immutable snapshot.
+ *
+ * The immutable memtable is flushed by one background thread, which builds
+ * the table unlocked and re-acquires `mu_` only to install it. While a flush
+ * is pending, a writer that fills the active memtable waits on `bg_cv_`.
+ *
+ * Compactions run on their own pool of `max_background_compactions`
+ * threads. Scheduling happens under `mu_`: the picker sees `current_` and
+ * the tables claimed by running compactions (`compacting_`), so parallel
+ * compactions never share a table. Each one merges its inputs unlocked and
+ * installs a new `Version` under `mu_`. A large compaction may be split
+ * into key ranges merged by short-lived threads of its own
+ * (`max_subcompactions`); it still installs as one edit.
+ *
+ * Replaced tables are not deleted while any `Version` still lists them (a
+ * read or iterator may be about to open them): they wait in
+ * `obsolete_files_` until that list holds the last reference.
+ *
+ * A failed flush, compaction or log write sets `bg_error_`; every later
+ * write then fails instead of risking a gap in the log.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "compaction.h"
+#include "version.h"
+#include "../common/thread_pool.h"
+#include "../io/block_cache.h"
+#include "../io/row_cache.h"
+#include "../io/table_cache.h"
+#include "../memtable/memtable.h"
+#include "VrootKV/db/db.h"
+
+namespace VrootKV::db {
+
+class DBImpl final : public DB {
+public:
+    DBImpl(const std::string& dbname, const Options& options);
+    ~DBImpl() override;
+
+    DBImpl(const DBImpl&) = delete;
+    DBImpl& operator=(const DBImpl&) = delete;
+
+    /**
+     * @brief Load the MANIFEST, replay logs and start a fresh log.
+     * @throws std::runtime_error on corruption or I/O failure.
+     */
+    void Recover();
+
+    bool Put(std::string_view key, std::string_view value, const WriteOptions& options) override;
+    bool Delete(std::string_view key, const WriteOptions& options) override;
+    bool Write(const WriteBatch& batch, const WriteOptions& options) override;
+    bool Get(std::string_view key, std::string& value, const ReadOptions& options) override;
+    std::unique_ptr<common::Iterator> NewIterator(const ReadOptions& options) override;
+    bool Flush() override;
+    int NumFilesAtLevel(int level) override;
+    uint64_t NumBytesAtLevel(int level) override;
+    bool WaitForCompactions() override;
+
+private:
+    bool MakeRoomForWrite(std::unique_lock<std::mutex>& lock, bool force);
+    void BackgroundFlush();
+    bool WriteLevel0Table(const memtable::MemTable& mem, uint64_t number, FileMetaData* meta);
+    void MaybeScheduleCompactionsLocked();
+    void BackgroundCompaction(std::shared_ptr<Compaction> c);
+    bool DoCompactionWork(const Compaction& c, const Version& base, std::vector<FileMetaPtr>* outputs);
+    std::vector<std::string> SubcompactionBoundariesFor(const Compaction& c);
+    bool DoSubcompaction(const Compaction& c, const Version& base, const std::string* begin,
+                         const std::string* end, std::vector<FileMetaPtr>* outputs);
+    bool InstallCompactionLocked(const Compaction& c, const std::vector<FileMetaPtr>& outputs);
+    void PurgeObsoleteFilesLocked();
+    uint64_t NewFileNumber();
+    void ReplayLog(const std::string& fname, memtable::MemTable* mem);
+    bool GetFromTables(const Version& version, const std::string& key, std::string* tagged,
+                       const io::ReadOptions& read_options);
+    ManifestState StateLocked(std::shared_ptr<const Version> version, uint64_t log_number) const;
+    void DeleteObsoleteLogs(uint64_t begin, uint64_t end);
+
+    const std::string dbname_;
+    const Options options_;
+    std::unique_ptr<io::IFileManager> owned_file_manager_;  ///< Set when none was supplied.
+    io::IFileManager* fm_;
+    std::shared_ptr<io::BlockCache> block_cache_;
+    std::unique_ptr<io::RowCache> row_cache_;
+    std::unique_ptr<io::TableCache> table_cache_;
+
+    std::mutex mu_;
+    std::condition_variable bg_cv_;  ///< Signalled when a flush finishes (or fails).
+    std::shared_ptr<memtable::MemTable> mem_;
+    std::shared_ptr<memtable::MemTable> imm_;  ///< Being flushed; null if none.
+    std::unique_ptr<io::IWritableFile> log_;
+    uint64_t log_number_ = 0;           ///< Log receiving writes to `mem_`.
+    uint64_t manifest_log_number_ = 0;  ///< Oldest log still needed (recorded in MANIFEST).
+    uint64_t next_file_number_ = 1;
+    uint64_t last_sequence_ = 0;
+    std::shared_ptr<const Version> current_;
+    bool bg_error_ = false;
+    std::atomic<bool> shutting_down_{false};  ///< Also polled by running compactions.
+
+    std::unique_ptr<CompactionPicker> picker_;
+    std::set<uint64_t> compacting_;           ///< Tables claimed by running compactions.
+    int running_compactions_ = 0;
+    std::vector<FileMetaPtr> obsolete_files_;  ///< Replaced tables awaiting deletion.
+
+    // Workers; declared last so they are joined before anything they use is destroyed.
+    std::unique_ptr<common::ThreadPool> compaction_pool_;
+    std::unique_ptr<common::ThreadPool> bg_pool_;  ///< Flushes.
+};
+
+} // namespace VrootKV::db
@@ -0,0 +1,80 @@
+/**
+ * @file db_iter.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of the tombstone-skipping user iterator.
+ */
+
+#include "db_iter.h"
+
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include "../memtable/memtable.h"
+
+namespace VrootKV::db {
+
+namespace {
+
+class DBIter final : public common::Iterator {
+public:
+    DBIter(std::unique_ptr<common::Iterator> internal, std::shared_ptr<const void> keep_alive)
+        : keep_alive_(std::move(keep_alive)), internal_(std::move(internal)) {}
+
+    bool Valid() const override { return internal_->Valid(); }
+
+    void SeekToFirst() override {
+        internal_->SeekToFirst();
+        SkipDeletedForward();
+    }
+
+    void SeekToLast() override {
+        internal_->SeekToLast();
+        SkipDeletedBackward();
+    }
+
+    void Seek(std::string_view target) override {
+        internal_->Seek(target);
+        SkipDeletedForward();
+    }
+
+    void Next() override {
+        internal_->Next();
+        SkipDeletedForward();
+    }
+
+    void Prev() override {
+        internal_->Prev();
+        SkipDeletedBackward();
+    }
+
+    std::string_view key() const override { return internal_->key(); }
+    std::string_view value() const override { return internal_->value().substr(1); }
+
+private:
+    bool IsDeletion() const {
+        const std::string_view v = internal_->value();
+        if (v.empty()) throw std::runtime_error("DBIter: untagged value");
+        return v[0] == memtable::MemTable::kTypeDeletion;
+    }
+
+    void SkipDeletedForward() {
+        while (internal_->Valid() && IsDeletion()) internal_->Next();
+    }
+
+    void SkipDeletedBackward() {
+        while (internal_->Valid() && IsDeletion()) internal_->Prev();
+    }
+
+    std::shared_ptr<const void> keep_alive_;  ///< Declared first: outlives `internal_`.
+    std::unique_ptr<common::Iterator> internal_;
+};
+
+} // namespace
+
+std::unique_ptr<common::Iterator> NewDBIterator(std::unique_ptr<common::Iterator> internal,
+                                                std::shared_ptr<const void> keep_alive) {
+    return std::make_unique<DBIter>(std::move(internal), std::move(keep_alive));
+}
+
+} // namespace VrootKV::db
@@ -0,0 +1,27 @@
+/**
+ * @file db_iter.h
+ * @author Vrutik Halani
+ * @brief User-facing iterator: hides tombstones and strips value tags.
+ *
+ * Wraps the merged internal view, whose values are `[tag: u8][user value]`
+ * (see `memtable::MemTable`), and skips keys whose newest entry is a
+ * deletion in either direction.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "VrootKV/common/iterator.h"
+
+namespace VrootKV::db {
+
+/**
+ * @param internal Merged iterator over tagged values.
+ * @param keep_alive State the internal iterator depends on (memtables, table
+ *        list); released with the iterator.
+ */
+std::unique_ptr<common::Iterator> NewDBIterator(std::unique_ptr<common::Iterator> internal,
+                                                std::shared_ptr<const void> keep_alive);
+
+} // namespace VrootKV::db
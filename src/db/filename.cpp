@@ -0,0 +1,46 @@
+/**
+ * @file filename.cpp
+ * @author Vrutik Halani
+ * @brief Database file naming and whole-file reads.
+ */
+
+#include "filename.h"
+
+#include <cstdio>
+#include <memory>
+#include <string_view>
+
+namespace VrootKV::db {
+
+std::string LogFileName(const std::string& dbname, uint64_t number) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "/%06llu.log", static_cast<unsigned long long>(number));
+    return dbname + buf;
+}
+
+std::string ManifestFileName(const std::string& dbname) {
+    return dbname + "/MANIFEST";
+}
+
+std::string TempManifestFileName(const std::string& dbname) {
+    return dbname + "/MANIFEST.tmp";
+}
+
+bool ReadFileToString(io::IFileManager* file_manager, const std::string& fname, std::string* contents) {
+    contents->clear();
+    std::unique_ptr<io::IReadableFile> file;
+    io::FileOptions options;
+    options.access_pattern = io::AccessPattern::kSequential;
+    if (!file_manager->NewReadableFile(fname, file, options)) return false;
+    constexpr size_t kChunk = 64 * 1024;
+    std::string scratch(kChunk, '\0');
+    while (true) {
+        std::string_view chunk;
+        if (!file->Read(kChunk, scratch.data(), &chunk)) return false;
+        if (chunk.empty()) break;
+        contents->append(chunk);
+    }
+    return file->Close();
+}
+
+} // namespace VrootKV::db
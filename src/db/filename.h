@@ -0,0 +1,34 @@
+/**
+ * @file filename.h
+ * @author Vrutik Halani
+ * @brief Names of the files that make up a database directory, and whole-file reads.
+ *
+ *   <dbname>/000007.log     write-ahead log
+ *   <dbname>/000012.sst     table (`io::TableFileName`)
+ *   <dbname>/MANIFEST       live tables and recovery state
+ *   <dbname>/MANIFEST.tmp   manifest being written; renamed over MANIFEST
+ *
+ * Logs and tables draw their numbers from one counter, so a number
+ * identifies a single file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "VrootKV/io/file_manager.h"
+
+namespace VrootKV::db {
+
+std::string LogFileName(const std::string& dbname, uint64_t number);
+std::string ManifestFileName(const std::string& dbname);
+std::string TempManifestFileName(const std::string& dbname);
+
+/**
+ * @brief Read all of `fname` into `contents` (replaced).
+ * @return false if the file cannot be opened or read.
+ */
+bool ReadFileToString(io::IFileManager* file_manager, const std::string& fname, std::string* contents);
+
+} // namespace VrootKV::db
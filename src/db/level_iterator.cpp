@@ -0,0 +1,99 @@
+/**
+ * @file level_iterator.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of the per-level concatenating iterator.
+ */
+
+#include "level_iterator.h"
+
+#include <utility>
+
+namespace VrootKV::db {
+
+namespace {
+
+class LevelIterator final : public common::Iterator {
+public:
+    LevelIterator(std::vector<FileMetaPtr> files, io::TableCache* table_cache, const io::ReadOptions& read_options)
+        : files_(std::move(files)), table_cache_(table_cache), read_options_(read_options) {}
+
+    bool Valid() const override { return table_ != nullptr && table_->Valid(); }
+
+    void SeekToFirst() override {
+        OpenTable(0);
+        if (table_ != nullptr) table_->SeekToFirst();
+        SkipEmptyTablesForward();
+    }
+
+    void SeekToLast() override {
+        OpenTable(files_.size() - 1);
+        if (table_ != nullptr) table_->SeekToLast();
+        SkipEmptyTablesBackward();
+    }
+
+    void Seek(std::string_view target) override {
+        const std::string key(target);
+        OpenTable(static_cast<size_t>(FindFile(files_, key) - files_.begin()));
+        if (table_ != nullptr) table_->Seek(target);
+        SkipEmptyTablesForward();
+    }
+
+    void Next() override {
+        table_->Next();
+        SkipEmptyTablesForward();
+    }
+
+    void Prev() override {
+        table_->Prev();
+        SkipEmptyTablesBackward();
+    }
+
+    std::string_view key() const override { return table_->key(); }
+    std::string_view value() const override { return table_->value(); }
+
+private:
+    /// Make table `index` current; out of range leaves the iterator invalid.
+    void OpenTable(size_t index) {
+        if (index >= files_.size()) {
+            table_.reset();
+            return;
+        }
+        if (table_ == nullptr || index != index_) {
+            table_ = table_cache_->NewIterator(files_[index]->number, read_options_);
+            index_ = index;
+        }
+    }
+
+    void SkipEmptyTablesForward() {
+        while (table_ != nullptr && !table_->Valid()) {
+            OpenTable(index_ + 1);
+            if (table_ != nullptr) table_->SeekToFirst();
+        }
+    }
+
+    void SkipEmptyTablesBackward() {
+        while (table_ != nullptr && !table_->Valid()) {
+            if (index_ == 0) {
+                table_.reset();
+                return;
+            }
+            OpenTable(index_ - 1);
+            table_->SeekToLast();
+        }
+    }
+
+    const std::vector<FileMetaPtr> files_;
+    io::TableCache* table_cache_;
+    const io::ReadOptions read_options_;
+    std::unique_ptr<common::Iterator> table_;  ///< Iterator over `files_[index_]`; null when invalid.
+    size_t index_ = 0;
+};
+
+} // namespace
+
+std::unique_ptr<common::Iterator> NewLevelIterator(std::vector<FileMetaPtr> files, io::TableCache* table_cache,
+                                                   const io::ReadOptions& read_options) {
+    return std::make_unique<LevelIterator>(std::move(files), table_cache, read_options);
+}
+
+} // namespace VrootKV::db
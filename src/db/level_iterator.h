@@ -0,0 +1,31 @@
+/**
+ * @file level_iterator.h
+ * @author Vrutik Halani
+ * @brief Concatenating iterator over the sorted, disjoint tables of one level.
+ *
+ * A level of a large database holds thousands of tables, but a scan is only
+ * ever inside one of them. Instead of merging one child per table, the level
+ * iterator opens the table covering the current position (through the table
+ * cache) and moves to the neighbouring table when it runs off either end, so
+ * a scan pays for one open table per level regardless of level size.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "version.h"
+#include "../io/table_cache.h"
+#include "VrootKV/common/iterator.h"
+
+namespace VrootKV::db {
+
+/**
+ * @param files Tables of a level >= 1, sorted by key with disjoint ranges.
+ * @param table_cache Not owned; must outlive the iterator.
+ */
+std::unique_ptr<common::Iterator> NewLevelIterator(std::vector<FileMetaPtr> files, io::TableCache* table_cache,
+                                                   const io::ReadOptions& read_options);
+
+} // namespace VrootKV::db
@@ -0,0 +1,204 @@
+/**
+ * @file merging_iterator.cpp
+ * @author Vrutik Halani
+ * @brief Loser-tree (tournament) k-way merge with newest-wins deduplication.
+ *
+ * Tree layout
+ * -----------
+ * Children are padded to a power of two `K`. Leaf `K + i` stands for child
+ * `i` (padding leaves are never valid). Each internal node `1 .. K-1` stores
+ * the child that *lost* the match played there, and `tree_[0]` holds the
+ * overall winner. After the winner's child moves, only the matches on its
+ * leaf-to-root path can change, so one replay costs log2(K) comparisons.
+ *
+ * Order: an exhausted child loses to a valid one; otherwise the smaller key
+ * wins moving forward (the larger moving backward), and on equal keys the
+ * lower index (newer child) wins in both directions.
+ *
+ * Same-winner fast path
+ * ---------------------
+ * The losers on the winner's path are the winners of its sibling subtrees,
+ * so the best of them (`runner_up_`) is the only child that can overtake it.
+ * After a replay in which the winner kept winning, that runner-up is worked
+ * out once; from then on, as long as the moved winner still beats it, the
+ * tree is untouched and a step costs a single comparison. This is the
+ * common case when one source holds a long run of consecutive keys (a fresh
+ * table over a sparse key range, or a memtable full of recent appends).
+ *
+ * Each child's validity and key are cached in its slot and refreshed only
+ * when that child moves, so playing a match is a plain key comparison.
+ *
+ * Direction invariant: moving forward, every child other than
+ * the winner is positioned at a key >= the current key (equal keys are
+ * shadowed copies); moving backward, at a key <= it. A change of direction
+ * re-seeks the other children and rebuilds the tree.
+ */
+
+#include "merging_iterator.h"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace VrootKV::db {
+
+namespace {
+
+class MergingIterator final : public common::Iterator {
+public:
+    explicit MergingIterator(std::vector<std::unique_ptr<common::Iterator>> children)
+        : children_(std::move(children)) {
+        while (leaves_ < children_.size()) leaves_ *= 2;
+        tree_.assign(leaves_, kNone);
+        for (const auto& child : children_) slots_.push_back(Slot{child.get(), {}, false});
+    }
+
+    bool Valid() const override { return tree_[0] != kNone && slots_[tree_[0]].valid; }
+
+    void SeekToFirst() override {
+        for (Slot& s : slots_) s.it->SeekToFirst();
+        forward_ = true;
+        Build();
+    }
+
+    void SeekToLast() override {
+        for (Slot& s : slots_) s.it->SeekToLast();
+        forward_ = false;
+        Build();
+    }
+
+    void Seek(std::string_view target) override {
+        for (Slot& s : slots_) s.it->Seek(target);
+        forward_ = true;
+        Build();
+    }
+
+    void Next() override {
+        key_.assign(slots_[tree_[0]].key);
+        if (!forward_) {
+            // Others sit at keys <= key: move each to the first key > key.
+            for (Slot& s : slots_) {
+                s.it->Seek(key_);
+                if (s.it->Valid() && s.it->key() == key_) s.it->Next();
+            }
+            forward_ = true;
+            Build();
+            return;
+        }
+        // Step the winner, then past shadowed copies of key in older children.
+        do {
+            Slot& w = slots_[tree_[0]];
+            w.it->Next();
+            Refresh(w);
+            Advance();
+        } while (Valid() && slots_[tree_[0]].key == key_);
+    }
+
+    void Prev() override {
+        key_.assign(slots_[tree_[0]].key);
+        if (forward_) {
+            // Others sit at keys >= key: move each to the last key < key.
+            for (Slot& s : slots_) {
+                s.it->Seek(key_);
+                if (s.it->Valid()) {
+                    s.it->Prev();
+                } else {
+                    s.it->SeekToLast();
+                }
+            }
+            forward_ = false;
+            Build();
+            return;
+        }
+        do {
+            Slot& w = slots_[tree_[0]];
+            w.it->Prev();
+            Refresh(w);
+            Advance();
+        } while (Valid() && slots_[tree_[0]].key == key_);
+    }
+
+    std::string_view key() const override { return slots_[tree_[0]].key; }
+    std::string_view value() const override { return slots_[tree_[0]].it->value(); }
+
+private:
+    static constexpr size_t kNone = static_cast<size_t>(-1);  ///< Padding leaf: always loses.
+
+    /// A child and its position, cached so matches make no virtual calls.
+    struct Slot {
+        common::Iterator* it;
+        std::string_view key;  ///< Valid until `it` moves.
+        bool valid;
+    };
+
+    static void Refresh(Slot& s) {
+        s.valid = s.it->Valid();
+        if (s.valid) s.key = s.it->key();
+    }
+
+    /// True if child `a` wins its match against child `b` in the current direction.
+    bool Beats(size_t a, size_t b) const {
+        if (a == kNone || !slots_[a].valid) return false;
+        if (b == kNone || !slots_[b].valid) return true;
+        const int c = slots_[a].key.compare(slots_[b].key);
+        if (c != 0) return forward_ ? c < 0 : c > 0;
+        return a < b;
+    }
+
+    /// Play every match from scratch (after a seek or a change of direction).
+    void Build() {
+        runner_up_ = kNone;
+        if (slots_.empty()) return;
+        for (Slot& s : slots_) Refresh(s);
+        // winners_[n] = winner of the subtree under node n; leaves map to children.
+        winners_.assign(2 * leaves_, kNone);
+        for (size_t i = 0; i < slots_.size(); ++i) winners_[leaves_ + i] = i;
+        for (size_t n = leaves_ - 1; n >= 1; --n) {
+            const size_t l = winners_[2 * n], r = winners_[2 * n + 1];
+            const bool right_wins = Beats(r, l);
+            winners_[n] = right_wins ? r : l;
+            tree_[n] = right_wins ? l : r;
+        }
+        tree_[0] = winners_[1];
+    }
+
+    /// Restore the tree after the winner's child moved.
+    void Advance() {
+        const size_t w = tree_[0];
+        if (runner_up_ != kNone) {
+            if (Beats(w, runner_up_)) return;  // fast path: nothing else can win
+            runner_up_ = kNone;
+        }
+        size_t winner = w;
+        for (size_t n = (leaves_ + w) / 2; n >= 1; n /= 2) {
+            if (Beats(tree_[n], winner)) std::swap(tree_[n], winner);
+        }
+        tree_[0] = winner;
+        if (winner == w && leaves_ > 1) {
+            // Same child won again: remember its strongest rival for the fast path.
+            size_t best = kNone;
+            for (size_t n = (leaves_ + w) / 2; n >= 1; n /= 2) {
+                if (best == kNone || Beats(tree_[n], best)) best = tree_[n];
+            }
+            runner_up_ = best;
+        }
+    }
+
+    std::vector<std::unique_ptr<common::Iterator>> children_;
+    std::vector<Slot> slots_;             ///< One per child, same order.
+    size_t leaves_ = 1;                   ///< Children rounded up to a power of two.
+    std::vector<size_t> tree_;            ///< [0]: winner; [1, leaves_): match losers.
+    size_t runner_up_ = kNone;            ///< Best rival of an unchanged winner, if known.
+    std::vector<size_t> winners_;         ///< Scratch for `Build()`.
+    std::string key_;                     ///< Key being stepped past (reused buffer).
+    bool forward_ = true;
+};
+
+} // namespace
+
+std::unique_ptr<common::Iterator> NewMergingIterator(std::vector<std::unique_ptr<common::Iterator>> children) {
+    return std::make_unique<MergingIterator>(std::move(children));
+}
+
+} // namespace VrootKV::db
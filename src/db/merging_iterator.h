@@ -0,0 +1,29 @@
+/**
+ * @file merging_iterator.h
+ * @author Vrutik Halani
+ * @brief Merge of several sorted iterators into one sorted view.
+ *
+ * Children are given newest first. When several children hold the same key,
+ * the merged iterator yields it once, with the value from the newest child,
+ * and skips the shadowed copies in both directions. Values (including
+ * tombstone tags) are passed through untouched; `NewDBIterator()` interprets
+ * them.
+ *
+ * Children are kept in a loser tree: a step costs about log2(k) key
+ * comparisons, and a single one while the same child keeps supplying the
+ * smallest key. Memtables take part through `MemTable::NewIterator()`,
+ * tables through table or level iterators.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "VrootKV/common/iterator.h"
+
+namespace VrootKV::db {
+
+std::unique_ptr<common::Iterator> NewMergingIterator(std::vector<std::unique_ptr<common::Iterator>> children);
+
+} // namespace VrootKV::db
@@ -0,0 +1,162 @@
+/**
+ * @file version.cpp
+ * @author Vrutik Halani
+ * @brief MANIFEST encoding and atomic replacement.
+ */
+
+#include "version.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "filename.h"
+#include "../wal/wal_format.h"
+
+namespace VrootKV::db {
+
+namespace {
+
+constexpr uint32_t kManifestMagic = 0x4d564b56;  // "VKVM"
+
+void PutLengthPrefixed(std::string& dst, const std::string& s) {
+    wal::detail::PutVarint32(dst, static_cast<uint32_t>(s.size()));
+    dst.append(s);
+}
+
+uint64_t GetFixed64(std::string_view& in) {
+    if (in.size() < 8) throw std::runtime_error("MANIFEST: truncated");
+    const uint64_t v = wal::detail::DecodeFixed64(in.data());
+    in.remove_prefix(8);
+    return v;
+}
+
+uint32_t GetFixed32(std::string_view& in) {
+    if (in.size() < 4) throw std::runtime_error("MANIFEST: truncated");
+    const uint32_t v = wal::detail::DecodeFixed32(in.data());
+    in.remove_prefix(4);
+    return v;
+}
+
+std::string GetLengthPrefixed(std::string_view& in) {
+    uint32_t len = 0;
+    if (!wal::detail::GetVarint32(in, len) || in.size() < len) {
+        throw std::runtime_error("MANIFEST: bad key");
+    }
+    std::string s(in.substr(0, len));
+    in.remove_prefix(len);
+    return s;
+}
+
+} // namespace
+
+std::vector<FileMetaPtr>::const_iterator FindFile(const std::vector<FileMetaPtr>& files, const std::string& key) {
+    return std::lower_bound(files.begin(), files.end(), key,
+                            [](const FileMetaPtr& f, const std::string& k) { return f->largest < k; });
+}
+
+uint64_t Version::LevelBytes(int level) const {
+    uint64_t total = 0;
+    for (const FileMetaPtr& f : files[level]) total += f->file_size;
+    return total;
+}
+
+std::vector<FileMetaPtr> Version::Overlapping(int level, const std::string& smallest,
+                                              const std::string& largest) const {
+    std::vector<FileMetaPtr> out;
+    for (const FileMetaPtr& f : files[level]) {
+        if (f->largest < smallest || f->smallest > largest) continue;
+        out.push_back(f);
+    }
+    return out;
+}
+
+bool Version::KeyMayExistBelow(int level, const std::string& key) const {
+    for (int l = level + 1; l < kNumLevels; ++l) {
+        if (l == 0) {
+            for (const FileMetaPtr& f : files[0]) {
+                if (key >= f->smallest && key <= f->largest) return true;
+            }
+            continue;
+        }
+        auto it = FindFile(files[l], key);
+        if (it != files[l].end() && key >= (*it)->smallest) return true;
+    }
+    return false;
+}
+
+std::string EncodeManifest(const ManifestState& state) {
+    std::string body;
+    wal::detail::PutFixed64(body, state.next_file_number);
+    wal::detail::PutFixed64(body, state.log_number);
+    wal::detail::PutFixed64(body, state.last_sequence);
+    uint32_t num_files = 0;
+    for (const auto& level : state.version.files) num_files += static_cast<uint32_t>(level.size());
+    wal::detail::PutFixed32(body, num_files);
+    for (int level = 0; level < kNumLevels; ++level) {
+        for (const FileMetaPtr& f : state.version.files[level]) {
+            wal::detail::PutFixed32(body, static_cast<uint32_t>(level));
+            wal::detail::PutFixed64(body, f->number);
+            wal::detail::PutFixed64(body, f->file_size);
+            PutLengthPrefixed(body, f->smallest);
+            PutLengthPrefixed(body, f->largest);
+        }
+    }
+
+    std::string out;
+    out.reserve(8 + body.size());
+    wal::detail::PutFixed32(out, kManifestMagic);
+    wal::detail::PutFixed32(out, wal::detail::Crc32(reinterpret_cast<const uint8_t*>(body.data()), body.size()));
+    out.append(body);
+    return out;
+}
+
+ManifestState DecodeManifest(std::string_view in) {
+    if (GetFixed32(in) != kManifestMagic) throw std::runtime_error("MANIFEST: bad magic");
+    const uint32_t crc = GetFixed32(in);
+    if (wal::detail::Crc32(reinterpret_cast<const uint8_t*>(in.data()), in.size()) != crc) {
+        throw std::runtime_error("MANIFEST: checksum mismatch");
+    }
+
+    ManifestState state;
+    state.next_file_number = GetFixed64(in);
+    state.log_number = GetFixed64(in);
+    state.last_sequence = GetFixed64(in);
+    const uint32_t num_files = GetFixed32(in);
+    for (uint32_t i = 0; i < num_files; ++i) {
+        const uint32_t level = GetFixed32(in);
+        if (level >= static_cast<uint32_t>(kNumLevels)) throw std::runtime_error("MANIFEST: bad level");
+        auto f = std::make_shared<FileMetaData>();
+        f->number = GetFixed64(in);
+        f->file_size = GetFixed64(in);
+        f->smallest = GetLengthPrefixed(in);
+        f->largest = GetLengthPrefixed(in);
+        state.version.files[level].push_back(std::move(f));
+    }
+    if (!in.empty()) throw std::runtime_error("MANIFEST: trailing bytes");
+    return state;
+}
+
+bool WriteManifest(io::IFileManager* file_manager, const std::string& dbname, const ManifestState& state) {
+    const std::string tmp = TempManifestFileName(dbname);
+    std::unique_ptr<io::IWritableFile> file;
+    if (!file_manager->NewWritableFile(tmp, file)) return false;
+    const bool ok = file->Write(EncodeManifest(state)) && file->Sync() && file->Close();
+    if (!ok) {
+        file_manager->DeleteFile(tmp);
+        return false;
+    }
+    return file_manager->RenameFile(tmp, ManifestFileName(dbname));
+}
+
+bool ReadManifest(io::IFileManager* file_manager, const std::string& dbname, ManifestState* state) {
+    const std::string fname = ManifestFileName(dbname);
+    if (!file_manager->FileExists(fname)) return false;
+    std::string contents;
+    if (!ReadFileToString(file_manager, fname, &contents)) {
+        throw std::runtime_error("MANIFEST: cannot read " + fname);
+    }
+    *state = DecodeManifest(contents);
+    return true;
+}
+
+} // namespace VrootKV::db
@@ -0,0 +1,109 @@
+/**
+ * @file version.h
+ * @author Vrutik Halani
+ * @brief The set of live tables per level, and its persistent form (the MANIFEST).
+ *
+ * Versions
+ * --------
+ * A `Version` is an immutable snapshot of which tables make up the database.
+ * The DB swaps in a new one (copy, modify, publish a `shared_ptr`) whenever a
+ * flush or compaction installs tables, so readers holding the old snapshot
+ * keep a consistent view without locking.
+ *
+ *  - Level 0 holds flushed memtables, newest first; their key ranges overlap.
+ *  - Levels >= 1 hold tables sorted by key with disjoint ranges.
+ *
+ * MANIFEST
+ * --------
+ * The whole state is rewritten on every change (it is small: one line per
+ * table) to `MANIFEST.tmp`, synced and renamed over `MANIFEST`, so the file
+ * is always either the old or the new state. Layout (little-endian):
+ *
+ *   [magic: u32][crc32 of body: u32][body]
+ *   body = [next_file_number: u64][log_number: u64][last_sequence: u64]
+ *          [num_files: u32] num_files × file
+ *   file = [level: u32][number: u64][file_size: u64]
+ *          [smallest_len: varint32][smallest][largest_len: varint32][largest]
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "VrootKV/io/file_manager.h"
+
+namespace VrootKV::db {
+
+/// Number of LSM levels.
+constexpr int kNumLevels = 7;
+
+/// One live table.
+struct FileMetaData {
+    uint64_t number = 0;     ///< Table file number (`io::TableFileName`).
+    uint64_t file_size = 0;
+    std::string smallest;    ///< Smallest key in the table.
+    std::string largest;     ///< Largest key in the table.
+};
+
+using FileMetaPtr = std::shared_ptr<const FileMetaData>;
+
+/**
+ * @brief First table in a sorted, disjoint level whose largest key is >= `key`
+ *        (the only one that can contain it), or `files.end()`.
+ */
+std::vector<FileMetaPtr>::const_iterator FindFile(const std::vector<FileMetaPtr>& files, const std::string& key);
+
+/**
+ * @struct Version
+ * @brief Immutable list of tables per level (see file comment for ordering).
+ */
+struct Version {
+    std::vector<FileMetaPtr> files[kNumLevels];
+
+    /// Sum of `file_size` at `level`.
+    uint64_t LevelBytes(int level) const;
+
+    /// Tables at `level` whose key range intersects [smallest, largest], in level order.
+    std::vector<FileMetaPtr> Overlapping(int level, const std::string& smallest,
+                                         const std::string& largest) const;
+
+    /// True if some table below `level` (at a deeper level) may contain `key`.
+    bool KeyMayExistBelow(int level, const std::string& key) const;
+};
+
+/**
+ * @struct ManifestState
+ * @brief Everything recovery needs besides the logs themselves.
+ */
+struct ManifestState {
+    uint64_t next_file_number = 1;  ///< Next number to hand out for a log or table.
+    uint64_t log_number = 0;        ///< Oldest log whose contents are not yet in a table.
+    uint64_t last_sequence = 0;     ///< Last transaction id written to a log.
+    Version version;
+};
+
+std::string EncodeManifest(const ManifestState& state);
+
+/**
+ * @throws std::runtime_error on a bad magic, checksum or encoding.
+ */
+ManifestState DecodeManifest(std::string_view contents);
+
+/**
+ * @brief Atomically replace `<dbname>/MANIFEST` with `state`.
+ * @return false on I/O failure (the previous MANIFEST is left intact).
+ */
+bool WriteManifest(io::IFileManager* file_manager, const std::string& dbname, const ManifestState& state);
+
+/**
+ * @brief Load `<dbname>/MANIFEST`.
+ * @return false if there is no MANIFEST.
+ * @throws std::runtime_error if it exists but cannot be read or decoded.
+ */
+bool ReadManifest(io::IFileManager* file_manager, const std::string& dbname, ManifestState* state);
+
+} // namespace VrootKV::db
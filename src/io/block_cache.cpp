@@ -0,0 +1,89 @@
+/**
+ * @file block_cache.cpp
+ * @author Vrutik Halani
+ * @brief `BlockCache`: dispatch to the LRU or CLOCK sharded cache.
+ */
+
+#include "block_cache.h"
+
+#include "secondary_cache.h"
+
+namespace VrootKV::io {
+
+BlockCache::BlockCache(const BlockCacheOptions& options) : options_(options) {
+    if (options.policy == CacheEvictionPolicy::kClock) {
+        clock_ = std::make_unique<common::ShardedClockCache<BlockCacheKey, Block, BlockCacheKeyHash>>(
+            options.capacity, options.num_shard_bits);
+    } else {
+        lru_ = std::make_unique<common::ShardedLRUCache<BlockCacheKey, Block, BlockCacheKeyHash>>(
+            options.capacity, options.num_shard_bits);
+    }
+    if (options.tinylfu_admission) {
+        // Sized for the block count the capacity holds at the default block size.
+        sketch_ = std::make_unique<common::FrequencySketch>(options.capacity / 4096);
+        common::FrequencySketch* sketch = sketch_.get();
+        auto admit = [sketch](const BlockCacheKey& candidate, const BlockCacheKey& victim) {
+            return sketch->Estimate(BlockCacheKeyHash()(candidate)) > sketch->Estimate(BlockCacheKeyHash()(victim));
+        };
+        if (clock_) {
+            clock_->SetAdmissionPolicy(admit);
+        } else {
+            lru_->SetAdmissionPolicy(admit);
+        }
+    }
+    if (options.secondary_cache) {
+        CompressedSecondaryCache* secondary = options.secondary_cache.get();
+        auto demote = [secondary](const BlockCacheKey& key, std::shared_ptr<Block> block) {
+            secondary->Insert(key, *block);
+        };
+        if (clock_) {
+            clock_->SetEvictionCallback(demote);
+        } else {
+            lru_->SetEvictionCallback(demote);
+        }
+    }
+}
+
+CachedBlock BlockCache::Lookup(const BlockCacheKey& key, CachePriority priority) {
+    if (sketch_ && priority == CachePriority::kHigh) sketch_->Increment(BlockCacheKeyHash()(key));
+    CachedBlock block = clock_ ? clock_->Lookup(key, priority) : lru_->Lookup(key, priority);
+    if (block != nullptr || !options_.secondary_cache) return block;
+    std::string contents;
+    if (!options_.secondary_cache->Lookup(key, &contents)) return nullptr;
+    secondary_hits_.fetch_add(1, std::memory_order_relaxed);
+    // The secondary tier gave up its copy; if admission refuses the
+    // promotion, demote it again rather than lose the block from both tiers.
+    const std::size_t charge = contents.size();
+    auto promoted = std::make_shared<const std::string>(std::move(contents));
+    bool admitted = true;
+    CachedBlock result = clock_ ? clock_->Insert(key, promoted, charge, priority, &admitted)
+                                : lru_->Insert(key, promoted, charge, priority, &admitted);
+    if (!admitted) options_.secondary_cache->Insert(key, *promoted);
+    return result;
+}
+
+CachedBlock BlockCache::Insert(const BlockCacheKey& key, std::string contents, CachePriority priority) {
+    const std::size_t charge = contents.size();
+    auto block = std::make_shared<const std::string>(std::move(contents));
+    return clock_ ? clock_->Insert(key, std::move(block), charge, priority)
+                  : lru_->Insert(key, std::move(block), charge, priority);
+}
+
+void BlockCache::Erase(const BlockCacheKey& key) {
+    if (clock_) {
+        clock_->Erase(key);
+    } else {
+        lru_->Erase(key);
+    }
+    if (options_.secondary_cache) options_.secondary_cache->Erase(key);
+}
+
+std::size_t BlockCache::GetUsage() const {
+    return clock_ ? clock_->TotalCharge() : lru_->TotalCharge();
+}
+
+common::CacheStats BlockCache::GetStats() const {
+    return clock_ ? clock_->GetStats() : lru_->GetStats();
+}
+
+} // namespace VrootKV::io
@@ -0,0 +1,143 @@
+/**
+ * @file block_cache.h
+ * @author Vrutik Halani
+ * @brief Process-wide cache of uncompressed SSTable data blocks.
+ *
+ * Without it every point read fetches its data block from the file (a pread
+ * and a copy, even when the page cache is warm). `BlockCache` keeps recently
+ * used blocks in memory under a byte budget, keyed by (cache id of the table,
+ * block offset).
+ *
+ * Design
+ * ------
+ *  - Sharded by key hash (`num_shard_bits`), each shard with its own lock.
+ *  - Eviction policy per cache: exact LRU, or CLOCK whose hits take the shard
+ *    lock shared so hot blocks can be read by many threads at once.
+ *  - Values are `std::shared_ptr<const std::string>`: a reader pins a block
+ *    by holding the pointer, so eviction never frees a block in use.
+ *  - Each `TableReader` gets a cache id (`NewId()`, or one derived from the
+ *    table file number by `TableCache`), so blocks of different tables and
+ *    of different databases sharing one cache never collide.
+ *
+ * The charge of a block is its size in bytes. Pinned blocks that have been
+ * evicted no longer count against the capacity.
+ *
+ * Scan resistance
+ * ---------------
+ *  - `tinylfu_admission`: accesses feed a `common::FrequencySketch`; an insert
+ *    that would evict is admitted only if the new block was requested more
+ *    often (recently) than the victim. A one-pass scan then cannot flush the
+ *    hot blocks.
+ *  - `CachePriority::kLow` accesses (scans that opt in through
+ *    `ReadOptions`) are not counted by the sketch, do not refresh recency,
+ *    and insert blocks as the next eviction victims.
+ *
+ * With `secondary_cache` set, blocks evicted for capacity are demoted to that
+ * compressed tier and a primary miss that hits there is promoted back (see
+ * secondary_cache.h).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "../common/frequency_sketch.h"
+#include "../common/sharded_cache.h"
+
+namespace VrootKV::io {
+
+class CompressedSecondaryCache;
+
+using common::CachePriority;
+
+enum class CacheEvictionPolicy {
+    kLRU,    ///< Exact recency order; every hit takes the shard mutex.
+    kClock,  ///< Second-chance approximation; hits only set a reference bit.
+};
+
+struct BlockCacheOptions {
+    /// Byte budget for cached blocks.
+    std::size_t capacity = 8 << 20;
+    /// log2 of the number of shards.
+    int num_shard_bits = 6;
+    CacheEvictionPolicy policy = CacheEvictionPolicy::kLRU;
+    /// Admit a block over its eviction victim only if it is more popular.
+    bool tinylfu_admission = false;
+    /// Optional compressed tier for evicted blocks; may be shared between caches.
+    std::shared_ptr<CompressedSecondaryCache> secondary_cache;
+};
+
+/// Identity of one cached block.
+struct BlockCacheKey {
+    uint64_t cache_id = 0;  ///< Which table (see `BlockCache::NewId()`).
+    uint64_t offset = 0;    ///< Block offset within the table file.
+
+    bool operator==(const BlockCacheKey& other) const {
+        return cache_id == other.cache_id && offset == other.offset;
+    }
+};
+
+struct BlockCacheKeyHash {
+    std::size_t operator()(const BlockCacheKey& key) const {
+        return static_cast<std::size_t>(key.cache_id * 0xff51afd7ed558ccdull ^ key.offset);
+    }
+};
+
+/// A cached block; holding it keeps the bytes alive.
+using CachedBlock = std::shared_ptr<const std::string>;
+
+/**
+ * @class BlockCache
+ * @brief Thread-safe, sharded block cache. Share one instance between tables.
+ */
+class BlockCache {
+public:
+    explicit BlockCache(const BlockCacheOptions& options = BlockCacheOptions());
+
+    BlockCache(const BlockCache&) = delete;
+    BlockCache& operator=(const BlockCache&) = delete;
+
+    /// Pinned block for `key` (promoted from the secondary tier if needed), or null on a miss.
+    CachedBlock Lookup(const BlockCacheKey& key, CachePriority priority = CachePriority::kHigh);
+
+    /**
+     * @brief Cache `contents` under `key`.
+     * @return The pinned block: the cached one (another thread's copy if it
+     *         won the race), or an uncached copy if admission rejected it.
+     */
+    CachedBlock Insert(const BlockCacheKey& key, std::string contents,
+                       CachePriority priority = CachePriority::kHigh);
+
+    /// Drop one block (from both tiers).
+    void Erase(const BlockCacheKey& key);
+
+    /// Fresh id for a table that has no stable identity of its own. Never 0.
+    uint64_t NewId() { return next_id_.fetch_add(1, std::memory_order_relaxed); }
+
+    /// Bytes currently charged to the cache.
+    std::size_t GetUsage() const;
+    std::size_t GetCapacity() const { return options_.capacity; }
+    CacheEvictionPolicy policy() const { return options_.policy; }
+
+    /// Hits, misses, inserts, evictions and admission rejects of the primary tier.
+    common::CacheStats GetStats() const;
+
+    /// Primary misses served by the secondary tier.
+    uint64_t secondary_hits() const { return secondary_hits_.load(std::memory_order_relaxed); }
+
+private:
+    using Block = const std::string;
+
+    const BlockCacheOptions options_;
+    std::unique_ptr<common::FrequencySketch> sketch_;  ///< Null unless `tinylfu_admission`.
+    std::unique_ptr<common::ShardedLRUCache<BlockCacheKey, Block, BlockCacheKeyHash>> lru_;
+    std::unique_ptr<common::ShardedClockCache<BlockCacheKey, Block, BlockCacheKeyHash>> clock_;
+    std::atomic<uint64_t> next_id_{1};
+    std::atomic<uint64_t> secondary_hits_{0};
+};
+
+} // namespace VrootKV::io
@@ -9,42 +9,80 @@
  * the platform-specific readable/writable file primitives used by the storage engine.
  * It aims to be:
  *   - **Portable:** Uses Win32 APIs on Windows and POSIX syscalls on Unix-like systems.
- *   - **Simple & Safe:** Minimal buffering; durable writes via `Sync()`.
+ *   - **Simple & Safe:** One user-space append buffer; durable writes via `Sync()`.
  *   - **Correct:** Handles partial writes and EINTR where applicable.
  *
  * Responsibilities
  * ----------------
  * - `IWritableFile`:
- *      * `Write()`  — append bytes to the file (handles partial writes/short writes).
- *      * `Flush()`  — flush user-space buffers (no-op here since we don't buffer).
- *      * `Sync()`   — request durable persistence (`FlushFileBuffers` / `fsync`).
- *      * `Close()`  — close the handle/file descriptor.
+ *      * `Write()`  — append bytes; small appends are coalesced in a buffer of
+ *                     `FileOptions::write_buffer_size` bytes.
+ *      * `Flush()`  — hand the buffered bytes to the OS (handles short writes).
+ *      * `Sync()`   — flush, then request durable persistence (`FlushFileBuffers` / `fsync`).
+ *      * With `FileOptions::bytes_per_sync`, write-back is started every N bytes
+ *        (`sync_file_range` on Linux) so the final `Sync()` has little left to do.
+ *      * `Close()`  — flush, then close the handle/file descriptor.
  *
  * - `IReadableFile`:
- *      * `Read(n, out)` — read up to `n` bytes, returning the number of bytes read.
+ *      * `Read(n, scratch, out)` — read up to `n` bytes straight into `scratch`
+ *        (no intermediate allocation); small reads are served from a readahead
+ *        buffer of `FileOptions::readahead_size` bytes. The kernel is told the
+ *        file is sequential (`posix_fadvise` / `FILE_FLAG_SEQUENTIAL_SCAN`).
  *      * `Close()`      — close the underlying handle/file descriptor.
  *
+ * - `IRandomAccessFile`:
+ *      * `Read(off, n, scratch, out)` — positional read (`pread` / overlapped
+ *        `ReadFile`); does not touch a shared file position, so it is thread-safe.
+ *      * `Size()`  — file size captured at open time.
+ *      * `Close()` — close the underlying handle/file descriptor.
+ *      With `FileOptions::use_mmap_reads` the file is mapped read-only instead
+ *      and reads return views into the mapping (no copy); `Close()` unmaps it.
+ *      `FileOptions::access_pattern` becomes `madvise(MADV_RANDOM/SEQUENTIAL)`
+ *      for mappings and `posix_fadvise` for pread files on POSIX, and
+ *      `FILE_FLAG_RANDOM_ACCESS/SEQUENTIAL_SCAN` on Windows.
+ *
+ * - Direct I/O (`FileOptions::use_direct_io`, POSIX only):
+ *      Random-access and writable files opened with O_DIRECT (F_NOCACHE on
+ *      macOS) so compaction traffic does not evict the page cache that
+ *      foreground reads rely on. Reads widen to 4 KiB alignment through pooled
+ *      bounce buffers; writes go out in aligned chunks and an unaligned tail is
+ *      padded, written, and truncated back to the logical size on `Flush()`.
+ *
+ * - Rate limiting (`FileOptions::rate_limiter`):
+ *      Writable files charge every write that reaches the OS (after buffering)
+ *      at `io_priority`; with `rate_limit_reads`, readable and random-access
+ *      files are wrapped in decorators that charge each read.
+ *
  * - `IFileManager`:
- *      * `NewWritableFile(name, out)` — create/truncate a writable file.
- *      * `NewReadableFile(name, out)` — open a file for reading.
+ *      * `NewWritableFile(name, out, opts)` — create/truncate a writable file.
+ *      * `NewReadableFile(name, out, opts)` — open a file for reading.
+ *      * `NewRandomAccessFile(name, out, opts)` — open a file for positional reads.
  *      * `FileExists(name)`           — path existence check.
  *      * `DeleteFile(name)`           — unlink/remove a file.
  *      * `RenameFile(src, dst)`       — atomic rename where supported.
+ *      * `CreateDir(name)`            — mkdir -p.
  *
  * Notes
  * -----
- * - `Flush()` is intentionally a no-op since we don't keep user-space buffers; all
- *   writes go straight to the OS. Use `Sync()` to ensure data reaches the device.
- * - This implementation is not thread-safe by itself; synchronize access externally
- *   if multiple threads share the same file object.
+ * - Buffered bytes are invisible to other readers of the path until `Flush()`,
+ *   `Sync()` or `Close()`. Use `Sync()` to ensure data reaches the device.
+ * - Writable and sequential readable files are not thread-safe by themselves;
+ *   synchronize access externally if multiple threads share the same object.
+ *   Random-access files may be read concurrently.
  */
 
 #include "VrootKV/io/file_manager.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
+#include <mutex>
+#include <new>
 #include <vector>
 #include <string>
 #include <memory>
+#include <utility>
 
 // Platform-specific includes for low-level file I/O.
 #ifdef _WIN32
@@ -52,12 +90,264 @@
 #else
 #include <cerrno>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #endif
 
 namespace VrootKV::io {
 namespace { // Anonymous namespace for internal helpers and concrete classes.
 
+// ============================================================================
+// Shared write buffering
+// ============================================================================
+
+/**
+ * @brief `IWritableFile` that coalesces small appends in a user-space buffer.
+ *
+ * Platform classes implement only the raw primitives; this class decides
+ * when bytes actually reach the OS:
+ *  - `Write()` appends to the buffer; when it would overflow, the buffer is
+ *    written out first. Appends at least as large as the buffer bypass it.
+ *  - `Flush()` writes the buffer to the OS (one syscall for many appends).
+ *  - `Sync()`  flushes, then asks the device to persist.
+ *  - `Close()` flushes, then closes; a failed flush is reported.
+ * A failed write to the OS is sticky: a short write may have left part of
+ * the buffer in the file, so neither retrying nor dropping it is safe, and
+ * every later `Write()`, `Flush()`, `Sync()` and `Close()` returns false.
+ * A capacity of 0 disables buffering (every `Write()` is one write syscall).
+ *
+ * With `bytes_per_sync > 0`, every time that many bytes have reached the OS
+ * since the last sync, the new range is handed to `RangeSync()` so dirty
+ * pages drain in the background instead of all at once on the final `Sync()`.
+ *
+ * With a `rate_limiter`, every write to the OS is first charged to it at
+ * `io_priority` (after coalescing, so the limiter sees few large requests).
+ */
+class BufferedWritableFile : public IWritableFile {
+public:
+    explicit BufferedWritableFile(const FileOptions& options)
+        : capacity_(options.write_buffer_size),
+          bytes_per_sync_(options.bytes_per_sync),
+          rate_limiter_(options.rate_limiter),
+          io_priority_(options.io_priority) {
+        buf_.reserve(capacity_);
+    }
+
+    bool Write(std::string_view data) override {
+        if (!IsOpen() || failed_) return false;
+        if (buf_.size() + data.size() <= capacity_) {
+            buf_.append(data.data(), data.size());
+            return true;
+        }
+        if (!Flush()) return false;
+        if (data.size() < capacity_) {
+            buf_.append(data.data(), data.size());
+            return true;
+        }
+        return WriteOut(data.data(), data.size());
+    }
+
+    bool Flush() override {
+        if (!IsOpen() || failed_) return false;
+        if (buf_.empty()) return true;
+        const bool ok = WriteOut(buf_.data(), buf_.size());
+        buf_.clear();
+        return ok;
+    }
+
+    bool Sync() override {
+        if (!Flush() || !SyncRaw()) return false;
+        synced_ = written_;
+        return true;
+    }
+
+    bool Close() override {
+        if (!IsOpen()) return true;
+        const bool flushed = Flush();
+        return CloseRaw() && flushed;
+    }
+
+protected:
+    /// True while the underlying handle is open.
+    virtual bool IsOpen() const = 0;
+    /// Write all `n` bytes (looping over short writes); false on error.
+    virtual bool WriteRaw(const char* p, size_t n) = 0;
+    /// Persist OS buffers to the device.
+    virtual bool SyncRaw() = 0;
+    /// Close the handle; must leave `IsOpen()` false.
+    virtual bool CloseRaw() = 0;
+    /// Start write-back of [offset, offset + n); the default does nothing.
+    virtual bool RangeSync(uint64_t /*offset*/, uint64_t /*n*/) { return true; }
+
+private:
+    /**
+     * @brief Rate limiting, `WriteRaw()`, then incremental syncing every `bytes_per_sync_` bytes.
+     */
+    bool WriteOut(const char* p, size_t n) {
+        if (rate_limiter_ != nullptr) {
+            rate_limiter_->Request(static_cast<int64_t>(n), io_priority_);
+        }
+        if (!WriteRaw(p, n)) {
+            failed_ = true;
+            return false;
+        }
+        written_ += n;
+        if (bytes_per_sync_ > 0 && written_ - synced_ >= bytes_per_sync_) {
+            if (!RangeSync(synced_, written_ - synced_)) {
+                failed_ = true;
+                return false;
+            }
+            synced_ = written_;
+        }
+        return true;
+    }
+
+    size_t capacity_;
+    uint64_t bytes_per_sync_;
+    RateLimiter* rate_limiter_;
+    IOPriority io_priority_;
+    uint64_t written_ = 0;  ///< Bytes handed to the OS so far (= file offset).
+    uint64_t synced_ = 0;   ///< Prefix already passed to RangeSync()/SyncRaw().
+    bool failed_ = false;   ///< A write to the OS failed; the file has a gap.
+    std::string buf_;
+};
+
+// ============================================================================
+// Shared sequential readahead
+// ============================================================================
+
+/**
+ * @brief `IReadableFile` with an optional user-space readahead buffer.
+ *
+ * Platform classes implement only the raw primitives. `Read(n, scratch, out)`
+ * fills `scratch` directly, looping until `n` bytes or EOF:
+ *  - bytes left in the readahead buffer are served first;
+ *  - requests at least `readahead_size` large go straight to the OS;
+ *  - smaller ones refill the buffer with one `readahead_size` read.
+ * A readahead size of 0 sends every request to the OS.
+ */
+class BufferedReadableFile : public IReadableFile {
+public:
+    explicit BufferedReadableFile(size_t readahead_size) : readahead_(readahead_size) {}
+
+    bool Read(size_t n, char* scratch, std::string_view* result) override {
+        if (!IsOpen() || !result) return false;
+
+        size_t copied = std::min(n, buf_.size() - pos_);
+        std::memcpy(scratch, buf_.data() + pos_, copied);
+        pos_ += copied;
+
+        if (copied < n) {
+            const size_t want = n - copied;
+            size_t got = 0;
+            if (want >= readahead_) {
+                if (!ReadFully(scratch + copied, want, &got)) return false;
+                copied += got;
+            } else {
+                buf_.resize(readahead_);
+                if (!ReadFully(buf_.data(), readahead_, &got)) {
+                    buf_.clear();
+                    pos_ = 0;
+                    return false;
+                }
+                buf_.resize(got);
+                pos_ = std::min(want, got);
+                std::memcpy(scratch + copied, buf_.data(), pos_);
+                copied += pos_;
+            }
+        }
+        *result = std::string_view(scratch, copied);
+        return true;
+    }
+
+    bool Close() override {
+        buf_.clear();
+        pos_ = 0;
+        if (!IsOpen()) return true;
+        return CloseRaw();
+    }
+
+protected:
+    /// True while the underlying handle is open.
+    virtual bool IsOpen() const = 0;
+    /// One read syscall of up to `n` bytes into `p`; `*got` = 0 at EOF. False on error.
+    virtual bool ReadRaw(char* p, size_t n, size_t* got) = 0;
+    /// Close the handle; must leave `IsOpen()` false.
+    virtual bool CloseRaw() = 0;
+
+private:
+    /**
+     * @brief Loop `ReadRaw()` until `n` bytes or EOF.
+     */
+    bool ReadFully(char* p, size_t n, size_t* total) {
+        *total = 0;
+        while (*total < n) {
+            size_t got = 0;
+            if (!ReadRaw(p + *total, n - *total, &got)) return false;
+            if (got == 0) break; // EOF
+            *total += got;
+        }
+        return true;
+    }
+
+    size_t readahead_;
+    std::string buf_;  ///< Readahead bytes; [pos_, size()) not yet returned.
+    size_t pos_ = 0;
+};
+
+// ============================================================================
+// Rate-limited reads (decorators)
+// ============================================================================
+
+/**
+ * @brief Charges every read of the wrapped sequential file to a `RateLimiter`.
+ */
+class RateLimitedReadableFile final : public IReadableFile {
+public:
+    RateLimitedReadableFile(std::unique_ptr<IReadableFile> base, RateLimiter* limiter, IOPriority priority)
+        : base_(std::move(base)), limiter_(limiter), priority_(priority) {}
+
+    bool Read(size_t n, char* scratch, std::string_view* result) override {
+        limiter_->Request(static_cast<int64_t>(n), priority_);
+        return base_->Read(n, scratch, result);
+    }
+
+    bool Close() override { return base_->Close(); }
+
+private:
+    std::unique_ptr<IReadableFile> base_;
+    RateLimiter* limiter_;
+    IOPriority priority_;
+};
+
+/**
+ * @brief Charges every read of the wrapped random-access file to a `RateLimiter`.
+ *
+ * No descriptor is exposed, so async engines read it inline (and charged)
+ * instead of bypassing the limiter through the kernel.
+ */
+class RateLimitedRandomAccessFile final : public IRandomAccessFile {
+public:
+    RateLimitedRandomAccessFile(std::unique_ptr<IRandomAccessFile> base, RateLimiter* limiter,
+                                IOPriority priority)
+        : base_(std::move(base)), limiter_(limiter), priority_(priority) {}
+
+    bool Read(uint64_t offset, size_t n, char* scratch, std::string_view* result) const override {
+        limiter_->Request(static_cast<int64_t>(n), priority_);
+        return base_->Read(offset, n, scratch, result);
+    }
+
+    uint64_t Size() const override { return base_->Size(); }
+    bool ReadsInPlace() const override { return base_->ReadsInPlace(); }
+    bool Close() override { return base_->Close(); }
+
+private:
+    std::unique_ptr<IRandomAccessFile> base_;
+    RateLimiter* limiter_;
+    IOPriority priority_;
+};
+
 #ifdef _WIN32
 // ============================================================================
 // Windows (Win32) implementation
@@ -95,12 +385,14 @@ std::wstring StringToWString(const std::string& s) {
  * @brief Win32 `IWritableFile` backed by a HANDLE.
  *
  * Semantics:
- *  - `Write()` loops to handle short writes (should be rare on Win32, but correct).
- *  - `Flush()` is a no-op (no user buffers). Use `Sync()` (FlushFileBuffers) for durability.
+ *  - Appends are buffered (see `BufferedWritableFile`); `WriteRaw()` loops to
+ *    handle short writes (should be rare on Win32, but correct).
+ *  - `Sync()` flushes the buffer, then calls FlushFileBuffers.
  */
-class WindowsWritableFile final : public IWritableFile {
+class WindowsWritableFile final : public BufferedWritableFile {
 public:
-    explicit WindowsWritableFile(HANDLE handle) : handle_(handle) {}
+    WindowsWritableFile(HANDLE handle, const FileOptions& options)
+        : BufferedWritableFile(options), handle_(handle) {}
 
     ~WindowsWritableFile() override {
         if (handle_ != INVALID_HANDLE_VALUE) {
@@ -108,16 +400,15 @@ public:
         }
     }
 
+protected:
+    bool IsOpen() const override {
+        return handle_ != INVALID_HANDLE_VALUE;
+    }
+
     /**
-     * @brief Append `data` to the file, retrying on short writes.
-     * @return true on success; false on failure.
+     * @brief Write `n` bytes at the current position, retrying on short writes.
      */
-    bool Write(std::string_view data) override {
-        if (handle_ == INVALID_HANDLE_VALUE) return false;
-
-        const char* p = data.data();
-        size_t remaining = data.size();
-
+    bool WriteRaw(const char* p, size_t remaining) override {
         while (remaining > 0) {
             DWORD to_write = static_cast<DWORD>(remaining > static_cast<size_t>(std::numeric_limits<DWORD>::max())
                                                 ? std::numeric_limits<DWORD>::max()
@@ -137,25 +428,68 @@ public:
     }
 
     /**
-     * @brief Flush user-space buffers (no-op: writes go directly to OS).
+     * @brief Ensure OS buffers are flushed to the underlying storage device.
+     */
+    bool SyncRaw() override {
+        return FlushFileBuffers(handle_) != 0;
+    }
+
+    /**
+     * @brief Close the file handle.
      */
-    bool Flush() override {
+    bool CloseRaw() override {
+        BOOL ok = CloseHandle(handle_);
+        handle_ = INVALID_HANDLE_VALUE;
+        return ok != 0;
+    }
+
+private:
+    HANDLE handle_ = INVALID_HANDLE_VALUE;
+};
+
+/**
+ * @brief Win32 `IReadableFile` backed by a HANDLE.
+ *
+ * Semantics:
+ *  - Reads go straight into the caller's buffer, with optional readahead
+ *    (see `BufferedReadableFile`). The handle is opened with
+ *    FILE_FLAG_SEQUENTIAL_SCAN.
+ */
+class WindowsReadableFile final : public BufferedReadableFile {
+public:
+    WindowsReadableFile(HANDLE handle, size_t readahead_size)
+        : BufferedReadableFile(readahead_size), handle_(handle) {}
+
+    ~WindowsReadableFile() override {
+        if (handle_ != INVALID_HANDLE_VALUE) {
+            Close();
+        }
+    }
+
+protected:
+    bool IsOpen() const override {
         return handle_ != INVALID_HANDLE_VALUE;
     }
 
     /**
-     * @brief Ensure OS buffers are flushed to the underlying storage device.
+     * @brief One ReadFile call of up to `n` bytes.
      */
-    bool Sync() override {
-        if (handle_ == INVALID_HANDLE_VALUE) return false;
-        return FlushFileBuffers(handle_) != 0;
+    bool ReadRaw(char* p, size_t n, size_t* got) override {
+        DWORD to_read = static_cast<DWORD>(n > static_cast<size_t>(std::numeric_limits<DWORD>::max())
+                                           ? std::numeric_limits<DWORD>::max()
+                                           : n);
+        DWORD read = 0;
+        if (!ReadFile(handle_, p, to_read, &read, nullptr)) {
+            return false;
+        }
+        *got = static_cast<size_t>(read);
+        return true;
     }
 
     /**
      * @brief Close the file handle.
      */
-    bool Close() override {
-        if (handle_ == INVALID_HANDLE_VALUE) return true;
+    bool CloseRaw() override {
         BOOL ok = CloseHandle(handle_);
         handle_ = INVALID_HANDLE_VALUE;
         return ok != 0;
@@ -166,36 +500,52 @@ private:
 };
 
 /**
- * @brief Win32 `IReadableFile` backed by a HANDLE.
+ * @brief Win32 `IRandomAccessFile` backed by a HANDLE.
  *
  * Semantics:
- *  - `Read(n, out)` reads up to `n` bytes into `*out` (single read call).
+ *  - `Read(off, n, ...)` issues `ReadFile` with an OVERLAPPED offset, which does
+ *    not depend on (or race over) the handle's file pointer.
  */
-class WindowsReadableFile final : public IReadableFile {
+class WindowsRandomAccessFile final : public IRandomAccessFile {
 public:
-    explicit WindowsReadableFile(HANDLE handle) : handle_(handle) {}
+    WindowsRandomAccessFile(HANDLE handle, uint64_t size) : handle_(handle), size_(size) {}
 
-    ~WindowsReadableFile() override {
+    ~WindowsRandomAccessFile() override {
         if (handle_ != INVALID_HANDLE_VALUE) {
             Close();
         }
     }
 
     /**
-     * @brief Read up to `n` bytes. On success, returns number of bytes read (0 on EOF).
+     * @brief Positional read of up to `n` bytes into `scratch`; loops over short reads.
      */
-    size_t Read(size_t n, std::string* result) override {
-        if (handle_ == INVALID_HANDLE_VALUE || !result) return 0;
+    bool Read(uint64_t offset, size_t n, char* scratch, std::string_view* result) const override {
+        if (handle_ == INVALID_HANDLE_VALUE || !result) return false;
 
-        std::vector<char> buf(n);
-        DWORD read = 0;
-        if (!ReadFile(handle_, buf.data(), static_cast<DWORD>(n), &read, nullptr)) {
-            return 0;
+        size_t total = 0;
+        while (total < n) {
+            OVERLAPPED ov{};
+            const uint64_t pos = offset + total;
+            ov.Offset = static_cast<DWORD>(pos & 0xFFFFFFFFull);
+            ov.OffsetHigh = static_cast<DWORD>(pos >> 32);
+            const size_t remaining = n - total;
+            DWORD to_read = static_cast<DWORD>(remaining > static_cast<size_t>(std::numeric_limits<DWORD>::max())
+                                               ? std::numeric_limits<DWORD>::max()
+                                               : remaining);
+            DWORD got = 0;
+            if (!ReadFile(handle_, scratch + total, to_read, &got, &ov)) {
+                if (GetLastError() == ERROR_HANDLE_EOF) break;
+                return false;
+            }
+            if (got == 0) break; // EOF
+            total += got;
         }
-        result->assign(buf.data(), buf.data() + read);
-        return static_cast<size_t>(read);
+        *result = std::string_view(scratch, total);
+        return true;
     }
 
+    uint64_t Size() const override { return size_; }
+
     /**
      * @brief Close the file handle.
      */
@@ -208,6 +558,51 @@ public:
 
 private:
     HANDLE handle_ = INVALID_HANDLE_VALUE;
+    uint64_t size_;
+};
+
+/**
+ * @brief Win32 `IRandomAccessFile` over a read-only view of the whole file.
+ *
+ * Semantics:
+ *  - `Read(off, n, ...)` returns a view into the mapping; `scratch` is unused.
+ *  - `Close()` unmaps the view; views handed out earlier become invalid.
+ */
+class WindowsMmapRandomAccessFile final : public IRandomAccessFile {
+public:
+    WindowsMmapRandomAccessFile(const char* base, uint64_t size) : base_(base), size_(size) {}
+
+    ~WindowsMmapRandomAccessFile() override {
+        Close();
+    }
+
+    bool Read(uint64_t offset, size_t n, char* /*scratch*/, std::string_view* result) const override {
+        if (!result || (base_ == nullptr && size_ > 0)) return false;
+        if (offset >= size_) {
+            *result = std::string_view();
+            return true;
+        }
+        const uint64_t avail = size_ - offset;
+        *result = std::string_view(base_ + offset, static_cast<size_t>(n < avail ? n : avail));
+        return true;
+    }
+
+    uint64_t Size() const override { return size_; }
+    bool ReadsInPlace() const override { return true; }
+
+    /**
+     * @brief Unmap the view.
+     */
+    bool Close() override {
+        if (base_ == nullptr) return true;
+        BOOL ok = UnmapViewOfFile(base_);
+        base_ = nullptr;
+        return ok != 0;
+    }
+
+private:
+    const char* base_;
+    uint64_t size_;
 };
 
 #else
@@ -219,12 +614,16 @@ private:
  * @brief POSIX `IWritableFile` backed by an fd.
  *
  * Semantics:
- *  - `Write()` loops to handle partial writes and retries on EINTR.
- *  - `Sync()` uses `fsync` to request durable persistence.
+ *  - Appends are buffered (see `BufferedWritableFile`); `WriteRaw()` loops to
+ *    handle partial writes and retries on EINTR.
+ *  - `Sync()` flushes the buffer, then uses `fsync` to request durable persistence.
+ *  - `RangeSync()` (bytes_per_sync) uses `sync_file_range` write-behind on
+ *    Linux (wait for the previous range, start the new one), `fdatasync` elsewhere.
  */
-class PosixWritableFile final : public IWritableFile {
+class PosixWritableFile final : public BufferedWritableFile {
 public:
-    explicit PosixWritableFile(int fd) : fd_(fd) {}
+    PosixWritableFile(int fd, const FileOptions& options)
+        : BufferedWritableFile(options), fd_(fd) {}
 
     ~PosixWritableFile() override {
         if (fd_ != -1) {
@@ -232,16 +631,15 @@ public:
         }
     }
 
+protected:
+    bool IsOpen() const override {
+        return fd_ != -1;
+    }
+
     /**
-     * @brief Append `data` to the file. Handles short writes and EINTR.
-     * @return true on success; false on failure.
+     * @brief Write `n` bytes at the current position. Handles short writes and EINTR.
      */
-    bool Write(std::string_view data) override {
-        if (fd_ == -1) return false;
-
-        const char* p = data.data();
-        size_t remaining = data.size();
-
+    bool WriteRaw(const char* p, size_t remaining) override {
         while (remaining > 0) {
             ssize_t n = ::write(fd_, p, remaining);
             if (n < 0) {
@@ -259,29 +657,48 @@ public:
     }
 
     /**
-     * @brief Flush user-space buffers (no-op: we don't buffer in user space).
+     * @brief Ensure data is committed to the device (fsync).
      */
-    bool Flush() override {
-        return fd_ != -1;
+    bool SyncRaw() override {
+        int rc;
+        do {
+            rc = ::fsync(fd_);
+        } while (rc < 0 && errno == EINTR);
+        return rc == 0;
     }
 
     /**
-     * @brief Ensure data is committed to the device (fsync).
+     * @brief Write-behind: wait for the previous range to reach the device, then
+     * start write-back of the new one without waiting for it.
+     *
+     * Waiting on the previous range throttles the writer to device speed, so at
+     * most about two ranges of dirty pages are outstanding at any time.
      */
-    bool Sync() override {
-        if (fd_ == -1) return false;
+    bool RangeSync(uint64_t offset, uint64_t n) override {
+#ifdef SYNC_FILE_RANGE_WRITE
+        if (prev_range_size_ > 0 &&
+            !SyncFileRange(prev_range_offset_, prev_range_size_,
+                           SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER)) {
+            return false;
+        }
+        prev_range_offset_ = offset;
+        prev_range_size_ = n;
+        return SyncFileRange(offset, n, SYNC_FILE_RANGE_WRITE);
+#else
+        (void)offset;
+        (void)n;
         int rc;
         do {
-            rc = ::fsync(fd_);
+            rc = ::fdatasync(fd_);
         } while (rc < 0 && errno == EINTR);
         return rc == 0;
+#endif
     }
 
     /**
      * @brief Close the file descriptor.
      */
-    bool Close() override {
-        if (fd_ == -1) return true;
+    bool CloseRaw() override {
         int rc;
         do {
             rc = ::close(fd_);
@@ -291,6 +708,19 @@ public:
     }
 
 private:
+#ifdef SYNC_FILE_RANGE_WRITE
+    bool SyncFileRange(uint64_t offset, uint64_t n, unsigned int flags) {
+        int rc;
+        do {
+            rc = ::sync_file_range(fd_, static_cast<off_t>(offset), static_cast<off_t>(n), flags);
+        } while (rc < 0 && errno == EINTR);
+        return rc == 0;
+    }
+
+    uint64_t prev_range_offset_ = 0;
+    uint64_t prev_range_size_ = 0;
+#endif
+
     int fd_;
 };
 
@@ -298,11 +728,15 @@ private:
  * @brief POSIX `IReadableFile` backed by an fd.
  *
  * Semantics:
- *  - `Read(n, out)` reads up to `n` bytes into `*out` (single read call).
+ *  - Reads go straight into the caller's buffer, with optional readahead
+ *    (see `BufferedReadableFile`); retries on EINTR.
+ *  - The fd is opened with `posix_fadvise(SEQUENTIAL)` so the kernel reads
+ *    ahead aggressively as well.
  */
-class PosixReadableFile final : public IReadableFile {
+class PosixReadableFile final : public BufferedReadableFile {
 public:
-    explicit PosixReadableFile(int fd) : fd_(fd) {}
+    PosixReadableFile(int fd, size_t readahead_size)
+        : BufferedReadableFile(readahead_size), fd_(fd) {}
 
     ~PosixReadableFile() override {
         if (fd_ != -1) {
@@ -310,30 +744,28 @@ public:
         }
     }
 
+protected:
+    bool IsOpen() const override {
+        return fd_ != -1;
+    }
+
     /**
-     * @brief Read up to `n` bytes. Returns count read (0 on EOF), retries on EINTR.
+     * @brief One `read` of up to `n` bytes, retried on EINTR.
      */
-    size_t Read(size_t n, std::string* result) override {
-        if (fd_ == -1 || !result) return 0;
-
-        std::vector<char> buf(n);
+    bool ReadRaw(char* p, size_t n, size_t* got) override {
         ssize_t r;
         do {
-            r = ::read(fd_, buf.data(), n);
+            r = ::read(fd_, p, n);
         } while (r < 0 && errno == EINTR);
-
-        if (r <= 0) {
-            return 0; // 0 = EOF, <0 = error
-        }
-        result->assign(buf.data(), buf.data() + static_cast<size_t>(r));
-        return static_cast<size_t>(r);
+        if (r < 0) return false;
+        *got = static_cast<size_t>(r);
+        return true;
     }
 
     /**
      * @brief Close the file descriptor.
      */
-    bool Close() override {
-        if (fd_ == -1) return true;
+    bool CloseRaw() override {
         int rc;
         do {
             rc = ::close(fd_);
@@ -345,84 +777,529 @@ public:
 private:
     int fd_;
 };
-#endif // _WIN32
 
 /**
- * @brief Default `IFileManager` using C++17 `<filesystem>` and platform I/O.
+ * @brief POSIX `IRandomAccessFile` backed by an fd.
  *
- * Path utilities (exists/rename/remove) use `std::filesystem`. The open/close
- * operations use platform-specific primitives (Win32 HANDLEs vs POSIX fds).
+ * Semantics:
+ *  - `Read(off, n, ...)` uses `pread`, which never moves the fd's file offset,
+ *    so any number of threads may read concurrently through one descriptor.
+ *  - Loops over short reads and retries on EINTR; stops early only at EOF.
  */
-class DefaultFileManager final : public IFileManager {
+class PosixRandomAccessFile final : public IRandomAccessFile {
 public:
-    /**
-     * @brief Create/truncate a writable file and return an `IWritableFile`.
-     * @param fname Path to open (created if missing, truncated if exists).
-     * @param result On success, receives the new writable file.
-     * @return true on success; false on failure.
-     */
-    bool NewWritableFile(const std::string& fname, std::unique_ptr<IWritableFile>& result) override {
-#ifdef _WIN32
-        std::wstring wfname = StringToWString(fname);
-        HANDLE h = CreateFileW(
-            wfname.c_str(),
-            GENERIC_WRITE,
-            0,                  // No sharing
-            nullptr,
-            CREATE_ALWAYS,      // Create or truncate
-            FILE_ATTRIBUTE_NORMAL,
-            nullptr
-        );
-        if (h == INVALID_HANDLE_VALUE) {
-            return false;
+    PosixRandomAccessFile(int fd, uint64_t size) : fd_(fd), size_(size) {}
+
+    ~PosixRandomAccessFile() override {
+        if (fd_ != -1) {
+            Close();
         }
-        result = std::make_unique<WindowsWritableFile>(h);
-#else
-        // 0644 = rw-r--r--
-        int fd = ::open(fname.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
-        if (fd < 0) {
-            return false;
+    }
+
+    bool Read(uint64_t offset, size_t n, char* scratch, std::string_view* result) const override {
+        if (fd_ == -1 || !result) return false;
+
+        size_t total = 0;
+        while (total < n) {
+            ssize_t r = ::pread(fd_, scratch + total, n - total, static_cast<off_t>(offset + total));
+            if (r < 0) {
+                if (errno == EINTR) continue; // Retry read
+                return false;
+            }
+            if (r == 0) break; // EOF
+            total += static_cast<size_t>(r);
         }
-        result = std::make_unique<PosixWritableFile>(fd);
-#endif
+        *result = std::string_view(scratch, total);
         return true;
     }
 
+    uint64_t Size() const override { return size_; }
+    int FileDescriptor() const override { return fd_; }
+
     /**
-     * @brief Open an existing file for reading and return an `IReadableFile`.
-     * @param fname Path to open (must exist).
-     * @param result On success, receives the new readable file.
-     * @return true on success; false if the file does not exist or open fails.
+     * @brief Close the file descriptor.
      */
-    bool NewReadableFile(const std::string& fname, std::unique_ptr<IReadableFile>& result) override {
-        if (!FileExists(fname)) {
+    bool Close() override {
+        if (fd_ == -1) return true;
+        int rc;
+        do {
+            rc = ::close(fd_);
+        } while (rc < 0 && errno == EINTR);
+        fd_ = -1;
+        return rc == 0;
+    }
+
+private:
+    int fd_;
+    uint64_t size_;
+};
+
+/**
+ * @brief POSIX `IRandomAccessFile` over a read-only `mmap` of the whole file.
+ *
+ * Semantics:
+ *  - `Read(off, n, ...)` returns a view into the mapping; `scratch` is unused,
+ *    so cached tables are read without a copy or a syscall.
+ *  - The fd is closed right after mapping; the mapping keeps the file alive.
+ *  - `Close()` unmaps; views handed out earlier become invalid, so the owner
+ *    (e.g. a `TableReader`) must outlive every reader of those views.
+ */
+class PosixMmapRandomAccessFile final : public IRandomAccessFile {
+public:
+    PosixMmapRandomAccessFile(void* base, uint64_t size) : base_(base), size_(size) {}
+
+    ~PosixMmapRandomAccessFile() override {
+        Close();
+    }
+
+    bool Read(uint64_t offset, size_t n, char* /*scratch*/, std::string_view* result) const override {
+        if (!result || (base_ == nullptr && size_ > 0)) return false;
+        if (offset >= size_) {
+            *result = std::string_view();
+            return true;
+        }
+        const uint64_t avail = size_ - offset;
+        *result = std::string_view(static_cast<const char*>(base_) + offset,
+                                   static_cast<size_t>(n < avail ? n : avail));
+        return true;
+    }
+
+    uint64_t Size() const override { return size_; }
+    bool ReadsInPlace() const override { return true; }
+
+    /**
+     * @brief Unmap the file.
+     */
+    bool Close() override {
+        if (base_ == nullptr) return true;
+        const int rc = ::munmap(base_, static_cast<size_t>(size_));
+        base_ = nullptr;
+        return rc == 0;
+    }
+
+private:
+    void* base_;
+    uint64_t size_;
+};
+
+/**
+ * @brief Translate an `AccessPattern` into an `madvise` advice value.
+ */
+int MadviseFor(AccessPattern pattern) {
+    switch (pattern) {
+        case AccessPattern::kRandom:     return MADV_RANDOM;
+        case AccessPattern::kSequential: return MADV_SEQUENTIAL;
+        case AccessPattern::kNormal:     break;
+    }
+    return MADV_NORMAL;
+}
+
+/**
+ * @brief Pass an `AccessPattern` to the kernel's page-cache readahead for `fd`.
+ *
+ * Only a hint; errors are ignored. No-op where posix_fadvise is unavailable.
+ */
+void FadviseAccess(int fd, AccessPattern pattern) {
+#ifdef POSIX_FADV_SEQUENTIAL
+    int advice = POSIX_FADV_NORMAL;
+    if (pattern == AccessPattern::kSequential) advice = POSIX_FADV_SEQUENTIAL;
+    if (pattern == AccessPattern::kRandom) advice = POSIX_FADV_RANDOM;
+    if (advice != POSIX_FADV_NORMAL) {
+        (void)::posix_fadvise(fd, 0, 0, advice);
+    }
+#else
+    (void)fd;
+    (void)pattern;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Direct I/O (O_DIRECT): page-cache bypass for compaction inputs and outputs
+// ----------------------------------------------------------------------------
+
+/// Offset, length and buffer alignment required by O_DIRECT (covers 512 B and 4 KiB sectors).
+constexpr size_t kDirectIOAlignment = 4096;
+
+constexpr uint64_t AlignDown(uint64_t x) { return x & ~static_cast<uint64_t>(kDirectIOAlignment - 1); }
+constexpr uint64_t AlignUp(uint64_t x) { return AlignDown(x + kDirectIOAlignment - 1); }
+
+/**
+ * @brief Owning, `kDirectIOAlignment`-aligned heap buffer.
+ */
+class AlignedBuffer {
+public:
+    AlignedBuffer() = default;
+    explicit AlignedBuffer(size_t capacity) : capacity_(AlignUp(capacity)) {
+        void* p = nullptr;
+        if (::posix_memalign(&p, kDirectIOAlignment, capacity_) != 0) {
+            throw std::bad_alloc();
+        }
+        data_ = static_cast<char*>(p);
+    }
+    ~AlignedBuffer() { std::free(data_); }
+
+    AlignedBuffer(AlignedBuffer&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), capacity_(std::exchange(other.capacity_, 0)) {}
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(capacity_, other.capacity_);
+        return *this;
+    }
+
+    char* data() const { return data_; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    char* data_ = nullptr;
+    size_t capacity_ = 0;
+};
+
+/**
+ * @brief Thread-safe free list of aligned bounce buffers for direct reads.
+ *
+ * Avoids a `posix_memalign` per block read. Buffers larger than
+ * `kMaxPooledBytes` are not retained, nor more than `kMaxPooled` buffers.
+ */
+class AlignedBufferPool {
+public:
+    AlignedBuffer Acquire(size_t n) {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            for (size_t i = 0; i < free_.size(); ++i) {
+                if (free_[i].capacity() >= n) {
+                    AlignedBuffer buf = std::move(free_[i]);
+                    free_[i] = std::move(free_.back());
+                    free_.pop_back();
+                    return buf;
+                }
+            }
+        }
+        return AlignedBuffer(std::max<size_t>(n, kMinBytes));
+    }
+
+    void Release(AlignedBuffer buf) {
+        if (buf.capacity() > kMaxPooledBytes) return;
+        std::lock_guard<std::mutex> lock(mu_);
+        if (free_.size() < kMaxPooled) {
+            free_.push_back(std::move(buf));
+        }
+    }
+
+private:
+    static constexpr size_t kMinBytes = 64 * 1024;
+    static constexpr size_t kMaxPooledBytes = 1024 * 1024;
+    static constexpr size_t kMaxPooled = 32;
+
+    std::mutex mu_;
+    std::vector<AlignedBuffer> free_;
+};
+
+/**
+ * @brief POSIX `IRandomAccessFile` that reads with O_DIRECT.
+ *
+ * Semantics:
+ *  - Each read is widened to aligned offset/length, issued into a pooled
+ *    aligned bounce buffer, and the requested slice is copied into `scratch`.
+ *  - At EOF the kernel returns an unaligned short count; that ends the read.
+ */
+class PosixDirectRandomAccessFile final : public IRandomAccessFile {
+public:
+    PosixDirectRandomAccessFile(int fd, uint64_t size, std::shared_ptr<AlignedBufferPool> pool)
+        : fd_(fd), size_(size), pool_(std::move(pool)) {}
+
+    ~PosixDirectRandomAccessFile() override {
+        if (fd_ != -1) {
+            Close();
+        }
+    }
+
+    bool Read(uint64_t offset, size_t n, char* scratch, std::string_view* result) const override {
+        if (fd_ == -1 || !result) return false;
+        if (n == 0) {
+            *result = std::string_view(scratch, 0);
+            return true;
+        }
+
+        const uint64_t start = AlignDown(offset);
+        const size_t len = static_cast<size_t>(AlignUp(offset + n) - start);
+        AlignedBuffer buf = pool_->Acquire(len);
+        size_t total = 0;
+        bool ok = true;
+        while (total < len) {
+            ssize_t r = ::pread(fd_, buf.data() + total, len - total, static_cast<off_t>(start + total));
+            if (r < 0) {
+                if (errno == EINTR) continue; // Retry read
+                ok = false;
+                break;
+            }
+            total += static_cast<size_t>(r);
+            if (r == 0 || total % kDirectIOAlignment != 0) break; // EOF
+        }
+        if (ok) {
+            const size_t skip = static_cast<size_t>(offset - start);
+            const size_t got = total > skip ? std::min(n, total - skip) : 0;
+            std::memcpy(scratch, buf.data() + skip, got);
+            *result = std::string_view(scratch, got);
+        }
+        pool_->Release(std::move(buf));
+        return ok;
+    }
+
+    uint64_t Size() const override { return size_; }
+
+    /**
+     * @brief Close the file descriptor.
+     */
+    bool Close() override {
+        if (fd_ == -1) return true;
+        int rc;
+        do {
+            rc = ::close(fd_);
+        } while (rc < 0 && errno == EINTR);
+        fd_ = -1;
+        return rc == 0;
+    }
+
+private:
+    int fd_;
+    uint64_t size_;
+    std::shared_ptr<AlignedBufferPool> pool_;
+};
+
+/**
+ * @brief POSIX `IWritableFile` that writes with O_DIRECT.
+ *
+ * Semantics:
+ *  - Appends fill an aligned buffer; a full buffer is written with one
+ *    aligned `pwrite` at the (aligned) flushed offset.
+ *  - `Flush()` must also publish an unaligned tail: it zero-pads the buffer
+ *    to the alignment, writes it, and `ftruncate`s the file back to the
+ *    logical size. The partial last block stays in the buffer and is
+ *    rewritten in place by the next flush.
+ *  - `Sync()` flushes, then `fsync`s (metadata such as the size must persist).
+ *  - A failed `pwrite` or `ftruncate` is sticky, as in `BufferedWritableFile`:
+ *    part of a `Write()` may already sit in the buffer, so every later
+ *    `Write/Flush/Sync/Close` fails rather than let a retry duplicate it.
+ */
+class PosixDirectWritableFile final : public IWritableFile {
+public:
+    PosixDirectWritableFile(int fd, const FileOptions& options)
+        : fd_(fd),
+          buf_(std::max(options.write_buffer_size, kDirectIOAlignment)),
+          rate_limiter_(options.rate_limiter),
+          io_priority_(options.io_priority) {}
+
+    ~PosixDirectWritableFile() override {
+        if (fd_ != -1) {
+            Close();
+        }
+    }
+
+    bool Write(std::string_view data) override {
+        if (fd_ == -1 || failed_) return false;
+        while (!data.empty()) {
+            const size_t n = std::min(data.size(), buf_.capacity() - len_);
+            std::memcpy(buf_.data() + len_, data.data(), n);
+            len_ += n;
+            data.remove_prefix(n);
+            if (len_ == buf_.capacity()) {
+                if (!WriteAligned(buf_.capacity())) return false;
+                offset_ += len_;
+                len_ = 0;
+            }
+        }
+        return true;
+    }
+
+    bool Flush() override {
+        if (fd_ == -1 || failed_) return false;
+        if (len_ == 0) return true;
+
+        const size_t padded = static_cast<size_t>(AlignUp(len_));
+        std::memset(buf_.data() + len_, 0, padded - len_);
+        if (!WriteAligned(padded)) return false;
+        int rc;
+        do {
+            rc = ::ftruncate(fd_, static_cast<off_t>(offset_ + len_));
+        } while (rc < 0 && errno == EINTR);
+        if (rc != 0) {
+            failed_ = true;
             return false;
         }
+
+        // Keep only the partial last block; whole blocks are final.
+        const size_t whole = static_cast<size_t>(AlignDown(len_));
+        std::memmove(buf_.data(), buf_.data() + whole, len_ - whole);
+        offset_ += whole;
+        len_ -= whole;
+        return true;
+    }
+
+    bool Sync() override {
+        if (!Flush()) return false;
+        int rc;
+        do {
+            rc = ::fsync(fd_);
+        } while (rc < 0 && errno == EINTR);
+        return rc == 0;
+    }
+
+    bool Close() override {
+        if (fd_ == -1) return true;
+        const bool flushed = Flush();
+        int rc;
+        do {
+            rc = ::close(fd_);
+        } while (rc < 0 && errno == EINTR);
+        fd_ = -1;
+        return rc == 0 && flushed;
+    }
+
+private:
+    /**
+     * @brief `pwrite` the first `n` (aligned) buffer bytes at `offset_`.
+     * @return false (and marks the file failed) on error.
+     */
+    bool WriteAligned(size_t n) {
+        if (rate_limiter_ != nullptr) {
+            rate_limiter_->Request(static_cast<int64_t>(n), io_priority_);
+        }
+        size_t done = 0;
+        while (done < n) {
+            ssize_t w = ::pwrite(fd_, buf_.data() + done, n - done, static_cast<off_t>(offset_ + done));
+            if (w < 0 && errno == EINTR) continue; // Retry write
+            if (w <= 0) {
+                failed_ = true;
+                return false;
+            }
+            done += static_cast<size_t>(w);
+        }
+        return true;
+    }
+
+    int fd_;
+    AlignedBuffer buf_;
+    RateLimiter* rate_limiter_;
+    IOPriority io_priority_;
+    uint64_t offset_ = 0;  ///< Aligned file offset of buf_[0].
+    size_t len_ = 0;       ///< Valid bytes in buf_.
+    bool failed_ = false;  ///< A pwrite/ftruncate failed; the file may have a gap.
+};
+
+/**
+ * @brief Open flags that request direct I/O where the platform has a flag for it.
+ */
+int DirectIOFlags() {
+#ifdef O_DIRECT
+    return O_DIRECT;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Platform fix-ups after opening a direct-I/O fd (macOS has no O_DIRECT).
+ */
+bool EnableDirectIO(int fd) {
+#if !defined(O_DIRECT) && defined(F_NOCACHE)
+    return ::fcntl(fd, F_NOCACHE, 1) != -1;
+#else
+    (void)fd;
+    return true;
+#endif
+}
+#endif // _WIN32
+
+/**
+ * @brief Default `IFileManager` using C++17 `<filesystem>` and platform I/O.
+ *
+ * Path utilities (exists/rename/remove) use `std::filesystem`. The open/close
+ * operations use platform-specific primitives (Win32 HANDLEs vs POSIX fds).
+ */
+class DefaultFileManager final : public IFileManager {
+public:
+    /**
+     * @brief Create/truncate a writable file and return an `IWritableFile`.
+     * @param fname Path to open (created if missing, truncated if exists).
+     * @param result On success, receives the new writable file.
+     * @param options `write_buffer_size` sets the user-space append buffer.
+     * @return true on success; false on failure.
+     */
+    bool NewWritableFile(const std::string& fname, std::unique_ptr<IWritableFile>& result,
+                         const FileOptions& options) override {
 #ifdef _WIN32
         std::wstring wfname = StringToWString(fname);
         HANDLE h = CreateFileW(
             wfname.c_str(),
-            GENERIC_READ,
-            FILE_SHARE_READ,    // Allow concurrent readers
+            GENERIC_WRITE,
+            0,                  // No sharing
             nullptr,
-            OPEN_EXISTING,
+            CREATE_ALWAYS,      // Create or truncate
             FILE_ATTRIBUTE_NORMAL,
             nullptr
         );
         if (h == INVALID_HANDLE_VALUE) {
             return false;
         }
-        result = std::make_unique<WindowsReadableFile>(h);
+        result = std::make_unique<WindowsWritableFile>(h, options);
 #else
-        int fd = ::open(fname.c_str(), O_RDONLY);
+        // 0644 = rw-r--r--
+        const int flags = O_WRONLY | O_CREAT | O_TRUNC | (options.use_direct_io ? DirectIOFlags() : 0);
+        int fd = ::open(fname.c_str(), flags, 0644);
         if (fd < 0) {
             return false;
         }
-        result = std::make_unique<PosixReadableFile>(fd);
+        if (options.use_direct_io) {
+            if (!EnableDirectIO(fd)) {
+                ::close(fd);
+                return false;
+            }
+            result = std::make_unique<PosixDirectWritableFile>(fd, options);
+            return true;
+        }
+        result = std::make_unique<PosixWritableFile>(fd, options);
 #endif
         return true;
     }
 
+    /**
+     * @brief Open an existing file for reading and return an `IReadableFile`.
+     * @param fname Path to open (must exist).
+     * @param result On success, receives the new readable file.
+     * @param options Readahead and (with `rate_limit_reads`) rate-limiting options.
+     * @return true on success; false if the file does not exist or open fails.
+     */
+    bool NewReadableFile(const std::string& fname, std::unique_ptr<IReadableFile>& result,
+                         const FileOptions& options) override {
+        std::unique_ptr<IReadableFile> file;
+        if (!OpenReadableFile(fname, file, options)) return false;
+        if (options.rate_limiter != nullptr && options.rate_limit_reads) {
+            file = std::make_unique<RateLimitedReadableFile>(std::move(file), options.rate_limiter,
+                                                             options.io_priority);
+        }
+        result = std::move(file);
+        return true;
+    }
+
+    /**
+     * @brief Open an existing file for positional reads and return an `IRandomAccessFile`.
+     * @param fname Path to open (must exist).
+     * @param result On success, receives the new random-access file.
+     * @param options Mapping, direct-I/O, access-pattern and rate-limiting options.
+     * @return true on success; false if the file does not exist or open/map fails.
+     */
+    bool NewRandomAccessFile(const std::string& fname, std::unique_ptr<IRandomAccessFile>& result,
+                             const FileOptions& options) override {
+        std::unique_ptr<IRandomAccessFile> file;
+        if (!OpenRandomAccessFile(fname, file, options)) return false;
+        if (options.rate_limiter != nullptr && options.rate_limit_reads) {
+            file = std::make_unique<RateLimitedRandomAccessFile>(std::move(file), options.rate_limiter,
+                                                                 options.io_priority);
+        }
+        result = std::move(file);
+        return true;
+    }
+
     /**
      * @brief Test whether a file or directory exists at `fname`.
      */
@@ -449,6 +1326,160 @@ public:
         std::filesystem::rename(src, target, ec);
         return !ec;
     }
+
+    /**
+     * @brief Create `dirname` and any missing parents. Returns true if it exists afterwards.
+     */
+    bool CreateDir(const std::string& dirname) override {
+        std::error_code ec;
+        std::filesystem::create_directories(dirname, ec);
+        return !ec && std::filesystem::is_directory(dirname, ec);
+    }
+
+private:
+    /**
+     * @brief Open the platform sequential file (no rate limiting).
+     * @param fname Path to open (must exist).
+     * @param result On success, receives the new readable file.
+     * @param options `readahead_size` sets the user-space readahead buffer.
+     * @return true on success; false if the file does not exist or open fails.
+     */
+    bool OpenReadableFile(const std::string& fname, std::unique_ptr<IReadableFile>& result,
+                          const FileOptions& options) {
+        if (!FileExists(fname)) {
+            return false;
+        }
+#ifdef _WIN32
+        std::wstring wfname = StringToWString(fname);
+        HANDLE h = CreateFileW(
+            wfname.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,    // Allow concurrent readers
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+            nullptr
+        );
+        if (h == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        result = std::make_unique<WindowsReadableFile>(h, options.readahead_size);
+#else
+        int fd = ::open(fname.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        FadviseAccess(fd, AccessPattern::kSequential);
+        result = std::make_unique<PosixReadableFile>(fd, options.readahead_size);
+#endif
+        return true;
+    }
+
+    /**
+     * @brief Open the platform random-access file (no rate limiting).
+     * @param fname Path to open (must exist).
+     * @param result On success, receives the new random-access file.
+     * @param options `use_mmap_reads` selects the mapped implementation;
+     *        `access_pattern` is forwarded to the OS as a hint.
+     * @return true on success; false if the file does not exist or open/map fails.
+     */
+    bool OpenRandomAccessFile(const std::string& fname, std::unique_ptr<IRandomAccessFile>& result,
+                              const FileOptions& options) {
+        if (!FileExists(fname)) {
+            return false;
+        }
+#ifdef _WIN32
+        DWORD flags = FILE_ATTRIBUTE_NORMAL;
+        if (options.access_pattern == AccessPattern::kRandom) flags |= FILE_FLAG_RANDOM_ACCESS;
+        if (options.access_pattern == AccessPattern::kSequential) flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+
+        std::wstring wfname = StringToWString(fname);
+        HANDLE h = CreateFileW(
+            wfname.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ,    // Allow concurrent readers
+            nullptr,
+            OPEN_EXISTING,
+            flags,
+            nullptr
+        );
+        if (h == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(h, &size)) {
+            CloseHandle(h);
+            return false;
+        }
+        const uint64_t file_size = static_cast<uint64_t>(size.QuadPart);
+        if (!options.use_mmap_reads) {
+            result = std::make_unique<WindowsRandomAccessFile>(h, file_size);
+            return true;
+        }
+
+        // Zero-length files cannot be mapped; an empty view needs no mapping.
+        const char* base = nullptr;
+        if (file_size > 0) {
+            HANDLE mapping = CreateFileMappingW(h, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping != nullptr) {
+                base = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mapping); // The view keeps the mapping object alive.
+            }
+        }
+        CloseHandle(h);
+        if (file_size > 0 && base == nullptr) {
+            return false;
+        }
+        result = std::make_unique<WindowsMmapRandomAccessFile>(base, file_size);
+#else
+        const bool direct = options.use_direct_io && !options.use_mmap_reads;
+        int fd = ::open(fname.c_str(), O_RDONLY | (direct ? DirectIOFlags() : 0));
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        const uint64_t file_size = static_cast<uint64_t>(st.st_size);
+        if (!direct) {
+            FadviseAccess(fd, options.access_pattern);
+        }
+        if (direct) {
+            if (!EnableDirectIO(fd)) {
+                ::close(fd);
+                return false;
+            }
+            result = std::make_unique<PosixDirectRandomAccessFile>(fd, file_size, direct_read_buffers_);
+            return true;
+        }
+        if (!options.use_mmap_reads) {
+            result = std::make_unique<PosixRandomAccessFile>(fd, file_size);
+            return true;
+        }
+
+        // Zero-length files cannot be mapped; an empty view needs no mapping.
+        void* base = nullptr;
+        if (file_size > 0) {
+            base = ::mmap(nullptr, static_cast<size_t>(file_size), PROT_READ, MAP_SHARED, fd, 0);
+            if (base == MAP_FAILED) {
+                ::close(fd);
+                return false;
+            }
+            // Advice is only a hint; failure does not affect correctness.
+            (void)::madvise(base, static_cast<size_t>(file_size), MadviseFor(options.access_pattern));
+        }
+        ::close(fd); // The mapping holds its own reference to the file.
+        result = std::make_unique<PosixMmapRandomAccessFile>(base, file_size);
+#endif
+        return true;
+    }
+
+#ifndef _WIN32
+    /// Bounce buffers shared by every direct-I/O random-access file of this manager.
+    std::shared_ptr<AlignedBufferPool> direct_read_buffers_ = std::make_shared<AlignedBufferPool>();
+#endif
 };
 
 } // anonymous namespace
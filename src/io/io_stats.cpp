@@ -0,0 +1,251 @@
+/**
+ * @file io_stats.cpp
+ * @author Vrutik Halani
+ * @brief `IOStats` and the instrumenting file-manager decorators.
+ *
+ * Each decorator checks `IOStats::enabled()` once per call. When enabled it
+ * brackets the forwarded call with two steady-clock reads and records the
+ * result; when disabled it is a plain forwarder.
+ */
+
+#include "VrootKV/io/io_stats.h"
+
+#include <chrono>
+#include <cstdio>
+
+namespace VrootKV::io {
+
+// ============================================================================
+// Classification and names
+// ============================================================================
+
+namespace {
+
+bool EndsWith(std::string_view s, std::string_view suffix) {
+    return s.size() >= suffix.size() && s.substr(s.size() - suffix.size()) == suffix;
+}
+
+} // namespace
+
+FileClass ClassifyFile(std::string_view fname) {
+    const size_t slash = fname.find_last_of("/\\");
+    const std::string_view base = slash == std::string_view::npos ? fname : fname.substr(slash + 1);
+    if (EndsWith(base, ".log")) return FileClass::kWAL;
+    if (EndsWith(base, ".sst") || EndsWith(base, ".ldb")) return FileClass::kSSTable;
+    if (base.rfind("MANIFEST", 0) == 0 || base == "CURRENT") return FileClass::kManifest;
+    if (EndsWith(base, ".blob")) return FileClass::kBlob;
+    return FileClass::kOther;
+}
+
+const char* FileClassName(FileClass cls) {
+    switch (cls) {
+        case FileClass::kWAL: return "wal";
+        case FileClass::kSSTable: return "sstable";
+        case FileClass::kManifest: return "manifest";
+        case FileClass::kBlob: return "blob";
+        case FileClass::kOther: return "other";
+    }
+    return "unknown";
+}
+
+const char* IOOpName(IOOp op) {
+    switch (op) {
+        case IOOp::kRead: return "read";
+        case IOOp::kPRead: return "pread";
+        case IOOp::kWrite: return "write";
+        case IOOp::kFlush: return "flush";
+        case IOOp::kSync: return "sync";
+    }
+    return "unknown";
+}
+
+// ============================================================================
+// IOStats
+// ============================================================================
+
+void IOStats::Record(FileClass cls, IOOp op, uint64_t bytes, uint64_t latency_ns) {
+    OpCell& cell = Cell(cls, op);
+    cell.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    cell.latency_ns.Add(latency_ns);
+}
+
+void IOStats::Reset() {
+    for (OpCell& cell : cells_) {
+        cell.bytes.store(0, std::memory_order_relaxed);
+        cell.latency_ns.Clear();
+    }
+}
+
+std::string IOStats::ToString() const {
+    std::string out;
+    for (size_t c = 0; c < kNumFileClasses; ++c) {
+        for (size_t o = 0; o < kNumIOOps; ++o) {
+            const auto cls = static_cast<FileClass>(c);
+            const auto op = static_cast<IOOp>(o);
+            if (Count(cls, op) == 0) continue;
+            char head[64];
+            std::snprintf(head, sizeof(head), "%-8s %-5s bytes=%llu latency_ns: ", FileClassName(cls),
+                          IOOpName(op), static_cast<unsigned long long>(Bytes(cls, op)));
+            out += head;
+            out += Latency(cls, op).ToString();
+            out += '\n';
+        }
+    }
+    return out;
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t NanosSince(Clock::time_point start) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+// ============================================================================
+// Decorators
+// ============================================================================
+
+class InstrumentedWritableFile final : public IWritableFile {
+public:
+    InstrumentedWritableFile(std::unique_ptr<IWritableFile> base, FileClass cls, IOStats* stats)
+        : base_(std::move(base)), cls_(cls), stats_(stats) {}
+
+    bool Write(std::string_view data) override {
+        if (!stats_->enabled()) return base_->Write(data);
+        const Clock::time_point start = Clock::now();
+        const bool ok = base_->Write(data);
+        stats_->Record(cls_, IOOp::kWrite, data.size(), NanosSince(start));
+        return ok;
+    }
+
+    bool Flush() override {
+        if (!stats_->enabled()) return base_->Flush();
+        const Clock::time_point start = Clock::now();
+        const bool ok = base_->Flush();
+        stats_->Record(cls_, IOOp::kFlush, 0, NanosSince(start));
+        return ok;
+    }
+
+    bool Sync() override {
+        if (!stats_->enabled()) return base_->Sync();
+        const Clock::time_point start = Clock::now();
+        const bool ok = base_->Sync();
+        stats_->Record(cls_, IOOp::kSync, 0, NanosSince(start));
+        return ok;
+    }
+
+    bool Close() override {
+        if (!stats_->enabled()) return base_->Close();
+        // Close() flushes the tail of the buffer; account for it as a flush.
+        const Clock::time_point start = Clock::now();
+        const bool ok = base_->Close();
+        stats_->Record(cls_, IOOp::kFlush, 0, NanosSince(start));
+        return ok;
+    }
+
+private:
+    std::unique_ptr<IWritableFile> base_;
+    FileClass cls_;
+    IOStats* stats_;
+};
+
+class InstrumentedReadableFile final : public IReadableFile {
+public:
+    InstrumentedReadableFile(std::unique_ptr<IReadableFile> base, FileClass cls, IOStats* stats)
+        : base_(std::move(base)), cls_(cls), stats_(stats) {}
+
+    bool Read(size_t n, char* scratch, std::string_view* result) override {
+        if (!stats_->enabled()) return base_->Read(n, scratch, result);
+        const Clock::time_point start = Clock::now();
+        const bool ok = base_->Read(n, scratch, result);
+        stats_->Record(cls_, IOOp::kRead, ok ? result->size() : 0, NanosSince(start));
+        return ok;
+    }
+
+    bool Close() override { return base_->Close(); }
+
+private:
+    std::unique_ptr<IReadableFile> base_;
+    FileClass cls_;
+    IOStats* stats_;
+};
+
+class InstrumentedRandomAccessFile final : public IRandomAccessFile {
+public:
+    InstrumentedRandomAccessFile(std::unique_ptr<IRandomAccessFile> base, FileClass cls, IOStats* stats)
+        : base_(std::move(base)), cls_(cls), stats_(stats) {}
+
+    bool Read(uint64_t offset, size_t n, char* scratch, std::string_view* result) const override {
+        if (!stats_->enabled()) return base_->Read(offset, n, scratch, result);
+        const Clock::time_point start = Clock::now();
+        const bool ok = base_->Read(offset, n, scratch, result);
+        stats_->Record(cls_, IOOp::kPRead, ok ? result->size() : 0, NanosSince(start));
+        return ok;
+    }
+
+    uint64_t Size() const override { return base_->Size(); }
+    bool ReadsInPlace() const override { return base_->ReadsInPlace(); }
+    int FileDescriptor() const override { return base_->FileDescriptor(); }
+    bool Close() override { return base_->Close(); }
+
+private:
+    std::unique_ptr<IRandomAccessFile> base_;
+    FileClass cls_;
+    IOStats* stats_;
+};
+
+class InstrumentedFileManager final : public IFileManager {
+public:
+    InstrumentedFileManager(std::unique_ptr<IFileManager> base, IOStats* stats)
+        : base_(std::move(base)), stats_(stats) {}
+
+    bool NewWritableFile(const std::string& fname, std::unique_ptr<IWritableFile>& result,
+                         const FileOptions& options) override {
+        std::unique_ptr<IWritableFile> file;
+        if (!base_->NewWritableFile(fname, file, options)) return false;
+        result = std::make_unique<InstrumentedWritableFile>(std::move(file), ClassifyFile(fname), stats_);
+        return true;
+    }
+
+    bool NewReadableFile(const std::string& fname, std::unique_ptr<IReadableFile>& result,
+                         const FileOptions& options) override {
+        std::unique_ptr<IReadableFile> file;
+        if (!base_->NewReadableFile(fname, file, options)) return false;
+        result = std::make_unique<InstrumentedReadableFile>(std::move(file), ClassifyFile(fname), stats_);
+        return true;
+    }
+
+    bool NewRandomAccessFile(const std::string& fname, std::unique_ptr<IRandomAccessFile>& result,
+                             const FileOptions& options) override {
+        std::unique_ptr<IRandomAccessFile> file;
+        if (!base_->NewRandomAccessFile(fname, file, options)) return false;
+        result = std::make_unique<InstrumentedRandomAccessFile>(std::move(file), ClassifyFile(fname), stats_);
+        return true;
+    }
+
+    bool FileExists(const std::string& fname) const override { return base_->FileExists(fname); }
+    bool DeleteFile(const std::string& fname) override { return base_->DeleteFile(fname); }
+    bool RenameFile(const std::string& src, const std::string& target) override {
+        return base_->RenameFile(src, target);
+    }
+    bool CreateDir(const std::string& dirname) override { return base_->CreateDir(dirname); }
+
+private:
+    std::unique_ptr<IFileManager> base_;
+    IOStats* stats_;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// Public factory
+// ----------------------------------------------------------------------------
+
+std::unique_ptr<IFileManager> NewInstrumentedFileManager(std::unique_ptr<IFileManager> base,
+                                                         IOStats* stats) {
+    return std::make_unique<InstrumentedFileManager>(std::move(base), stats);
+}
+
+} // namespace VrootKV::io
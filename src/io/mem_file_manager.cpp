@@ -0,0 +1,346 @@
+/**
+ * @file mem_file_manager.cpp
+ * @author Vrutik Halani
+ * @brief In-memory `IFileManager` and its simulated device.
+ *
+ * Layout
+ * ------
+ *  - `MemDevice`    — turns (operation, bytes) into a wait according to the
+ *                     `MemDeviceModel`; a no-op when the model is all zero.
+ *  - `MemFile`      — the shared byte buffer behind a path.
+ *  - `Mem*File`     — writable / sequential / random-access handles.
+ *  - `MemFileManager` — the path → `MemFile` namespace.
+ *
+ * Waiting sleeps for the bulk of a delay and spins (yielding) for the last
+ * ~100 us, because plain sleeps overshoot by tens of microseconds and would
+ * swamp NVMe-scale latencies.
+ */
+
+#include "VrootKV/io/mem_file_manager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace VrootKV::io {
+
+MemDeviceModel MemDeviceModel::NVMe() {
+    MemDeviceModel m;
+    m.read_latency_us = 80;
+    m.write_latency_us = 20;
+    m.sync_latency_us = 50;
+    m.read_bytes_per_sec = 3000ll * 1000 * 1000;
+    m.write_bytes_per_sec = 2000ll * 1000 * 1000;
+    m.tail_latency_us = 1000;
+    m.tail_probability = 0.001;
+    return m;
+}
+
+MemDeviceModel MemDeviceModel::SATA() {
+    MemDeviceModel m;
+    m.read_latency_us = 200;
+    m.write_latency_us = 60;
+    m.sync_latency_us = 500;
+    m.read_bytes_per_sec = 540ll * 1000 * 1000;
+    m.write_bytes_per_sec = 500ll * 1000 * 1000;
+    m.tail_latency_us = 10000;
+    m.tail_probability = 0.01;
+    return m;
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// ============================================================================
+// Simulated device
+// ============================================================================
+
+enum class DeviceOp { kRead, kWrite, kSync };
+
+class MemDevice {
+public:
+    explicit MemDevice(const MemDeviceModel& model)
+        : model_(model),
+          enabled_(model.read_latency_us > 0 || model.write_latency_us > 0 || model.sync_latency_us > 0 ||
+                   model.read_bytes_per_sec > 0 || model.write_bytes_per_sec > 0 ||
+                   (model.tail_latency_us > 0 && model.tail_probability > 0.0)),
+          channel_free_(Clock::now()),
+          rng_(model.seed) {}
+
+    /**
+     * @brief Block for as long as the modelled device would take for this operation.
+     */
+    void Charge(DeviceOp op, size_t bytes) {
+        if (!enabled_) return;
+        Clock::time_point deadline;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            const Clock::time_point now = Clock::now();
+
+            // Transfer time occupies the shared channel (bandwidth limit).
+            const int64_t bw = op == DeviceOp::kRead ? model_.read_bytes_per_sec
+                             : op == DeviceOp::kWrite ? model_.write_bytes_per_sec : 0;
+            Clock::time_point done = now;
+            if (bw > 0 && bytes > 0) {
+                const auto transfer = std::chrono::nanoseconds(
+                    static_cast<int64_t>(static_cast<double>(bytes) * 1e9 / static_cast<double>(bw)));
+                channel_free_ = std::max(channel_free_, now) + transfer;
+                done = channel_free_;
+            }
+
+            int64_t latency_us = op == DeviceOp::kRead ? model_.read_latency_us
+                               : op == DeviceOp::kWrite ? model_.write_latency_us : model_.sync_latency_us;
+            if (model_.tail_probability > 0.0 && unit_(rng_) < model_.tail_probability) {
+                latency_us += model_.tail_latency_us;
+            }
+            deadline = done + std::chrono::microseconds(latency_us);
+        }
+        WaitUntil(deadline);
+    }
+
+private:
+    static void WaitUntil(Clock::time_point deadline) {
+        constexpr auto kSpin = std::chrono::microseconds(100);
+        if (deadline - Clock::now() > kSpin) {
+            std::this_thread::sleep_until(deadline - kSpin);
+        }
+        while (Clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    }
+
+    const MemDeviceModel model_;
+    const bool enabled_;
+    std::mutex mu_;
+    Clock::time_point channel_free_;  ///< When the simulated channel is next idle.
+    std::mt19937_64 rng_;
+    std::uniform_real_distribution<double> unit_{0.0, 1.0};
+};
+
+// ============================================================================
+// Files
+// ============================================================================
+
+/**
+ * @brief Contents of one path. Shared by the namespace and every open handle.
+ */
+struct MemFile {
+    mutable std::shared_mutex mu;
+    std::string data;
+
+    uint64_t Size() const {
+        std::shared_lock<std::shared_mutex> lock(mu);
+        return data.size();
+    }
+
+    /// Copy up to `n` bytes at `offset` into `scratch`; returns the count.
+    size_t ReadAt(uint64_t offset, size_t n, char* scratch) const {
+        std::shared_lock<std::shared_mutex> lock(mu);
+        if (offset >= data.size()) return 0;
+        const size_t got = std::min<size_t>(n, data.size() - static_cast<size_t>(offset));
+        std::copy_n(data.data() + offset, got, scratch);
+        return got;
+    }
+};
+
+class MemWritableFile final : public IWritableFile {
+public:
+    MemWritableFile(std::shared_ptr<MemFile> file, MemDevice* device, const FileOptions& options)
+        : file_(std::move(file)),
+          device_(device),
+          capacity_(options.write_buffer_size),
+          rate_limiter_(options.rate_limiter),
+          io_priority_(options.io_priority) {}
+
+    ~MemWritableFile() override { Close(); }
+
+    bool Write(std::string_view data) override {
+        if (file_ == nullptr) return false;
+        buf_.append(data);
+        return buf_.size() < capacity_ || Flush();
+    }
+
+    bool Flush() override {
+        if (file_ == nullptr) return false;
+        if (buf_.empty()) return true;
+        if (rate_limiter_ != nullptr) {
+            rate_limiter_->Request(static_cast<int64_t>(buf_.size()), io_priority_);
+        }
+        device_->Charge(DeviceOp::kWrite, buf_.size());
+        {
+            std::unique_lock<std::shared_mutex> lock(file_->mu);
+            file_->data.append(buf_);
+        }
+        buf_.clear();
+        return true;
+    }
+
+    bool Sync() override {
+        if (!Flush()) return false;
+        device_->Charge(DeviceOp::kSync, 0);
+        return true;
+    }
+
+    bool Close() override {
+        if (file_ == nullptr) return true;
+        const bool ok = Flush();
+        file_.reset();
+        return ok;
+    }
+
+private:
+    std::shared_ptr<MemFile> file_;  ///< Null once closed.
+    MemDevice* device_;
+    size_t capacity_;
+    RateLimiter* rate_limiter_;
+    IOPriority io_priority_;
+    std::string buf_;
+};
+
+class MemReadableFile final : public IReadableFile {
+public:
+    MemReadableFile(std::shared_ptr<MemFile> file, MemDevice* device, const FileOptions& options)
+        : file_(std::move(file)),
+          device_(device),
+          rate_limiter_(options.rate_limit_reads ? options.rate_limiter : nullptr),
+          io_priority_(options.io_priority) {}
+
+    bool Read(size_t n, char* scratch, std::string_view* result) override {
+        if (file_ == nullptr) return false;
+        if (rate_limiter_ != nullptr) rate_limiter_->Request(static_cast<int64_t>(n), io_priority_);
+        const size_t got = file_->ReadAt(pos_, n, scratch);
+        device_->Charge(DeviceOp::kRead, got);
+        pos_ += got;
+        *result = std::string_view(scratch, got);
+        return true;
+    }
+
+    bool Close() override {
+        file_.reset();
+        return true;
+    }
+
+private:
+    std::shared_ptr<MemFile> file_;
+    MemDevice* device_;
+    RateLimiter* rate_limiter_;
+    IOPriority io_priority_;
+    uint64_t pos_ = 0;
+};
+
+class MemRandomAccessFile final : public IRandomAccessFile {
+public:
+    MemRandomAccessFile(std::shared_ptr<MemFile> file, MemDevice* device, const FileOptions& options)
+        : file_(std::move(file)),
+          device_(device),
+          size_(file_->Size()),
+          rate_limiter_(options.rate_limit_reads ? options.rate_limiter : nullptr),
+          io_priority_(options.io_priority) {}
+
+    bool Read(uint64_t offset, size_t n, char* scratch, std::string_view* result) const override {
+        if (file_ == nullptr) return false;
+        if (rate_limiter_ != nullptr) rate_limiter_->Request(static_cast<int64_t>(n), io_priority_);
+        const size_t got = file_->ReadAt(offset, n, scratch);
+        device_->Charge(DeviceOp::kRead, got);
+        *result = std::string_view(scratch, got);
+        return true;
+    }
+
+    uint64_t Size() const override { return size_; }
+
+    bool Close() override {
+        file_.reset();
+        return true;
+    }
+
+private:
+    std::shared_ptr<MemFile> file_;
+    MemDevice* device_;
+    uint64_t size_;
+    RateLimiter* rate_limiter_;
+    IOPriority io_priority_;
+};
+
+// ============================================================================
+// Manager
+// ============================================================================
+
+class MemFileManager final : public IFileManager {
+public:
+    explicit MemFileManager(const MemDeviceModel& device) : device_(device) {}
+
+    bool NewWritableFile(const std::string& fname, std::unique_ptr<IWritableFile>& result,
+                         const FileOptions& options) override {
+        auto file = std::make_shared<MemFile>();
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            files_[fname] = file;
+        }
+        result = std::make_unique<MemWritableFile>(std::move(file), &device_, options);
+        return true;
+    }
+
+    bool NewReadableFile(const std::string& fname, std::unique_ptr<IReadableFile>& result,
+                         const FileOptions& options) override {
+        std::shared_ptr<MemFile> file = Find(fname);
+        if (file == nullptr) return false;
+        result = std::make_unique<MemReadableFile>(std::move(file), &device_, options);
+        return true;
+    }
+
+    bool NewRandomAccessFile(const std::string& fname, std::unique_ptr<IRandomAccessFile>& result,
+                             const FileOptions& options) override {
+        std::shared_ptr<MemFile> file = Find(fname);
+        if (file == nullptr) return false;
+        result = std::make_unique<MemRandomAccessFile>(std::move(file), &device_, options);
+        return true;
+    }
+
+    bool FileExists(const std::string& fname) const override {
+        return Find(fname) != nullptr;
+    }
+
+    bool DeleteFile(const std::string& fname) override {
+        std::lock_guard<std::mutex> lock(mu_);
+        return files_.erase(fname) > 0;
+    }
+
+    bool RenameFile(const std::string& src, const std::string& target) override {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = files_.find(src);
+        if (it == files_.end()) return false;
+        std::shared_ptr<MemFile> file = std::move(it->second);
+        files_.erase(it);
+        files_[target] = std::move(file);
+        return true;
+    }
+
+private:
+    std::shared_ptr<MemFile> Find(const std::string& fname) const {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = files_.find(fname);
+        return it == files_.end() ? nullptr : it->second;
+    }
+
+    MemDevice device_;
+    mutable std::mutex mu_;
+    std::unordered_map<std::string, std::shared_ptr<MemFile>> files_;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// Public factory
+// ----------------------------------------------------------------------------
+
+std::unique_ptr<IFileManager> NewMemFileManager(const MemDeviceModel& device) {
+    return std::make_unique<MemFileManager>(device);
+}
+
+} // namespace VrootKV::io
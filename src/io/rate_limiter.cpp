@@ -0,0 +1,186 @@
+/**
+ * @file rate_limiter.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of the token-bucket `RateLimiter`.
+ */
+
+#include "VrootKV/io/rate_limiter.h"
+
+#include <algorithm>
+
+namespace VrootKV::io {
+
+namespace {
+constexpr int kLow = static_cast<int>(IOPriority::kLow);
+constexpr int kHigh = static_cast<int>(IOPriority::kHigh);
+} // namespace
+
+RateLimiter::RateLimiter(const RateLimiterOptions& options)
+    : options_(options),
+      bytes_per_sec_(std::max<int64_t>(1, options.bytes_per_sec)),
+      available_(0),
+      next_refill_(Clock::now()),
+      next_tune_(Clock::now() + std::chrono::microseconds(options.tune_interval_us)) {
+    available_ = RefillBytes();
+}
+
+int64_t RateLimiter::RefillBytes() const {
+    const int64_t period = std::max<int64_t>(1, options_.refill_period_us);
+    return std::max<int64_t>(1, bytes_per_sec_ * period / 1000000);
+}
+
+void RateLimiter::SetBytesPerSecond(int64_t bytes_per_sec) {
+    std::lock_guard<std::mutex> lock(mu_);
+    bytes_per_sec_ = std::max<int64_t>(1, bytes_per_sec);
+}
+
+int64_t RateLimiter::GetBytesPerSecond() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return bytes_per_sec_;
+}
+
+int64_t RateLimiter::GetTotalBytesThrough(IOPriority priority) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return total_bytes_[static_cast<int>(priority)];
+}
+
+int64_t RateLimiter::GetTotalRequests(IOPriority priority) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return total_requests_[static_cast<int>(priority)];
+}
+
+int64_t RateLimiter::GetThrottledRefills() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return throttled_refills_;
+}
+
+void RateLimiter::Request(int64_t bytes, IOPriority priority) {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        ++total_requests_[static_cast<int>(priority)];
+    }
+    while (bytes > 0) {
+        // Chunks never exceed one refill, so every chunk can eventually be granted.
+        const int64_t chunk = std::min(bytes, ChunkLimit());
+        RequestChunk(chunk, priority);
+        bytes -= chunk;
+    }
+}
+
+int64_t RateLimiter::ChunkLimit() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return RefillBytes();
+}
+
+void RateLimiter::RequestChunk(int64_t bytes, IOPriority priority) {
+    const int pri = static_cast<int>(priority);
+    std::unique_lock<std::mutex> lock(mu_);
+
+    // Fast path: nobody queued and enough tokens banked.
+    if (queues_[kLow].empty() && queues_[kHigh].empty() && available_ >= bytes) {
+        available_ -= bytes;
+        total_bytes_[pri] += bytes;
+        return;
+    }
+
+    Waiter waiter(bytes);
+    queues_[pri].push_back(&waiter);
+    while (!waiter.granted) {
+        if (!leader_active_) {
+            // Leader: sleep until the next refill, then distribute tokens.
+            leader_active_ = true;
+            const Clock::time_point wake = next_refill_;
+            waiter.cv.wait_until(lock, wake);
+            const Clock::time_point now = Clock::now();
+            if (now >= next_refill_) {
+                RefillAndGrant(now);
+            }
+            leader_active_ = false;
+            if (waiter.granted) {
+                WakeNextLeader();
+            }
+        } else {
+            waiter.cv.wait(lock);
+        }
+    }
+    total_bytes_[pri] += bytes;
+}
+
+/**
+ * @brief Hand leadership to the next queued waiter, if any.
+ */
+void RateLimiter::WakeNextLeader() {
+    if (!queues_[kHigh].empty()) {
+        queues_[kHigh].front()->cv.notify_one();
+    } else if (!queues_[kLow].empty()) {
+        queues_[kLow].front()->cv.notify_one();
+    }
+}
+
+void RateLimiter::RefillAndGrant(Clock::time_point now) {
+    const int64_t refill = RefillBytes();
+    next_refill_ = now + std::chrono::microseconds(std::max<int64_t>(1, options_.refill_period_us));
+    available_ = std::min(available_ + refill, refill);
+    ++refill_count_;
+    // Only the leader refills, so someone is always waiting here: the budget,
+    // not the device, is what is holding background I/O back.
+    ++throttled_refills_;
+
+    const bool low_first = options_.fairness > 0 && refill_count_ % options_.fairness == 0;
+    const int order[2] = {low_first ? kLow : kHigh, low_first ? kHigh : kLow};
+    for (int q : order) {
+        auto& queue = queues_[q];
+        while (!queue.empty() && available_ > 0) {
+            Waiter* w = queue.front();
+            if (w->remaining > available_) {
+                // Partial grant keeps strict order: nobody overtakes this waiter.
+                w->remaining -= available_;
+                available_ = 0;
+                break;
+            }
+            available_ -= w->remaining;
+            w->remaining = 0;
+            w->granted = true;
+            queue.pop_front();
+            w->cv.notify_one();
+        }
+        if (available_ == 0) break;
+    }
+    MaybeTune(now);
+}
+
+void RateLimiter::RecordForegroundLatency(std::chrono::microseconds latency) {
+    if (options_.foreground_latency_target_us <= 0) return;
+    std::lock_guard<std::mutex> lock(mu_);
+    latency_samples_us_.push_back(latency.count());
+    MaybeTune(Clock::now());
+}
+
+/**
+ * @brief AIMD step on the rate once per tuning interval (caller holds mu_).
+ */
+void RateLimiter::MaybeTune(Clock::time_point now) {
+    if (options_.foreground_latency_target_us <= 0 || now < next_tune_) return;
+    next_tune_ = now + std::chrono::microseconds(options_.tune_interval_us);
+
+    const bool throttled = throttled_refills_ > throttled_refills_at_last_tune_;
+    throttled_refills_at_last_tune_ = throttled_refills_;
+    if (latency_samples_us_.empty()) return;
+
+    const size_t idx = latency_samples_us_.size() * 99 / 100;
+    std::nth_element(latency_samples_us_.begin(), latency_samples_us_.begin() + idx,
+                     latency_samples_us_.end());
+    const int64_t p99 = latency_samples_us_[idx];
+    latency_samples_us_.clear();
+
+    const int64_t max_rate = options_.max_bytes_per_sec > 0 ? options_.max_bytes_per_sec
+                                                            : options_.bytes_per_sec;
+    if (p99 > options_.foreground_latency_target_us) {
+        bytes_per_sec_ = std::max(options_.min_bytes_per_sec, bytes_per_sec_ * 8 / 10);
+    } else if (throttled) {
+        bytes_per_sec_ = std::min(max_rate, bytes_per_sec_ + std::max<int64_t>(1, bytes_per_sec_ / 10));
+    }
+    bytes_per_sec_ = std::max<int64_t>(1, bytes_per_sec_);
+}
+
+} // namespace VrootKV::io
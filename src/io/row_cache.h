@@ -0,0 +1,114 @@
+/**
+ * @file row_cache.h
+ * @author Vrutik Halani
+ * @brief Cache of point-lookup results from the SSTables, keyed by user key.
+ *
+ * Skewed workloads re-read a small set of hot keys. The block cache still
+ * spends a whole block of capacity per hot row and every hit still pays for
+ * filter probes, index search and block search in each table consulted. The
+ * row cache remembers the final answer of the SSTable part of a lookup (the
+ * value, or "absent from every table") so a hit skips all of that.
+ *
+ * Consistency
+ * -----------
+ * A cached row is valid as of a sequence number taken from `Sequence()`
+ * before the table lookup that produced it. `Invalidate(key)` (called on
+ * every write of the key) advances the sequence, records it for the key's
+ * stripe and drops the entry. `Insert()` refuses a row whose lookup started
+ * before the latest invalidation of its stripe, and re-checks after
+ * inserting, so a lookup racing with a write can never leave a stale row
+ * behind. Stripes are shared by hashing, so a write may occasionally reject
+ * an unrelated insert; that only costs a future miss.
+ *
+ * Reads at an older snapshot must bypass the cache (there is no per-entry
+ * history); current-state lookups can always use it.
+ *
+ * Sharding and eviction reuse `ShardedLRUCache` / `ShardedClockCache`, like
+ * `BlockCache`. The charge of a row is its key and value size plus a fixed
+ * per-entry overhead. With `tinylfu_admission`, a new row displaces its
+ * eviction victim only if its key was looked up more often, as in the block
+ * cache.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "block_cache.h"
+
+namespace VrootKV::io {
+
+struct RowCacheOptions {
+    /// Byte budget (keys + values + per-entry overhead).
+    std::size_t capacity = 4 << 20;
+    /// log2 of the number of shards.
+    int num_shard_bits = 6;
+    CacheEvictionPolicy policy = CacheEvictionPolicy::kLRU;
+    /// Admit a row over its eviction victim only if its key is more popular.
+    bool tinylfu_admission = false;
+};
+
+/**
+ * @class RowCache
+ * @brief Thread-safe user-key → lookup-result cache.
+ */
+class RowCache {
+public:
+    /// Cached result of the SSTable part of a lookup.
+    struct Row {
+        bool found = false;  ///< False: the key is in no table (negative entry).
+        std::string value;
+    };
+
+    /// Approximate bookkeeping bytes charged per entry on top of key and value.
+    static constexpr std::size_t kEntryOverhead = 64;
+
+    explicit RowCache(const RowCacheOptions& options = RowCacheOptions());
+
+    RowCache(const RowCache&) = delete;
+    RowCache& operator=(const RowCache&) = delete;
+
+    /// Sequence to pass to `Insert()`; read it before starting the table lookup.
+    uint64_t Sequence() const { return sequence_.load(); }
+
+    /// Cached row for `key`, or null on a miss.
+    std::shared_ptr<const Row> Lookup(const std::string& key);
+
+    /**
+     * @brief Cache the result of a table lookup that started at `read_sequence`.
+     *
+     * Ignored if `key` was invalidated after `read_sequence`.
+     */
+    void Insert(const std::string& key, bool found, std::string value, uint64_t read_sequence);
+
+    /// Drop `key` and fence out in-flight lookups of it. Call on every write.
+    void Invalidate(const std::string& key);
+
+    std::size_t GetUsage() const;
+    std::size_t GetCapacity() const { return options_.capacity; }
+    common::CacheStats GetStats() const;
+
+    /// Inserts refused because the key was written during the lookup.
+    uint64_t rejected_inserts() const { return rejected_inserts_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t kStripes = 1024;
+
+    std::atomic<uint64_t>& Stripe(const std::string& key);
+    void Erase(const std::string& key);
+
+    const RowCacheOptions options_;
+    std::unique_ptr<common::FrequencySketch> sketch_;  ///< Null unless `tinylfu_admission`.
+    std::unique_ptr<common::ShardedLRUCache<std::string, const Row>> lru_;
+    std::unique_ptr<common::ShardedClockCache<std::string, const Row>> clock_;
+    std::atomic<uint64_t> sequence_{0};
+    std::array<std::atomic<uint64_t>, kStripes> invalidated_at_{};
+    std::atomic<uint64_t> rejected_inserts_{0};
+};
+
+} // namespace VrootKV::io
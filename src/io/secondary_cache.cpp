@@ -0,0 +1,55 @@
+/**
+ * @file secondary_cache.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of `CompressedSecondaryCache`.
+ */
+
+#include "secondary_cache.h"
+
+#include <memory>
+#include <stdexcept>
+
+#include "../common/lz_codec.h"
+
+namespace VrootKV::io {
+
+namespace {
+constexpr char kRaw = 0;
+constexpr char kLZ = 1;
+} // namespace
+
+CompressedSecondaryCache::CompressedSecondaryCache(const SecondaryCacheOptions& options)
+    : cache_(options.capacity, options.num_shard_bits) {}
+
+void CompressedSecondaryCache::Insert(const BlockCacheKey& key, std::string_view block) {
+    std::string stored(1, kLZ);
+    common::LZCompress(block, &stored);
+    if (stored.size() - 1 > block.size() - block.size() / 8) {
+        stored.assign(1, kRaw);
+        stored.append(block);
+    }
+    raw_bytes_.fetch_add(block.size(), std::memory_order_relaxed);
+    stored_bytes_.fetch_add(stored.size(), std::memory_order_relaxed);
+    const std::size_t charge = stored.size();
+    cache_.Insert(key, std::make_shared<Stored>(std::move(stored)), charge);
+}
+
+bool CompressedSecondaryCache::Lookup(const BlockCacheKey& key, std::string* block) {
+    std::shared_ptr<Stored> stored = cache_.Lookup(key);
+    if (stored == nullptr) return false;
+    cache_.Erase(key);
+    if (stored->empty()) throw std::runtime_error("CompressedSecondaryCache: empty entry");
+    const std::string_view payload(stored->data() + 1, stored->size() - 1);
+    if ((*stored)[0] == kLZ) {
+        common::LZDecompress(payload, block);
+    } else {
+        block->assign(payload);
+    }
+    return true;
+}
+
+void CompressedSecondaryCache::Erase(const BlockCacheKey& key) {
+    cache_.Erase(key);
+}
+
+} // namespace VrootKV::io
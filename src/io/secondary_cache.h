@@ -0,0 +1,92 @@
+/**
+ * @file secondary_cache.h
+ * @author Vrutik Halani
+ * @brief Compressed second tier behind the uncompressed `BlockCache`.
+ *
+ * When the working set is a few times the primary block cache, most misses
+ * are for blocks that were cached a moment ago and then evicted. Keeping
+ * those evicted blocks compressed in a larger secondary tier turns such a
+ * miss into a decompression (microseconds of CPU) instead of a device read.
+ *
+ * Flow
+ * ----
+ *  - The primary cache demotes every block it evicts for capacity: the block
+ *    is compressed with `common::LZCompress()` and inserted here. Blocks
+ *    that do not shrink by at least 1/8 are stored raw, so incompressible
+ *    data costs no decompression on the way back.
+ *  - A primary miss looks here; a hit is decompressed, erased from this tier
+ *    and promoted into the primary (the tiers are exclusive, so a block never
+ *    takes space in both).
+ *  - This tier evicts in LRU order; its victims are simply dropped.
+ *
+ * The charge of an entry is its stored (compressed) size, so the same
+ * capacity holds roughly "compression ratio" times more blocks than the
+ * primary would.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "block_cache.h"
+
+namespace VrootKV::io {
+
+struct SecondaryCacheOptions {
+    /// Byte budget for stored (compressed) blocks.
+    std::size_t capacity = 32 << 20;
+    /// log2 of the number of shards.
+    int num_shard_bits = 6;
+};
+
+/**
+ * @class CompressedSecondaryCache
+ * @brief Thread-safe store of compressed blocks, keyed like `BlockCache`.
+ *
+ * Attach it through `BlockCacheOptions::secondary_cache`; it may also be
+ * used directly.
+ */
+class CompressedSecondaryCache {
+public:
+    explicit CompressedSecondaryCache(const SecondaryCacheOptions& options = SecondaryCacheOptions());
+
+    CompressedSecondaryCache(const CompressedSecondaryCache&) = delete;
+    CompressedSecondaryCache& operator=(const CompressedSecondaryCache&) = delete;
+
+    /// Compress and store `block` under `key` (no-op if `key` is present).
+    void Insert(const BlockCacheKey& key, std::string_view block);
+
+    /**
+     * @brief Take the block for `key` out of the cache.
+     * @return True and the uncompressed bytes in `*block` on a hit.
+     * @throws std::runtime_error if the stored encoding is corrupt.
+     */
+    bool Lookup(const BlockCacheKey& key, std::string* block);
+
+    /// Drop one block.
+    void Erase(const BlockCacheKey& key);
+
+    /// Stored (compressed) bytes currently charged.
+    std::size_t GetUsage() const { return cache_.TotalCharge(); }
+    std::size_t GetCapacity() const { return cache_.capacity(); }
+
+    /// Hits, misses, inserts and evictions since construction.
+    common::CacheStats GetStats() const { return cache_.GetStats(); }
+
+    /// Uncompressed and stored bytes of every insert so far (their ratio is the compression ratio).
+    uint64_t raw_bytes_inserted() const { return raw_bytes_.load(std::memory_order_relaxed); }
+    uint64_t stored_bytes_inserted() const { return stored_bytes_.load(std::memory_order_relaxed); }
+
+private:
+    using Stored = const std::string;  ///< One tag byte (raw / LZ) + payload.
+
+    common::ShardedLRUCache<BlockCacheKey, Stored, BlockCacheKeyHash> cache_;
+    std::atomic<uint64_t> raw_bytes_{0};
+    std::atomic<uint64_t> stored_bytes_{0};
+};
+
+} // namespace VrootKV::io
@@ -57,6 +57,7 @@
 #include <cstdint>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 #include "VrootKV/io/sstable_format.h"
 
@@ -150,6 +151,13 @@ public:
      */
     bool Get(std::string_view key, std::string& value_out) const;
 
+    /**
+     * @brief Decode every entry, in key order, into `entries` (replaced).
+     * Used by iterators, which walk whole blocks anyway.
+     * @throws std::runtime_error if the block encoding is malformed.
+     */
+    void ReadAll(std::vector<std::pair<std::string, std::string>>& entries) const;
+
 private:
     std::string_view full_;           ///< Entire block bytes.
     std::string_view entries_;        ///< Entries region (excludes restart table & count).
@@ -220,6 +228,15 @@ public:
      */
     bool Find(std::string_view search_key, BlockHandle& handle_out) const;
 
+    /// Number of entries in the block.
+    uint32_t size() const { return num_; }
+
+    /**
+     * @brief Decode the entry at position `idx` (0-based, in key order).
+     * @return `true` on success; `false` if `idx` is out of range or the entry is malformed.
+     */
+    bool EntryAt(uint32_t idx, std::string& key_out, BlockHandle& handle_out) const;
+
 private:
     std::string_view full_;           ///< Entire index block.
     std::string_view entries_;        ///< Entries region (before offset table).
@@ -242,6 +242,34 @@ bool DataBlockReader::Get(std::string_view key, std::string& value_out) const {
     return false;
 }
 
+/**
+ * @brief Decode all entries of the block in order.
+ *
+ * Unlike `Get()`, which treats a malformed run as "not found", a full decode
+ * has no benign failure mode, so any structural problem throws.
+ */
+void DataBlockReader::ReadAll(std::vector<std::pair<std::string, std::string>>& entries) const {
+    entries.clear();
+    uint32_t off = 0;
+    std::string prev_key;
+    while (off < entries_.size()) {
+        if (off + 12 > entries_.size()) throw std::runtime_error("DataBlockReader: truncated entry");
+        const char* p = entries_.data() + off;
+        const uint32_t shared    = detail::DecodeFixed32(p + 0);
+        const uint32_t nonshared = detail::DecodeFixed32(p + 4);
+        const uint32_t vlen      = detail::DecodeFixed32(p + 8);
+        const size_t need = 12ull + nonshared + vlen;
+        if (off + need > entries_.size() || shared > prev_key.size()) {
+            throw std::runtime_error("DataBlockReader: corrupt entry");
+        }
+        std::string key = prev_key.substr(0, shared);
+        key.append(p + 12, nonshared);
+        entries.emplace_back(key, std::string(p + 12 + nonshared, vlen));
+        prev_key.swap(key);
+        off += static_cast<uint32_t>(need);
+    }
+}
+
 // ============================================================================
 // IndexBlockReader — divider-key to BlockHandle routing
 // ============================================================================
@@ -375,4 +403,24 @@ bool IndexBlockReader::Find(std::string_view search_key, BlockHandle& handle_out
     return true;
 }
 
+/**
+ * @brief Decode the divider key and handle stored at entry `idx`.
+ */
+bool IndexBlockReader::EntryAt(uint32_t idx, std::string& key_out, BlockHandle& handle_out) const {
+    if (idx >= num_) return false;
+
+    std::string_view sv = entries_.substr(offsets_[idx]);
+    uint32_t klen = 0;
+    if (!detail::GetVarint32(sv, klen)) {
+        return false;
+    }
+    if (sv.size() < klen + BlockHandle::kEncodedLength) {
+        return false;
+    }
+    key_out.assign(sv.data(), klen);
+    sv.remove_prefix(klen);
+    handle_out = BlockHandle::DecodeFrom(sv);
+    return true;
+}
+
 } // namespace VrootKV::io
@@ -0,0 +1,171 @@
+/**
+ * @file table_builder.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of `TableBuilder`: block cutting, filter, index and footer.
+ */
+
+#include "table_builder.h"
+
+#include <stdexcept>
+
+#include "VrootKV/common/bloom_filter.h"
+
+namespace VrootKV::io {
+
+TableBuilder::TableBuilder(const TableBuilderOptions& options, IWritableFile* file)
+    : options_(options),
+      file_(file),
+      bits_per_key_(options.filter_budget
+                        ? options.filter_budget->BitsPerKeyForLevel(options.level)
+                        : options.bits_per_key),
+      data_block_(options.restart_interval) {
+    if (options_.range_filter_prefix_len > 0) {
+        range_filter_.emplace(options_.range_filter_prefix_len);
+    }
+}
+
+/**
+ * @brief Append a pair to the current data block, cutting a new block when full.
+ */
+void TableBuilder::Add(const std::string& key, const std::string& value) {
+    if (finished_) {
+        throw std::runtime_error("TableBuilder: already finished");
+    }
+    if (num_entries_ > 0 && !(last_key_ < key)) {
+        throw std::runtime_error("TableBuilder: keys must be strictly increasing");
+    }
+
+    if (block_empty_) {
+        pending_first_key_ = key;
+        block_empty_ = false;
+    }
+    data_block_.Add(key, value);
+    if (bits_per_key_ > 0) {
+        filter_keys_.push_back(key);
+    }
+    if (range_filter_) {
+        range_filter_->add(key);
+    }
+    last_key_ = key;
+    ++num_entries_;
+
+    if (data_block_.CurrentSize() >= options_.block_size) {
+        FlushDataBlock();
+    }
+}
+
+/**
+ * @brief Write the current data block and record its index entry.
+ */
+void TableBuilder::FlushDataBlock() {
+    if (block_empty_) return;
+
+    BlockHandle handle;
+    if (WriteRaw(data_block_.Finish(), &handle)) {
+        index_block_.Add(pending_first_key_, handle);
+    }
+    data_block_ = DataBlockBuilder(options_.restart_interval);
+    block_empty_ = true;
+
+    // Partitions are cut only at data-block boundaries.
+    if (partitioned() &&
+        static_cast<double>(filter_keys_.size()) * bits_per_key_ / 8.0 >=
+            static_cast<double>(options_.filter_partition_size)) {
+        CutFilterPartition();
+    }
+}
+
+/**
+ * @brief Build a Bloom filter over the keys collected so far and write it as a partition.
+ */
+void TableBuilder::CutFilterPartition() {
+    if (filter_keys_.empty()) return;
+
+    common::BloomFilter filter(filter_keys_.size(),
+                               common::FilterBudget::FalsePositiveRate(bits_per_key_));
+    for (const std::string& k : filter_keys_) filter.add(k);
+    const std::string bytes = filter.serialize();
+
+    BlockHandle handle;
+    if (WriteRaw(bytes, &handle)) {
+        filter_partition_index_.Add(filter_keys_.front(), handle);
+    }
+    filter_size_ += bytes.size();
+    ++num_filter_partitions_;
+    filter_keys_.clear();
+}
+
+/**
+ * @brief Append raw bytes at the current offset; `handle` receives their location.
+ */
+bool TableBuilder::WriteRaw(const std::string& bytes, BlockHandle* handle) {
+    if (!ok_) return false;
+    handle->offset = offset_;
+    handle->size = bytes.size();
+    if (!file_->Write(bytes)) {
+        ok_ = false;
+        return false;
+    }
+    offset_ += bytes.size();
+    return true;
+}
+
+/**
+ * @brief Write the trailing meta blocks, meta-index, index block and footer.
+ */
+bool TableBuilder::Finish() {
+    if (finished_) return ok_;
+    FlushDataBlock();
+    finished_ = true;
+
+    SSTableFooter footer;
+    footer.magic = SSTableFooter::kMetaIndexMagic;
+
+    // Meta-index entries must be added in name order.
+    IndexBlockBuilder meta_index;
+
+    if (partitioned()) {
+        CutFilterPartition();
+        if (num_filter_partitions_ > 0) {
+            const std::string bytes = filter_partition_index_.Finish();
+            BlockHandle handle;
+            if (WriteRaw(bytes, &handle)) {
+                meta_index.Add(std::string(kPartitionedFilterMetaName), handle);
+            }
+            filter_size_ += bytes.size();
+        }
+    } else if (bits_per_key_ > 0 && !filter_keys_.empty()) {
+        common::BloomFilter filter(filter_keys_.size(),
+                                   common::FilterBudget::FalsePositiveRate(bits_per_key_));
+        for (const std::string& k : filter_keys_) filter.add(k);
+        const std::string bytes = filter.serialize();
+        BlockHandle handle;
+        if (WriteRaw(bytes, &handle)) {
+            meta_index.Add(std::string(kBloomFilterMetaName), handle);
+        }
+        filter_size_ = bytes.size();
+        filter_keys_.clear();
+        filter_keys_.shrink_to_fit();
+    }
+
+    if (range_filter_ && num_entries_ > 0) {
+        const std::string bytes = range_filter_->serialize();
+        BlockHandle handle;
+        if (WriteRaw(bytes, &handle)) {
+            meta_index.Add(std::string(kRangeFilterMetaName), handle);
+        }
+        range_filter_size_ = bytes.size();
+    }
+
+    WriteRaw(meta_index.Finish(), &footer.filter_handle);
+    WriteRaw(index_block_.Finish(), &footer.index_handle);
+
+    std::string tail;
+    footer.EncodeTo(tail);
+    BlockHandle footer_handle;
+    WriteRaw(tail, &footer_handle);
+
+    return ok_ && file_->Flush();
+}
+
+} // namespace VrootKV::io
@@ -0,0 +1,163 @@
+/**
+ * @file table_builder.h
+ * @author Vrutik Halani
+ * @brief Writes a complete SSTable (data blocks, filter, index, footer) to a file.
+ *
+ * Overview
+ * --------
+ * `TableBuilder` streams sorted key–value pairs into `DataBlockBuilder`s, cuts a
+ * new data block once the current one reaches `block_size`, and on `Finish()`
+ * appends the optional meta blocks (Bloom filter, range filter), a meta-index
+ * naming them, the index block and the fixed-size footer:
+ *
+ *   [data block 0]...[data block N][bloom][range][meta-index][index][footer (40 bytes)]
+ *
+ * The footer carries `SSTableFooter::kMetaIndexMagic`; its `filter_handle`
+ * points at the meta-index block.
+ *
+ * The index maps each data block's first key to its `BlockHandle`, matching the
+ * "rightmost divider <= key" routing of `IndexBlockReader::Find`.
+ *
+ * Filter sizing
+ * -------------
+ * Bits-per-key come from `options.filter_budget` for `options.level` when a
+ * budget is supplied (Monkey-style per-level allocation), otherwise from the
+ * fixed `options.bits_per_key`. A value <= 0 writes no Bloom filter block.
+ *
+ * Partitioned filters
+ * -------------------
+ * With `filter_partition_size > 0` the Bloom filter is split into partitions
+ * cut at data-block boundaries once a partition reaches roughly that many bytes.
+ * Each partition is written as soon as it is cut (so builder memory stays
+ * bounded), and a small top-level index maps each partition's first key to its
+ * handle; the meta-index names it "filter.partitioned". Readers keep only the
+ * top-level index resident and load the one partition covering a lookup key.
+ *
+ * A range filter (sorted key prefixes of `range_filter_prefix_len` bytes) is
+ * written when that option is non-zero, letting scans skip the table when no
+ * key can fall inside the scanned interval.
+ *
+ * Notes
+ * -----
+ *  - Keys must be strictly increasing; violations throw std::runtime_error.
+ *  - I/O failures are sticky: once a write fails, `Finish()` returns false.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "sstable_blocks.h"
+#include "VrootKV/common/filter_budget.h"
+#include "VrootKV/common/range_filter.h"
+#include "VrootKV/io/file_manager.h"
+#include "VrootKV/io/sstable_format.h"
+
+namespace VrootKV::io {
+
+/**
+ * @struct TableBuilderOptions
+ * @brief Knobs for SSTable construction.
+ */
+struct TableBuilderOptions {
+    /// Target uncompressed size of a data block before a new one is started.
+    std::size_t block_size = 4096;
+
+    /// Restart interval passed to each `DataBlockBuilder`.
+    int restart_interval = 16;
+
+    /// LSM level the table is written to (selects the per-level filter budget).
+    int level = 0;
+
+    /// Optional per-level filter allocation. Not owned; must outlive the builder.
+    const common::FilterBudget* filter_budget = nullptr;
+
+    /// Fixed bits-per-key used when `filter_budget` is null. <= 0 disables the filter.
+    double bits_per_key = 10.0;
+
+    /// Target serialized size of one filter partition. 0 writes a single filter block.
+    std::size_t filter_partition_size = 0;
+
+    /// Prefix length of the range filter meta block. 0 disables the range filter.
+    std::size_t range_filter_prefix_len = 0;
+};
+
+/**
+ * @class TableBuilder
+ * @brief Single-use writer that produces one SSTable file.
+ */
+class TableBuilder {
+public:
+    /**
+     * @param options Build options (copied).
+     * @param file    Destination file; not owned, must stay open until `Finish()`.
+     */
+    TableBuilder(const TableBuilderOptions& options, IWritableFile* file);
+
+    TableBuilder(const TableBuilder&) = delete;
+    TableBuilder& operator=(const TableBuilder&) = delete;
+
+    /**
+     * @brief Append a key–value pair. Keys must be strictly increasing.
+     * @throws std::runtime_error on ordering violations or after `Finish()`.
+     */
+    void Add(const std::string& key, const std::string& value);
+
+    /**
+     * @brief Flush the last data block and write filter, index and footer.
+     * @return true if every write succeeded.
+     */
+    bool Finish();
+
+    /// Number of entries added so far.
+    std::uint64_t NumEntries() const { return num_entries_; }
+
+    /// Bytes written to the file so far (final file size after `Finish()`).
+    std::uint64_t FileSize() const { return offset_; }
+
+    /// Serialized size of all Bloom filter data, including partitions and their
+    /// top-level index (0 if none was written).
+    std::uint64_t FilterSize() const { return filter_size_; }
+
+    /// Number of filter partitions written (0 for a monolithic filter).
+    std::uint64_t NumFilterPartitions() const { return num_filter_partitions_; }
+
+    /// Serialized size of the range filter block (0 if none was written).
+    std::uint64_t RangeFilterSize() const { return range_filter_size_; }
+
+    /// Bits-per-key the filter was (or will be) built with.
+    double FilterBitsPerKey() const { return bits_per_key_; }
+
+private:
+    void FlushDataBlock();
+    void CutFilterPartition();
+    bool partitioned() const { return options_.filter_partition_size > 0 && bits_per_key_ > 0; }
+    bool WriteRaw(const std::string& bytes, BlockHandle* handle);
+
+    TableBuilderOptions options_;
+    IWritableFile* file_;
+    double bits_per_key_;
+
+    DataBlockBuilder data_block_;
+    IndexBlockBuilder index_block_;
+    std::string pending_first_key_;        ///< First key of the block being built.
+    bool block_empty_ = true;
+
+    std::vector<std::string> filter_keys_; ///< Keys collected for the (current partition's) filter.
+    IndexBlockBuilder filter_partition_index_;
+    std::uint64_t num_filter_partitions_ = 0;
+    std::optional<common::RangeFilter> range_filter_;
+    std::string last_key_;
+    std::uint64_t num_entries_ = 0;
+    std::uint64_t offset_ = 0;
+    std::uint64_t filter_size_ = 0;
+    std::uint64_t range_filter_size_ = 0;
+    bool ok_ = true;
+    bool finished_ = false;
+};
+
+} // namespace VrootKV::io
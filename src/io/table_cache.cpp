@@ -0,0 +1,65 @@
+/**
+ * @file table_cache.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of the open-table cache.
+ *
+ * Two threads missing on the same table may both open it; `Insert()` keeps
+ * the first reader and the loser's copy is simply dropped. That is cheaper
+ * than serializing every open behind a per-table lock.
+ */
+
+#include "table_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+namespace VrootKV::io {
+
+std::string TableFileName(const std::string& dbname, uint64_t number) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "/%06llu.sst", static_cast<unsigned long long>(number));
+    return dbname + buf;
+}
+
+TableCache::TableCache(IFileManager* file_manager, std::string dbname, const TableCacheOptions& options)
+    : file_manager_(file_manager),
+      dbname_(std::move(dbname)),
+      options_(options),
+      cache_(std::max<std::size_t>(1, options.max_open_tables), options.num_shard_bits),
+      block_cache_id_base_(options.table_options.block_cache ? options.table_options.block_cache->NewId() : 0) {}
+
+std::shared_ptr<TableReader> TableCache::FindTable(uint64_t file_number) {
+    if (auto table = cache_.Lookup(file_number)) return table;
+
+    const std::string fname = TableFileName(dbname_, file_number);
+    std::unique_ptr<IRandomAccessFile> file;
+    if (!file_manager_->NewRandomAccessFile(fname, file, options_.file_options)) {
+        throw std::runtime_error("TableCache: cannot open table file " + fname);
+    }
+    table_opens_.fetch_add(1, std::memory_order_relaxed);
+    TableReaderOptions table_options = options_.table_options;
+    if (table_options.block_cache) {
+        // Stable per-file id: a table reopened after eviction finds its blocks still cached.
+        table_options.block_cache_id = (block_cache_id_base_ << 32) | (file_number & 0xffffffffull);
+    }
+    std::shared_ptr<TableReader> table = TableReader::Open(std::move(file), table_options);
+    return cache_.Insert(file_number, std::move(table));
+}
+
+bool TableCache::Get(uint64_t file_number, std::string_view key, std::string& value,
+                     const ReadOptions& read_options) {
+    return FindTable(file_number)->Get(key, value, read_options);
+}
+
+std::unique_ptr<common::Iterator> TableCache::NewIterator(uint64_t file_number,
+                                                          const ReadOptions& read_options) {
+    std::shared_ptr<TableReader> table = FindTable(file_number);
+    return table->NewIterator(read_options, table);
+}
+
+void TableCache::Evict(uint64_t file_number) {
+    cache_.Erase(file_number);
+}
+
+} // namespace VrootKV::io
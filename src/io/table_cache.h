@@ -0,0 +1,119 @@
+/**
+ * @file table_cache.h
+ * @author Vrutik Halani
+ * @brief Bounded cache of open SSTable readers, keyed by file number.
+ *
+ * Opening a table costs an open() plus reads of the footer, index and filter
+ * blocks; doing that per lookup is ruinous, while keeping every table open
+ * exhausts descriptors and memory. `TableCache` keeps at most
+ * `max_open_tables` readers open in a sharded LRU (`ShardedLRUCache`). Each
+ * cached `TableReader` owns its random-access file, the parsed index block
+ * and the Bloom filter, so a lookup on a warm table performs no open, stat or
+ * metadata read.
+ *
+ * Readers are shared (`std::shared_ptr`): evicting a table only drops the
+ * cache's reference, and the file is closed once the last in-flight lookup
+ * releases it.
+ *
+ * With a block cache in `table_options`, each table's block-cache id is
+ * derived from its file number, so a table evicted here and reopened later
+ * still hits the blocks it left in the block cache.
+ *
+ * Notes
+ * -----
+ *  - Table files are named `<dbname>/<number, 6+ digits>.sst` (`TableFileName`).
+ *  - A missing or malformed table throws std::runtime_error; it is never
+ *    cached, so a later call retries the open.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "../common/sharded_cache.h"
+#include "table_reader.h"
+#include "VrootKV/io/file_manager.h"
+
+namespace VrootKV::io {
+
+/// Path of table `number` inside `dbname` (e.g. "db/000042.sst").
+std::string TableFileName(const std::string& dbname, uint64_t number);
+
+struct TableCacheOptions {
+    /// Upper bound on simultaneously open tables (and thus table descriptors).
+    std::size_t max_open_tables = 1000;
+    /// log2 of the number of cache shards.
+    int num_shard_bits = 4;
+    /// Options for opening table files (point lookups: random access by default).
+    FileOptions file_options = [] {
+        FileOptions o;
+        o.access_pattern = AccessPattern::kRandom;
+        return o;
+    }();
+    TableReaderOptions table_options;
+};
+
+/**
+ * @class TableCache
+ * @brief Thread-safe map from table file number to a shared, open `TableReader`.
+ */
+class TableCache {
+public:
+    /**
+     * @param file_manager Used to open table files; not owned, must outlive the cache.
+     * @param dbname Directory holding the table files.
+     */
+    TableCache(IFileManager* file_manager, std::string dbname,
+               const TableCacheOptions& options = TableCacheOptions());
+
+    TableCache(const TableCache&) = delete;
+    TableCache& operator=(const TableCache&) = delete;
+
+    /**
+     * @brief Return the open reader for `file_number`, opening it on a miss.
+     * @throws std::runtime_error if the file is missing or malformed.
+     */
+    std::shared_ptr<TableReader> FindTable(uint64_t file_number);
+
+    /**
+     * @brief Point lookup in table `file_number`.
+     * @return true and fills `value` if `key` is present.
+     * @throws std::runtime_error on open or read failure.
+     */
+    bool Get(uint64_t file_number, std::string_view key, std::string& value,
+             const ReadOptions& read_options = ReadOptions());
+
+    /**
+     * @brief Ordered iterator over table `file_number`; it keeps the reader
+     *        open even if the table is evicted meanwhile.
+     * @throws std::runtime_error on open failure.
+     */
+    std::unique_ptr<common::Iterator> NewIterator(uint64_t file_number,
+                                                  const ReadOptions& read_options = ReadOptions());
+
+    /**
+     * @brief Drop the table from the cache (e.g. after compaction deleted it).
+     */
+    void Evict(uint64_t file_number);
+
+    /// Number of tables currently held open by the cache.
+    std::size_t OpenTables() const { return cache_.Size(); }
+
+    /// Number of table opens performed (cache misses) since construction.
+    uint64_t table_opens() const { return table_opens_.load(std::memory_order_relaxed); }
+
+private:
+    IFileManager* file_manager_;
+    const std::string dbname_;
+    const TableCacheOptions options_;
+    common::ShardedLRUCache<uint64_t, TableReader> cache_;
+    /// Upper 32 bits of the block-cache ids of this cache's tables.
+    const uint64_t block_cache_id_base_;
+    std::atomic<uint64_t> table_opens_{0};
+};
+
+} // namespace VrootKV::io
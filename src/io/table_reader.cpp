@@ -0,0 +1,442 @@
+/**
+ * @file table_reader.cpp
+ * @author Vrutik Halani
+ * @brief Implementation of `TableReader`: footer/index/filter parsing, Get() and iteration.
+ */
+
+#include "table_reader.h"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+namespace VrootKV::io {
+
+namespace {
+
+/**
+ * @brief `IRandomAccessFile` over an in-memory copy of a table file.
+ */
+class StringRandomAccessFile final : public IRandomAccessFile {
+public:
+    explicit StringRandomAccessFile(std::string contents) : contents_(std::move(contents)) {}
+
+    bool Read(uint64_t offset, size_t n, char* /*scratch*/, std::string_view* result) const override {
+        if (offset > contents_.size()) return false;
+        *result = std::string_view(contents_).substr(static_cast<size_t>(offset), n);
+        return true;
+    }
+
+    uint64_t Size() const override { return contents_.size(); }
+    bool ReadsInPlace() const override { return true; }
+    bool Close() override { return true; }
+
+private:
+    std::string contents_;
+};
+
+} // namespace
+
+std::unique_ptr<TableReader> TableReader::Open(std::unique_ptr<IRandomAccessFile> file,
+                                               const TableReaderOptions& options) {
+    return std::unique_ptr<TableReader>(new TableReader(std::move(file), options));
+}
+
+std::unique_ptr<TableReader> TableReader::Open(std::string contents,
+                                               const TableReaderOptions& options) {
+    return Open(std::make_unique<StringRandomAccessFile>(std::move(contents)), options);
+}
+
+/**
+ * @brief Read and parse footer, index and resident filter data.
+ */
+TableReader::TableReader(std::unique_ptr<IRandomAccessFile> file, const TableReaderOptions& options)
+    : options_(options), file_(std::move(file)) {
+    const uint64_t size = file_->Size();
+    if (size < SSTableFooter::kEncodedLength) {
+        throw std::runtime_error("TableReader: file too small");
+    }
+    const std::string footer_bytes =
+        ReadBlockContents(BlockHandle{size - SSTableFooter::kEncodedLength, SSTableFooter::kEncodedLength});
+    std::string_view tail = footer_bytes;
+    footer_ = SSTableFooter::DecodeFrom(tail);
+    if (!footer_.HasValidMagic()) {
+        throw std::runtime_error("TableReader: bad magic");
+    }
+
+    index_contents_ = ReadBlockContents(footer_.index_handle);
+    index_.emplace(index_contents_);
+    if (footer_.magic == SSTableFooter::kMetaIndexMagic) {
+        ReadMetaIndex();
+    } else {
+        filter_handle_ = footer_.filter_handle;
+    }
+    if (filter_handle_.size > 0 && !partition_index_) {
+        filter_.emplace(common::BloomFilter::Deserialize(ReadBlockContents(filter_handle_)));
+    }
+    if (options_.block_cache) {
+        cache_id_ = options_.block_cache_id != 0 ? options_.block_cache_id : options_.block_cache->NewId();
+    }
+}
+
+/**
+ * @brief Resolve the meta blocks named in the meta-index block.
+ *
+ * Unknown names are ignored so newer writers stay readable.
+ */
+void TableReader::ReadMetaIndex() {
+    const std::string meta_contents = ReadBlockContents(footer_.filter_handle);
+    IndexBlockReader meta(meta_contents);
+    std::string name;
+    BlockHandle handle;
+    for (uint32_t i = 0; i < meta.size(); ++i) {
+        if (!meta.EntryAt(i, name, handle)) {
+            throw std::runtime_error("TableReader: corrupt meta-index");
+        }
+        if (name == kBloomFilterMetaName) {
+            filter_handle_ = handle;
+        } else if (name == kPartitionedFilterMetaName) {
+            partition_index_contents_ = ReadBlockContents(handle);
+            partition_index_.emplace(partition_index_contents_);
+            filter_handle_ = handle;
+        } else if (name == kRangeFilterMetaName) {
+            range_filter_.emplace(common::RangeFilter::Deserialize(ReadBlockContents(handle)));
+        }
+    }
+}
+
+/**
+ * @brief Bounds-checked positional read of exactly one block.
+ *
+ * The returned view points into `*scratch` or, for memory-mapped / in-memory
+ * files, directly into the file's storage (no copy, `*scratch` untouched).
+ * @throws std::runtime_error if the handle is out of range or the read fails/short-reads.
+ */
+std::string_view TableReader::ReadBlock(const BlockHandle& handle, std::string* scratch) const {
+    const uint64_t size = file_->Size();
+    if (handle.offset > size || handle.size > size - handle.offset) {
+        throw std::runtime_error("TableReader: block handle out of range");
+    }
+    const size_t n = static_cast<size_t>(handle.size);
+    char* buf = nullptr;
+    if (!file_->ReadsInPlace()) {
+        scratch->resize(n);
+        buf = scratch->data();
+    }
+    std::string_view got;
+    if (!file_->Read(handle.offset, n, buf, &got) || got.size() != n) {
+        throw std::runtime_error("TableReader: block read failed");
+    }
+    return got;
+}
+
+/**
+ * @brief Read one block into owned storage (for blocks kept for the reader's lifetime).
+ */
+std::string TableReader::ReadBlockContents(const BlockHandle& handle) const {
+    std::string buf;
+    const std::string_view got = ReadBlock(handle, &buf);
+    if (got.data() != buf.data()) {
+        buf.assign(got.data(), got.size());
+    }
+    return buf;
+}
+
+/**
+ * @brief Fetch a data block, through the block cache when one is configured.
+ *
+ * On a cache hit (or after inserting a miss) `*pin` holds the block so the
+ * returned view stays valid while the caller parses it.
+ */
+std::string_view TableReader::DataBlock(const BlockHandle& handle, std::string* scratch, CachedBlock* pin,
+                                        const ReadOptions& read_options) const {
+    if (!UseBlockCache()) {
+        data_block_reads_.fetch_add(1, std::memory_order_relaxed);
+        return ReadBlock(handle, scratch);
+    }
+    const BlockCacheKey key{cache_id_, handle.offset};
+    *pin = options_.block_cache->Lookup(key, read_options.cache_priority);
+    if (*pin != nullptr) return **pin;
+    data_block_reads_.fetch_add(1, std::memory_order_relaxed);
+    if (!read_options.fill_cache) return ReadBlock(handle, scratch);
+    *pin = options_.block_cache->Insert(key, ReadBlockContents(handle), read_options.cache_priority);
+    return **pin;
+}
+
+/**
+ * @brief Return the filter partition at `handle`, loading it on a cache miss.
+ */
+std::shared_ptr<const common::BloomFilter>
+TableReader::FilterPartition(const BlockHandle& handle) const {
+    std::lock_guard<std::mutex> lock(partition_mu_);
+    auto it = partition_map_.find(handle.offset);
+    if (it != partition_map_.end()) {
+        partition_lru_.splice(partition_lru_.begin(), partition_lru_, it->second);
+        return it->second->second;
+    }
+
+    auto filter = std::make_shared<const common::BloomFilter>(
+        common::BloomFilter::Deserialize(ReadBlockContents(handle)));
+    ++partition_loads_;
+    partition_lru_.emplace_front(handle.offset, filter);
+    partition_map_[handle.offset] = partition_lru_.begin();
+    while (partition_lru_.size() > std::max<std::size_t>(1, options_.filter_partition_cache_size)) {
+        partition_map_.erase(partition_lru_.back().first);
+        partition_lru_.pop_back();
+    }
+    return filter;
+}
+
+std::uint64_t TableReader::filter_partition_loads() const {
+    std::lock_guard<std::mutex> lock(partition_mu_);
+    return partition_loads_;
+}
+
+std::vector<std::string> TableReader::IndexKeys() const {
+    std::vector<std::string> keys;
+    if (!index_) return keys;
+    keys.reserve(index_->size());
+    std::string key;
+    BlockHandle handle;
+    for (uint32_t i = 0; i < index_->size(); ++i) {
+        if (!index_->EntryAt(i, key, handle)) throw std::runtime_error("TableReader: corrupt index entry");
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+bool TableReader::KeyMayMatch(std::string_view key) const {
+    if (filter_) return filter_->might_contain(key);
+    if (partition_index_) {
+        BlockHandle handle;
+        // Keys before the first partition cannot be in the table.
+        if (!partition_index_->Find(key, handle)) return false;
+        return FilterPartition(handle)->might_contain(key);
+    }
+    return true;
+}
+
+bool TableReader::RangeMayMatch(std::string_view lo, std::string_view hi) const {
+    return !range_filter_ || range_filter_->may_contain_range(lo, hi);
+}
+
+bool TableReader::Get(std::string_view key, std::string& value, const ReadOptions& read_options) const {
+    if (!KeyMayMatch(key)) return false;
+
+    BlockHandle handle;
+    if (!index_->Find(key, handle)) return false;
+
+    std::string scratch;
+    CachedBlock pin;
+    DataBlockReader block(DataBlock(handle, &scratch, &pin, read_options));
+    return block.Get(key, value);
+}
+
+std::vector<bool> TableReader::MultiGet(const std::vector<std::string_view>& keys,
+                                        std::vector<std::string>* values, IAsyncIO* io,
+                                        const ReadOptions& read_options) const {
+    std::vector<bool> found(keys.size(), false);
+    values->resize(keys.size());
+
+    // Group keys by the data block that may hold them (ordered by file offset).
+    std::map<uint64_t, std::pair<BlockHandle, std::vector<size_t>>> blocks;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        BlockHandle handle;
+        if (!KeyMayMatch(keys[i]) || !index_->Find(keys[i], handle)) continue;
+        auto& slot = blocks[handle.offset];
+        slot.first = handle;
+        slot.second.push_back(i);
+    }
+    if (blocks.empty()) return found;
+
+    // Resolve cached blocks first; only the misses go to the device.
+    if (UseBlockCache()) {
+        for (auto it = blocks.begin(); it != blocks.end();) {
+            CachedBlock pin = options_.block_cache->Lookup(BlockCacheKey{cache_id_, it->first},
+                                                           read_options.cache_priority);
+            if (pin == nullptr) {
+                ++it;
+                continue;
+            }
+            DataBlockReader block(*pin);
+            for (size_t i : it->second.second) {
+                found[i] = block.Get(keys[i], (*values)[i]);
+            }
+            it = blocks.erase(it);
+        }
+        if (blocks.empty()) return found;
+    }
+
+    const uint64_t file_size = file_->Size();
+    std::vector<AsyncReadRequest> requests;
+    std::vector<std::string> scratch(blocks.size());
+    requests.reserve(blocks.size());
+    for (const auto& entry : blocks) {
+        const BlockHandle& handle = entry.second.first;
+        if (handle.offset > file_size || handle.size > file_size - handle.offset) {
+            throw std::runtime_error("TableReader: block handle out of range");
+        }
+        AsyncReadRequest req;
+        req.file = file_.get();
+        req.offset = handle.offset;
+        req.n = static_cast<size_t>(handle.size);
+        if (!file_->ReadsInPlace()) {
+            std::string& buf = scratch[requests.size()];
+            buf.resize(req.n);
+            req.scratch = buf.data();
+        }
+        requests.push_back(req);
+    }
+    data_block_reads_.fetch_add(requests.size(), std::memory_order_relaxed);
+
+    if (io != nullptr) {
+        io->SubmitReads(requests.data(), requests.size()).get();
+    } else {
+        for (auto& req : requests) {
+            req.ok = file_->Read(req.offset, req.n, req.scratch, &req.result);
+        }
+    }
+
+    size_t r = 0;
+    for (const auto& entry : blocks) {
+        const AsyncReadRequest& req = requests[r++];
+        if (!req.ok || req.result.size() != req.n) {
+            throw std::runtime_error("TableReader: block read failed");
+        }
+        CachedBlock pin;
+        std::string_view contents = req.result;
+        if (UseBlockCache() && read_options.fill_cache) {
+            std::string& buf = scratch[r - 1];
+            if (req.result.data() != buf.data()) buf.assign(req.result);
+            pin = options_.block_cache->Insert(BlockCacheKey{cache_id_, entry.first}, std::move(buf),
+                                               read_options.cache_priority);
+            contents = *pin;
+        }
+        DataBlockReader block(contents);
+        for (size_t i : entry.second.second) {
+            found[i] = block.Get(keys[i], (*values)[i]);
+        }
+    }
+    return found;
+}
+
+// ============================================================================
+// TableIterator — block-at-a-time cursor
+// ============================================================================
+
+/**
+ * @class TableIterator
+ * @brief Walks index entries and decodes one data block at a time.
+ *
+ * The current block is copied out of the cache / file into `entries_`, so no
+ * block-cache pin is held between calls.
+ */
+class TableIterator final : public common::Iterator {
+public:
+    TableIterator(const TableReader* table, const ReadOptions& read_options,
+                  std::shared_ptr<const TableReader> keep_alive)
+        : table_(table), read_options_(read_options), keep_alive_(std::move(keep_alive)),
+          num_blocks_(table->index_->size()) {}
+
+    bool Valid() const override { return pos_ < entries_.size(); }
+
+    void SeekToFirst() override {
+        if (!LoadBlock(0)) return;
+        SkipEmptyBlocksForward();
+    }
+
+    void SeekToLast() override {
+        if (!LoadBlock(num_blocks_ - 1)) return;
+        SkipEmptyBlocksBackward();
+    }
+
+    void Seek(std::string_view target) override {
+        // Rightmost block whose first key is <= target (or the first block).
+        uint32_t lo = 0, hi = num_blocks_;
+        std::string first_key;
+        BlockHandle handle;
+        while (hi - lo > 1) {
+            const uint32_t mid = lo + (hi - lo) / 2;
+            if (!table_->index_->EntryAt(mid, first_key, handle)) {
+                throw std::runtime_error("TableIterator: corrupt index entry");
+            }
+            if (std::string_view(first_key) <= target) lo = mid; else hi = mid;
+        }
+        if (!LoadBlock(lo)) return;
+        pos_ = static_cast<size_t>(
+            std::lower_bound(entries_.begin(), entries_.end(), target,
+                             [](const auto& e, std::string_view t) { return std::string_view(e.first) < t; }) -
+            entries_.begin());
+        SkipEmptyBlocksForward();
+    }
+
+    void Next() override {
+        ++pos_;
+        SkipEmptyBlocksForward();
+    }
+
+    void Prev() override {
+        if (pos_ > 0) {
+            --pos_;
+            return;
+        }
+        if (block_ == 0) {
+            entries_.clear();
+            return;
+        }
+        LoadBlock(block_ - 1);
+        SkipEmptyBlocksBackward();
+    }
+
+    std::string_view key() const override { return entries_[pos_].first; }
+    std::string_view value() const override { return entries_[pos_].second; }
+
+private:
+    /// Decode block `idx` into `entries_`; false (and invalid) if out of range.
+    bool LoadBlock(uint32_t idx) {
+        entries_.clear();
+        pos_ = 0;
+        if (idx >= num_blocks_) return false;
+        std::string first_key;
+        BlockHandle handle;
+        if (!table_->index_->EntryAt(idx, first_key, handle)) {
+            throw std::runtime_error("TableIterator: corrupt index entry");
+        }
+        std::string scratch;
+        CachedBlock pin;
+        DataBlockReader(table_->DataBlock(handle, &scratch, &pin, read_options_)).ReadAll(entries_);
+        block_ = idx;
+        return true;
+    }
+
+    /// Advance to the next block while positioned past the end of the current one.
+    void SkipEmptyBlocksForward() {
+        while (pos_ >= entries_.size()) {
+            if (!LoadBlock(block_ + 1)) return;
+        }
+    }
+
+    /// Position at the last entry of the current block, or of an earlier one if it is empty.
+    void SkipEmptyBlocksBackward() {
+        while (entries_.empty()) {
+            if (block_ == 0 || !LoadBlock(block_ - 1)) return;
+        }
+        pos_ = entries_.size() - 1;
+    }
+
+    const TableReader* table_;
+    const ReadOptions read_options_;
+    std::shared_ptr<const TableReader> keep_alive_;
+    const uint32_t num_blocks_;
+    uint32_t block_ = 0;  ///< Index of the block held in `entries_`.
+    std::vector<std::pair<std::string, std::string>> entries_;
+    size_t pos_ = 0;      ///< Position in `entries_`; == size() means invalid.
+};
+
+std::unique_ptr<common::Iterator> TableReader::NewIterator(const ReadOptions& read_options,
+                                                           std::shared_ptr<const TableReader> keep_alive) const {
+    return std::make_unique<TableIterator>(this, read_options, std::move(keep_alive));
+}
+
+} // namespace VrootKV::io
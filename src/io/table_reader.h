@@ -0,0 +1,239 @@
+/**
+ * @file table_reader.h
+ * @author Vrutik Halani
+ * @brief Point lookups against a complete SSTable written by `TableBuilder`.
+ *
+ * Lookup path
+ * -----------
+ *   1) Bloom filter (if present): a negative answer ends the lookup with no
+ *      data-block access.
+ *   2) Index block: route to the data block whose first key is the rightmost
+ *      one <= the search key.
+ *   3) Data block: restart-point binary search plus a short scan.
+ *
+ * Partitioned filters keep only the small top-level partition index resident;
+ * the partition covering a lookup key is deserialized on first use and held
+ * in a bounded per-table LRU (`TableReaderOptions::filter_partition_cache_size`).
+ *
+ * Range scans call `RangeMayMatch(lo, hi)` first: when the table carries a
+ * range filter meta block and no key can fall in [lo, hi], the table is
+ * skipped without touching its data blocks.
+ *
+ * Both footer layouts are accepted: legacy tables whose `filter_handle` is the
+ * Bloom filter itself, and meta-index tables (see `SSTableFooter`).
+ *
+ * The reader counts data-block reads so callers and tests can measure the
+ * I/O a filter configuration actually saves.
+ *
+ * With `TableReaderOptions::block_cache`, data blocks are looked up in the
+ * shared cache first and pinned for the duration of the lookup; only misses
+ * are read from the file (and counted) and then inserted. `ReadOptions`
+ * lets bulk reads skip the insert or use low cache priority.
+ *
+ * `NewIterator()` walks the table in key order (forward or backward) one
+ * data block at a time; each block is fetched through the same cache path
+ * and decoded whole when the iterator enters it.
+ *
+ * I/O
+ * ---
+ * The table is read through an `IRandomAccessFile`: `Open()` reads only the
+ * footer, index block and resident filter data; each data block (and filter
+ * partition) is fetched with one positional read of exactly its `BlockHandle`.
+ * When the file is memory-mapped (`FileOptions::use_mmap_reads`), data blocks
+ * are parsed in place without copying. The reader owns the file, so the
+ * mapping is released when the last owner of the table drops it.
+ * All lookups are thread-safe, so one reader can serve many threads.
+ *
+ * Notes
+ * -----
+ *  - Malformed files throw std::runtime_error from `Open()`; I/O errors during
+ *    `Get()` throw as well (a failed read must not look like a missing key).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "block_cache.h"
+#include "sstable_blocks.h"
+#include "VrootKV/common/bloom_filter.h"
+#include "VrootKV/common/iterator.h"
+#include "VrootKV/common/range_filter.h"
+#include "VrootKV/io/async_io.h"
+#include "VrootKV/io/file_manager.h"
+#include "VrootKV/io/sstable_format.h"
+
+namespace VrootKV::io {
+
+/**
+ * @struct TableReaderOptions
+ * @brief Knobs for opening an SSTable.
+ */
+struct TableReaderOptions {
+    /// Maximum number of filter partitions kept deserialized per table.
+    std::size_t filter_partition_cache_size = 8;
+
+    /// Shared cache for data blocks; null disables caching. Unused for
+    /// memory-mapped files, whose blocks are already read in place.
+    std::shared_ptr<BlockCache> block_cache;
+
+    /// Identity of this table in `block_cache`; 0 draws a fresh one
+    /// (`BlockCache::NewId()`), so a reopened table starts cold.
+    uint64_t block_cache_id = 0;
+};
+
+/**
+ * @struct ReadOptions
+ * @brief Per-read block-cache behaviour.
+ */
+struct ReadOptions {
+    /// Insert data blocks read from the file into the block cache. Turn off
+    /// for one-off bulk reads whose blocks will not be read again.
+    bool fill_cache = true;
+    /// `kLow` for scans: cache lookups and inserts then leave the hot set alone.
+    CachePriority cache_priority = CachePriority::kHigh;
+};
+
+/**
+ * @class TableReader
+ * @brief Immutable, thread-safe view over one SSTable.
+ */
+class TableReader {
+public:
+    /**
+     * @brief Open a table over a random-access file (reads footer, index, filter).
+     * @param file Open table file; owned by the reader from now on.
+     * @throws std::runtime_error if the file cannot be read or is malformed.
+     */
+    static std::unique_ptr<TableReader> Open(std::unique_ptr<IRandomAccessFile> file,
+                                             const TableReaderOptions& options = TableReaderOptions());
+
+    /**
+     * @brief Open a table from its complete file contents held in memory.
+     * @throws std::runtime_error if the footer, index or filter is malformed.
+     */
+    static std::unique_ptr<TableReader> Open(std::string contents,
+                                             const TableReaderOptions& options = TableReaderOptions());
+
+    TableReader(const TableReader&) = delete;
+    TableReader& operator=(const TableReader&) = delete;
+
+    /**
+     * @brief Exact-match lookup.
+     * @return true and fills `value` if `key` is present.
+     */
+    bool Get(std::string_view key, std::string& value, const ReadOptions& read_options = ReadOptions()) const;
+
+    /**
+     * @brief Batched lookup: every data block the keys need is read in one async batch.
+     *
+     * Keys are filtered and located through the index first; each distinct
+     * block is then fetched once via `io` (so the device sees the whole batch
+     * at once), and all keys are resolved against the fetched blocks.
+     * @param keys Keys to look up, in any order.
+     * @param values Resized to `keys.size()`; `(*values)[i]` is set when key i is found.
+     * @param io Async engine; if null, blocks are read synchronously one by one.
+     * @return Per-key found flags, parallel to `keys`.
+     * @throws std::runtime_error if any block read fails.
+     */
+    std::vector<bool> MultiGet(const std::vector<std::string_view>& keys,
+                               std::vector<std::string>* values, IAsyncIO* io,
+                               const ReadOptions& read_options = ReadOptions()) const;
+
+    /**
+     * @brief Ordered cursor over every entry of the table.
+     * @param keep_alive Optional owner of this reader, held by the iterator so
+     *        the reader may be dropped elsewhere (e.g. evicted from a cache)
+     *        while the iterator is in use. Without it, the reader must
+     *        outlive the iterator.
+     */
+    std::unique_ptr<common::Iterator> NewIterator(const ReadOptions& read_options = ReadOptions(),
+                                                  std::shared_ptr<const TableReader> keep_alive = nullptr) const;
+
+    /**
+     * @brief Divider key of every data block, in order.
+     *
+     * Read from the resident index (no I/O); each key stands for roughly
+     * `file size / keys` bytes, which makes them cheap split points for
+     * dividing work over a table by key range.
+     */
+    std::vector<std::string> IndexKeys() const;
+
+    /**
+     * @brief Filter-only check: false means `key` is definitely absent.
+     */
+    bool KeyMayMatch(std::string_view key) const;
+
+    /**
+     * @brief Range check over the inclusive interval [lo, hi].
+     * @return false if no key of this table can lie in [lo, hi]; true if unknown
+     *         (no range filter) or possible.
+     */
+    bool RangeMayMatch(std::string_view lo, std::string_view hi) const;
+
+    /// True if the table carries a Bloom filter (monolithic or partitioned).
+    bool HasFilter() const { return filter_.has_value() || partition_index_.has_value(); }
+
+    /// True if the Bloom filter is split into on-demand partitions.
+    bool HasPartitionedFilter() const { return partition_index_.has_value(); }
+
+    /// True if the table carries a range filter block.
+    bool HasRangeFilter() const { return range_filter_.has_value(); }
+
+    /// Serialized size of the filter data kept resident: the whole Bloom filter,
+    /// or only the top-level partition index for partitioned filters.
+    std::uint64_t FilterSize() const { return filter_handle_.size; }
+
+    /// Number of filter partitions deserialized since construction (cache misses).
+    std::uint64_t filter_partition_loads() const;
+
+    /// Number of data blocks read from the file by `Get()` / `MultiGet()`
+    /// since construction (block-cache hits are not counted).
+    std::uint64_t data_block_reads() const { return data_block_reads_.load(std::memory_order_relaxed); }
+
+private:
+    friend class TableIterator;
+
+    TableReader(std::unique_ptr<IRandomAccessFile> file, const TableReaderOptions& options);
+
+    std::string_view ReadBlock(const BlockHandle& handle, std::string* scratch) const;
+    std::string ReadBlockContents(const BlockHandle& handle) const;
+    std::string_view DataBlock(const BlockHandle& handle, std::string* scratch, CachedBlock* pin,
+                               const ReadOptions& read_options) const;
+    bool UseBlockCache() const { return options_.block_cache != nullptr && !file_->ReadsInPlace(); }
+    void ReadMetaIndex();
+    std::shared_ptr<const common::BloomFilter> FilterPartition(const BlockHandle& handle) const;
+
+    using PartitionLru = std::list<std::pair<std::uint64_t, std::shared_ptr<const common::BloomFilter>>>;
+
+    TableReaderOptions options_;
+    std::unique_ptr<IRandomAccessFile> file_;
+    uint64_t cache_id_ = 0;                  ///< Key prefix in `options_.block_cache`.
+    SSTableFooter footer_;
+    std::string index_contents_;             ///< Backing bytes for `index_`.
+    std::optional<IndexBlockReader> index_;
+    BlockHandle filter_handle_;
+    std::optional<common::BloomFilter> filter_;
+    std::optional<common::RangeFilter> range_filter_;
+    std::string partition_index_contents_;   ///< Backing bytes for `partition_index_`.
+    std::optional<IndexBlockReader> partition_index_;
+
+    // Partition cache: LRU list (front = most recent) keyed by block offset.
+    mutable std::mutex partition_mu_;
+    mutable PartitionLru partition_lru_;
+    mutable std::unordered_map<std::uint64_t, PartitionLru::iterator> partition_map_;
+    mutable std::uint64_t partition_loads_ = 0;
+    mutable std::atomic<std::uint64_t> data_block_reads_{0};
+};
+
+} // namespace VrootKV::io
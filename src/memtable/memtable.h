@@ -0,0 +1,225 @@
+/**
+ * @file memtable.h
+ * @author Vrutik Halani
+ * @brief Active Memtable: SkipList storage with tombstones and an optional Bloom filter.
+ *
+ * Overview
+ * --------
+ * `MemTable` is the write buffer in front of the SSTables. It stores the latest
+ * operation per key in a `SkipList`:
+ *
+ *   value = [tag: u8][user value bytes]     tag = kTypeValue | kTypeDeletion
+ *
+ * so a lookup can distinguish "found", "deleted here" (stop searching older
+ * data) and "not present" (continue to the SSTables).
+ *
+ * Bloom filter
+ * ------------
+ * Most point lookups miss the memtable, yet each miss costs a full skip-list
+ * descent (~log n pointer-chasing string comparisons). When
+ * `MemTableOptions::bloom_expected_entries > 0`, every key written is also
+ * added to a `BloomFilter` sized for that many entries; `Get()` consults it
+ * first and returns kNotFound without touching the skip list on a negative.
+ * The filter only ever produces false positives, so correctness never depends
+ * on it. Writing more keys than expected just raises its false-positive rate.
+ *
+ * Iterators
+ * ---------
+ * `NewIterator()` walks the skip list in place behind a bidirectional
+ * `common::Iterator`, with values still tag-prefixed so merged views can see
+ * tombstones. It shows the memtable as of its creation (the skip list keeps
+ * the versions it needs) and may hold the memtable alive through
+ * `keep_alive`, so the DB can hand it to a reader while writes continue.
+ *
+ * Threading
+ * ---------
+ * - Iterators may be used concurrently with one writer, like the underlying
+ *   `SkipList`.
+ * - `Put()`, `Delete()` and `Get()` need external synchronization: the filter
+ *   is a plain bitset updated on writes, and the byte and skip counters are
+ *   plain integers.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "skip_list.h"
+#include "VrootKV/common/bloom_filter.h"
+#include "VrootKV/common/iterator.h"
+
+namespace VrootKV::memtable {
+
+/**
+ * @struct MemTableOptions
+ * @brief Construction knobs for a `MemTable`.
+ */
+struct MemTableOptions {
+    /// Expected number of distinct keys; sizes the Bloom filter. 0 disables it.
+    std::size_t bloom_expected_entries = 0;
+
+    /// Target false-positive rate of the Bloom filter at `bloom_expected_entries`.
+    double bloom_false_positive_rate = 0.01;
+};
+
+class MemTable {
+public:
+    /// Outcome of a point lookup.
+    enum class LookupResult {
+        kFound,     ///< Live value found; `value` is filled.
+        kDeleted,   ///< A tombstone shadows older data for this key.
+        kNotFound   ///< Key not present in this memtable.
+    };
+
+    /// Single-byte tags prefixed to stored values.
+    static constexpr char kTypeDeletion = 0;
+    static constexpr char kTypeValue    = 1;
+
+    /**
+     * @brief Ordered iterator over the newest entry of each key, as of its creation.
+     */
+    class Iterator {
+    public:
+        bool Valid() const noexcept { return it_.Valid(); }
+        void Next() noexcept { it_.Next(); }
+        const std::string& key() const noexcept { return it_.key(); }
+
+        /// True if the current entry is a tombstone.
+        bool IsDeletion() const noexcept { return it_.value()[0] == kTypeDeletion; }
+
+        /// User value of the current entry (empty for tombstones).
+        std::string value() const { return it_.value().substr(1); }
+
+    private:
+        friend class MemTable;
+        explicit Iterator(SkipList::Iterator it) : it_(it) {}
+        SkipList::Iterator it_;
+    };
+
+    explicit MemTable(const MemTableOptions& options = MemTableOptions()) {
+        if (options.bloom_expected_entries > 0) {
+            bloom_.emplace(options.bloom_expected_entries, options.bloom_false_positive_rate);
+        }
+    }
+
+    MemTable(const MemTable&) = delete;
+    MemTable& operator=(const MemTable&) = delete;
+
+    /** @brief Insert or overwrite `key` with `value`. */
+    void Put(const std::string& key, const std::string& value) {
+        Apply(key, kTypeValue, value);
+    }
+
+    /** @brief Record a tombstone for `key`. */
+    void Delete(const std::string& key) {
+        Apply(key, kTypeDeletion, std::string());
+    }
+
+    /**
+     * @brief Look up the newest operation for `key`.
+     * @param value Filled only when the result is kFound.
+     */
+    LookupResult Get(const std::string& key, std::string& value) const {
+        if (bloom_ && !bloom_->might_contain(key)) {
+            ++bloom_skips_;
+            return LookupResult::kNotFound;
+        }
+        std::string stored;
+        if (!list_.Get(key, stored)) {
+            return LookupResult::kNotFound;
+        }
+        if (stored[0] == kTypeDeletion) {
+            return LookupResult::kDeleted;
+        }
+        value.assign(stored, 1, std::string::npos);
+        return LookupResult::kFound;
+    }
+
+    /** @brief Iterator positioned at the smallest key. */
+    Iterator Begin() const noexcept { return Iterator(list_.Begin()); }
+
+    /** @brief Iterator positioned at the first key >= target. */
+    Iterator Seek(const std::string& target) const noexcept { return Iterator(list_.Seek(target)); }
+
+    /**
+     * @brief Bidirectional iterator over the current contents, read in place.
+     *
+     * Values keep their tag byte (`kTypeValue` / `kTypeDeletion`). Later
+     * writes are invisible to it. Nothing is copied; the iterator starts
+     * unpositioned and moves through the skip list on demand.
+     * @param keep_alive Optional owner of this memtable, held by the iterator so
+     *                   it may outlive the caller's reference.
+     */
+    std::unique_ptr<common::Iterator> NewIterator(std::shared_ptr<const MemTable> keep_alive = nullptr) const {
+        return std::make_unique<ListIterator>(list_.NewIterator(), std::move(keep_alive));
+    }
+
+    /// Number of distinct keys (including tombstones).
+    std::size_t size() const noexcept { return list_.size(); }
+    bool empty() const noexcept { return list_.empty(); }
+
+    /// Approximate bytes held: keys, tagged values and per-node overhead, plus
+    /// the Bloom filter bitset. Overwritten values stay counted, as in an arena.
+    std::size_t ApproximateMemoryUsage() const noexcept {
+        return bytes_ + (bloom_ ? bloom_->byte_size() : 0);
+    }
+
+    /// True if lookups are guarded by a Bloom filter.
+    bool HasBloomFilter() const noexcept { return bloom_.has_value(); }
+
+    /// Lookups answered by the Bloom filter alone (skip-list walk avoided).
+    std::uint64_t bloom_skips() const noexcept { return bloom_skips_; }
+
+private:
+    /// `common::Iterator` over the skip list, yielding tagged values.
+    class ListIterator final : public common::Iterator {
+    public:
+        ListIterator(SkipList::Iterator it, std::shared_ptr<const MemTable> keep_alive)
+            : keep_alive_(std::move(keep_alive)), it_(it) {}
+
+        bool Valid() const override { return it_.Valid(); }
+        void SeekToFirst() override { it_.SeekToFirst(); }
+        void SeekToLast() override { it_.SeekToLast(); }
+        void Seek(std::string_view target) override {
+            target_.assign(target);
+            it_.Seek(target_);
+        }
+        void Next() override { it_.Next(); }
+        void Prev() override { it_.Prev(); }
+        std::string_view key() const override { return it_.key(); }
+        std::string_view value() const override { return it_.value(); }
+
+    private:
+        std::shared_ptr<const MemTable> keep_alive_;  ///< Declared first: outlives `it_`.
+        SkipList::Iterator it_;
+        std::string target_;  ///< Seek key as a `SkipList::Key` (reused buffer).
+    };
+
+    // Rough per-node cost: node object plus a couple of forward pointers.
+    static constexpr std::size_t kNodeOverhead = sizeof(std::string) * 2 + 4 * sizeof(void*);
+
+    void Apply(const std::string& key, char tag, const std::string& value) {
+        std::string stored;
+        stored.reserve(1 + value.size());
+        stored.push_back(tag);
+        stored.append(value);
+        if (list_.Put(key, stored)) {
+            bytes_ += key.size() + kNodeOverhead;
+            if (bloom_) bloom_->add(key);
+        }
+        bytes_ += stored.size();
+    }
+
+    SkipList list_;
+    std::optional<common::BloomFilter> bloom_;
+    std::size_t bytes_ = 0;
+    mutable std::uint64_t bloom_skips_ = 0;
+};
+
+} // namespace VrootKV::memtable
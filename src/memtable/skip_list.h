@@ -1,14 +1,14 @@
 /**
  * @file skip_list.h
  * @author Vrutik Halani
- * @brief Single-threaded Skip List for the Memtable (sorted in-memory KV).
+ * @brief Skip List for the Memtable: one writer, any number of concurrent readers.
  *
  * Overview
  * --------
- * This header implements a **standard (single-threaded) Skip List** that stores
- * sorted key-value pairs (std::string -> std::string). It is intended to be used
- * by the Memtable module in Phase 1 (single-threaded) of the storage engine.
- * A later module will introduce a concurrent variant using atomics/CAS.
+ * This header implements a Skip List that stores sorted key-value pairs
+ * (std::string -> std::string) for the Memtable. Writes must be serialized by
+ * the caller, but they may run concurrently with lookups and iterators, so a
+ * reader never has to copy the list or hold the writer's lock.
  *
  * Characteristics
  * ---------------
@@ -19,18 +19,35 @@
  *      • Put/Upsert (insert or overwrite)
  *      • Get / Contains
  *      • Erase
- *      • Ordered iteration (forward only) and point Seek
+ *      • Ordered bidirectional iteration and point Seek
  *
  * Design
  * ------
  * - A fixed MAX_LEVEL tower height and geometric level promotion with p = 1/4.
  * - A sentinel head node with MAX_LEVEL forward pointers.
- * - `findGreaterOrEqual()` collects per-level predecessors to splice nodes in/out.
+ * - `findGreaterOrEqual()` collects per-level predecessors to splice nodes in.
+ * - Nodes have no back links; `Prev()` re-descends from the head (O(log n)).
+ *
+ * Versions
+ * --------
+ * Each write is stamped with the next sequence number. A node's value is a
+ * chain of immutable versions, newest first: `Put()` on an existing key
+ * pushes a new version instead of overwriting the old one, which a reader may
+ * be copying. An iterator remembers the sequence current when it was created
+ * and shows only what had been written by then: nodes inserted later are
+ * skipped and overwritten keys read the version it saw. Old versions are
+ * freed with their node, so overwrites cost memory until `Clear()`, the way
+ * an arena would.
  *
  * Threading
  * ---------
- * - **Not thread-safe.** Intended for single-threaded use (Module 1.3.2).
- *   The concurrent version (Module 3.1.1) will replace pointers with atomics.
+ * - One writer (`Insert()`, `Put()`) may run concurrently with any number of
+ *   readers (`Get()`, `Contains()`, iterators). Writers need external
+ *   synchronization among themselves.
+ * - A node is fully built before it is linked in. Links are published with
+ *   release stores and followed with acquire loads, level 0 first, so a
+ *   reader that reaches a node sees its key and value (as in LevelDB).
+ * - `Erase()` and `Clear()` free nodes and need exclusive access.
  *
  * Memory
  * ------
@@ -39,6 +56,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -55,6 +73,7 @@ class SkipList {
 private:
     // Forward declaration MUST appear before Iterator uses Node.
     struct Node;
+    struct Version;
 
 public:
     // --------- Public types ---------
@@ -62,7 +81,7 @@ public:
     using Value = std::string;
 
     /**
-     * @brief Read-only forward iterator over key/value pairs in sorted order.
+     * @brief Read-only bidirectional iterator over key/value pairs in sorted order.
      *
      * Usage:
      *   SkipList sl;
@@ -70,7 +89,8 @@ public:
      *       // use it.key(), it.value()
      *   }
      *
-     * NOTE: Iterator is invalidated by structural modifications (insert/erase).
+     * Shows the list as of its creation (see "Versions"); concurrent `Put()`s
+     * do not invalidate it, `Erase()` and `Clear()` do.
      */
     class Iterator {
     public:
@@ -81,20 +101,51 @@ public:
 
         /** @brief Advance to the next item (no-op if already end). */
         void Next() noexcept {
-            if (node_) node_ = node_->next_[0];
+            if (node_) Settle(node_->Next(0));
+        }
+
+        /** @brief Step back to the previous item (end if this was the first). */
+        void Prev() noexcept {
+            if (node_) SettleBackward(list_->findLessThan(node_->key));
         }
 
+        /** @brief Position at the first entry with key >= target. */
+        void Seek(const Key& target) noexcept { Settle(list_->findGreaterOrEqual(target)); }
+
+        /** @brief Position at the smallest key. */
+        void SeekToFirst() noexcept { Settle(list_->head_->Next(0)); }
+
+        /** @brief Position at the largest key. */
+        void SeekToLast() noexcept { SettleBackward(list_->findLast()); }
+
         /** @brief Access the current key. Precondition: Valid() == true. */
         const Key& key() const noexcept { return node_->key; }
 
         /** @brief Access the current value. Precondition: Valid() == true. */
-        const Value& value() const noexcept { return node_->value; }
+        const Value& value() const noexcept { return version_->data; }
 
     private:
         friend class SkipList;
         // Only SkipList can construct it with an internal Node*.
-        explicit Iterator(Node* n) : node_(n) {}
-        Node* node_ = nullptr;
+        Iterator(const SkipList* list, std::uint64_t sequence, const Node* n)
+            : list_(list), sequence_(sequence) { Settle(n); }
+
+        /// Land on `n` or the first later node visible at `sequence_`.
+        void Settle(const Node* n) noexcept {
+            while (n && (version_ = n->VersionAt(sequence_)) == nullptr) n = n->Next(0);
+            node_ = n;
+        }
+
+        /// Land on `n` or the first earlier node visible at `sequence_`.
+        void SettleBackward(const Node* n) noexcept {
+            while (n && (version_ = n->VersionAt(sequence_)) == nullptr) n = list_->findLessThan(n->key);
+            node_ = n;
+        }
+
+        const SkipList* list_ = nullptr;
+        std::uint64_t sequence_ = 0;
+        const Node* node_ = nullptr;
+        const Version* version_ = nullptr;
     };
 
     // --------- Construction / rule-of-five ---------
@@ -111,6 +162,7 @@ public:
               p_den_(p_denominator),
               level_(1),
               size_(0),
+              sequence_(0),
               rng_(std::random_device{}()),
               dist_(0, p_denominator - 1) {
         if (max_level_ < 1) max_level_ = 1;
@@ -119,7 +171,6 @@ public:
             p_num_ = 1; p_den_ = 4;
         }
         head_ = new Node(max_level_);
-        for (int i = 0; i < max_level_; ++i) head_->next_[i] = nullptr;
     }
 
     /** @brief Destroy the list and free all nodes. */
@@ -133,23 +184,23 @@ public:
     // --------- Basic queries ---------
 
     /** @brief Number of elements in the list. */
-    std::size_t size() const noexcept { return size_; }
+    std::size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
 
     /** @brief True if empty. */
-    bool empty() const noexcept { return size_ == 0; }
+    bool empty() const noexcept { return size() == 0; }
 
-    /** @brief Remove all entries and reset to empty. */
+    /** @brief Remove all entries and reset to empty. Needs exclusive access. */
     void Clear() noexcept {
         // Delete level-0 chain.
-        Node* cur = head_->next_[0];
+        Node* cur = head_->Next(0);
         while (cur) {
-            Node* nxt = cur->next_[0];
+            Node* nxt = cur->Next(0);
             delete cur;
             cur = nxt;
         }
-        for (int i = 0; i < max_level_; ++i) head_->next_[i] = nullptr;
-        level_ = 1;
-        size_  = 0;
+        for (int i = 0; i < max_level_; ++i) head_->SetNext(i, nullptr);
+        level_.store(1, std::memory_order_relaxed);
+        size_.store(0, std::memory_order_relaxed);
     }
 
     // --------- Lookup / access ---------
@@ -164,13 +215,13 @@ public:
     }
 
     /**
-     * @brief Get the value for key if present.
+     * @brief Get the newest value for key if present.
      * @return true on success; false if key missing.
      */
     bool Get(const Key& key, Value& out_value) const {
         const Node* x = findGreaterOrEqual(key);
         if (x && x->key == key) {
-            out_value = x->value;
+            out_value = x->Newest()->data;
             return true;
         }
         return false;
@@ -188,117 +239,186 @@ public:
         if (x && x->key == key) {
             return false;  // do not overwrite on Insert()
         }
-        int lvl = randomLevel();
-        if (lvl > level_) {
-            for (int i = level_; i < lvl; ++i) update[i] = head_;
-            level_ = lvl;
-        }
-        Node* n = new Node(lvl, key, value);
-        for (int i = 0; i < lvl; ++i) {
-            n->next_[i] = update[i]->next_[i];
-            update[i]->next_[i] = n;
-        }
-        ++size_;
+        Link(key, value, update);
         return true;
     }
 
     /**
-     * @brief Upsert (insert or assign). If key exists, updates value in-place.
+     * @brief Upsert (insert or assign). If key exists, pushes a newer version.
      * @return true if a new key was inserted; false if it was an overwrite.
      */
     bool Put(const Key& key, const Value& value) {
         std::vector<Node*> update(max_level_, nullptr);
         Node* x = findGreaterOrEqualMut(key, update);
         if (x && x->key == key) {
-            x->value = value;
+            const std::uint64_t seq = sequence_.load(std::memory_order_relaxed) + 1;
+            x->value_.store(new Version{value, seq, x->Newest()}, std::memory_order_release);
+            sequence_.store(seq, std::memory_order_release);
             return false; // overwrite
         }
-        int lvl = randomLevel();
-        if (lvl > level_) {
-            for (int i = level_; i < lvl; ++i) update[i] = head_;
-            level_ = lvl;
-        }
-        Node* n = new Node(lvl, key, value);
-        for (int i = 0; i < lvl; ++i) {
-            n->next_[i] = update[i]->next_[i];
-            update[i]->next_[i] = n;
-        }
-        ++size_;
+        Link(key, value, update);
         return true; // inserted
     }
 
     /**
-     * @brief Erase key if present.
+     * @brief Erase key if present. Needs exclusive access.
      * @return true if a node was removed; false if key not found.
      */
     bool Erase(const Key& key) {
         std::vector<Node*> update(max_level_, nullptr);
+        const int level = level_.load(std::memory_order_relaxed);
         Node* x = head_;
         // Collect predecessors at each level so we can splice out the node.
-        for (int i = level_ - 1; i >= 0; --i) {
-            while (x->next_[i] && x->next_[i]->key < key) {
-                x = x->next_[i];
+        for (int i = level - 1; i >= 0; --i) {
+            while (x->Next(i) && x->Next(i)->key < key) {
+                x = x->Next(i);
             }
             update[i] = x;
         }
-        x = x->next_[0];
+        x = x->Next(0);
         if (!x || x->key != key) {
             return false;
         }
-        for (int i = 0; i < level_; ++i) {
-            if (update[i]->next_[i] == x) {
-                update[i]->next_[i] = x->next_[i];
+        for (int i = 0; i < level; ++i) {
+            if (update[i]->Next(i) == x) {
+                update[i]->SetNext(i, x->Next(i));
             }
         }
         delete x;
-        --size_;
+        size_.fetch_sub(1, std::memory_order_relaxed);
         // Reduce overall level if top levels become empty.
-        while (level_ > 1 && head_->next_[level_ - 1] == nullptr) {
-            --level_;
+        int top = level;
+        while (top > 1 && head_->Next(top - 1) == nullptr) {
+            --top;
         }
+        level_.store(top, std::memory_order_relaxed);
         return true;
     }
 
     // --------- Iteration ---------
 
     /** @brief Iterator to the first (smallest) key. */
-    Iterator Begin() const noexcept { return Iterator(head_->next_[0]); }
+    Iterator Begin() const noexcept { return Iterator(this, Sequence(), head_->Next(0)); }
+
+    /** @brief Unpositioned iterator (Valid()==false until a seek) over the list as of now. */
+    Iterator NewIterator() const noexcept { return Iterator(this, Sequence(), nullptr); }
 
     /**
      * @brief Create an iterator positioned at the first entry with key >= target.
      * @details If all keys are less than target, returns an end() iterator (Valid()==false).
      */
     Iterator Seek(const Key& target) const noexcept {
-        return Iterator(const_cast<Node*>(findGreaterOrEqual(target)));
+        const std::uint64_t seq = Sequence();
+        return Iterator(this, seq, findGreaterOrEqual(target));
     }
 
 private:
     // --------- Node definition (kept private) ---------
+
+    /// One immutable value of a key, linked to the one it replaced.
+    struct Version {
+        Value data;
+        std::uint64_t sequence;  ///< Write that created it.
+        const Version* older;
+    };
+
     struct Node {
-        explicit Node(int lvl)
-            : next_(static_cast<std::size_t>(lvl), nullptr) {}
-        Node(int lvl, Key k, Value v)
-            : key(std::move(k)), value(std::move(v)), next_(static_cast<std::size_t>(lvl), nullptr) {}
-        Key key;
-        Value value;
-        std::vector<Node*> next_; // forward pointers of size == node level
+        explicit Node(int lvl) : next_(static_cast<std::size_t>(lvl)) {
+            for (auto& p : next_) p.store(nullptr, std::memory_order_relaxed);
+        }
+        Node(int lvl, Key k, const Version* v) : Node(lvl) {
+            key = std::move(k);
+            value_.store(v, std::memory_order_relaxed);
+        }
+        ~Node() {
+            const Version* v = value_.load(std::memory_order_relaxed);
+            while (v) {
+                const Version* older = v->older;
+                delete v;
+                v = older;
+            }
+        }
+
+        Node* Next(int i) const noexcept { return next_[i].load(std::memory_order_acquire); }
+        void SetNext(int i, Node* n) noexcept { next_[i].store(n, std::memory_order_release); }
+        /// For links of a node no reader can reach yet.
+        void NoBarrierSetNext(int i, Node* n) noexcept { next_[i].store(n, std::memory_order_relaxed); }
+
+        const Version* Newest() const noexcept { return value_.load(std::memory_order_acquire); }
+
+        /// Newest version written at or before `seq`, or nullptr if none.
+        const Version* VersionAt(std::uint64_t seq) const noexcept {
+            const Version* v = Newest();
+            while (v && v->sequence > seq) v = v->older;
+            return v;
+        }
+
+        Key key;  ///< Immutable once linked.
+        std::atomic<const Version*> value_{nullptr};
+        std::vector<std::atomic<Node*>> next_; // forward pointers of size == node level
     };
 
     // --------- Internal helpers ---------
 
+    std::uint64_t Sequence() const noexcept { return sequence_.load(std::memory_order_acquire); }
+
+    /// Build a node for `key` and publish it after the predecessors in `update`.
+    void Link(const Key& key, const Value& value, std::vector<Node*>& update) {
+        const std::uint64_t seq = sequence_.load(std::memory_order_relaxed) + 1;
+        const int lvl = randomLevel();
+        const int level = level_.load(std::memory_order_relaxed);
+        if (lvl > level) {
+            for (int i = level; i < lvl; ++i) update[i] = head_;
+            // A reader seeing the new height before the node just finds
+            // nullptr head links up there and drops a level.
+            level_.store(lvl, std::memory_order_relaxed);
+        }
+        Node* n = new Node(lvl, key, new Version{value, seq, nullptr});
+        for (int i = 0; i < lvl; ++i) {
+            n->NoBarrierSetNext(i, update[i]->Next(i));
+            update[i]->SetNext(i, n);
+        }
+        size_.fetch_add(1, std::memory_order_relaxed);
+        sequence_.store(seq, std::memory_order_release);
+    }
+
     /**
      * @brief Return the first node with key >= target (or nullptr if none).
      * @details Non-modifying search used by Contains/Get/Seek.
      */
     const Node* findGreaterOrEqual(const Key& target) const noexcept {
         const Node* x = head_;
-        for (int i = level_ - 1; i >= 0; --i) {
-            while (x->next_[i] && x->next_[i]->key < target) {
-                x = x->next_[i];
+        for (int i = level_.load(std::memory_order_relaxed) - 1; i >= 0; --i) {
+            const Node* next;
+            while ((next = x->Next(i)) != nullptr && next->key < target) {
+                x = next;
             }
         }
-        x = x->next_[0];
-        return x;
+        return x->Next(0);
+    }
+
+    /// Return the last node with key < target (or nullptr if none).
+    const Node* findLessThan(const Key& target) const noexcept {
+        const Node* x = head_;
+        for (int i = level_.load(std::memory_order_relaxed) - 1; i >= 0; --i) {
+            const Node* next;
+            while ((next = x->Next(i)) != nullptr && next->key < target) {
+                x = next;
+            }
+        }
+        return x == head_ ? nullptr : x;
+    }
+
+    /// Return the last node (or nullptr if empty).
+    const Node* findLast() const noexcept {
+        const Node* x = head_;
+        for (int i = level_.load(std::memory_order_relaxed) - 1; i >= 0; --i) {
+            const Node* next;
+            while ((next = x->Next(i)) != nullptr) {
+                x = next;
+            }
+        }
+        return x == head_ ? nullptr : x;
     }
 
     /**
@@ -309,14 +429,13 @@ private:
      */
     Node* findGreaterOrEqualMut(const Key& target, std::vector<Node*>& update) noexcept {
         Node* x = head_;
-        for (int i = level_ - 1; i >= 0; --i) {
-            while (x->next_[i] && x->next_[i]->key < target) {
-                x = x->next_[i];
+        for (int i = level_.load(std::memory_order_relaxed) - 1; i >= 0; --i) {
+            while (x->Next(i) && x->Next(i)->key < target) {
+                x = x->Next(i);
             }
             update[i] = x;
         }
-        x = x->next_[0];
-        return x;
+        return x->Next(0);
     }
 
     /**
@@ -338,16 +457,19 @@ private:
     int p_num_;
     int p_den_;
 
-    // Current tallest level in the list (1..max_level_)
-    int level_;
+    // Current tallest level in the list (1..max_level_); only a search hint for readers
+    std::atomic<int> level_;
 
     // Element count
-    std::size_t size_;
+    std::atomic<std::size_t> size_;
+
+    // Sequence number of the last completed write
+    std::atomic<std::uint64_t> sequence_;
 
     // Sentinel head node with max_level_ forward pointers
     Node* head_;
 
-    // PRNG for level selection
+    // PRNG for level selection (writer only)
     std::mt19937 rng_;
     std::uniform_int_distribution<int> dist_;
 };
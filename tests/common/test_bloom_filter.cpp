@@ -11,6 +11,7 @@
 
 #include <gtest/gtest.h>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -105,3 +106,94 @@ TEST(BloomFilter, FalsePositiveRateWithinConfiguredBound) {
     EXPECT_LE(measured, target_fpp * 1.8)
         << "Measured FPR=" << measured << " exceeds acceptable bound.";
 }
+
+/**
+ * @brief FPR on longer, structured keys (16–64 bytes with long shared prefixes).
+ *
+ * Exercises every branch of the single-pass 128-bit hash (chunk loop and all
+ * tail widths) and checks the fastrange reduction keeps probes well spread.
+ */
+TEST(BloomFilter, FalsePositiveRate_LongStructuredKeys) {
+    const std::size_t N = 20000;
+    const double target_fpp = 0.01;
+    BloomFilter bf(N, target_fpp);
+
+    auto make_key = [](std::size_t i) {
+        std::string k = "user:tenant-0042:object/" + std::to_string(i);
+        k.resize(16 + (i % 49), '#');   // lengths 16..64
+        k += std::to_string(i);
+        return k;
+    };
+
+    for (std::size_t i = 0; i < N; ++i) bf.add(make_key(i));
+    for (std::size_t i = 0; i < N; ++i) ASSERT_TRUE(bf.might_contain(make_key(i)));
+
+    std::size_t false_positives = 0;
+    const std::size_t M = 20000;
+    for (std::size_t i = N; i < N + M; ++i) {
+        if (bf.might_contain(make_key(i))) ++false_positives;
+    }
+    const double measured = static_cast<double>(false_positives) / static_cast<double>(M);
+    EXPECT_LE(measured, target_fpp * 1.8)
+        << "Measured FPR=" << measured << " exceeds acceptable bound.";
+}
+
+/**
+ * @brief New filters serialize as format version 2.
+ */
+TEST(BloomFilter, SerializesCurrentVersion) {
+    BloomFilter bf(100, 0.01);
+    bf.add("k");
+    EXPECT_EQ(bf.format_version(), BloomFilter::kCurrentVersion);
+
+    const std::string dump = bf.serialize();
+    ASSERT_GE(dump.size(), 8u);
+    EXPECT_EQ(static_cast<unsigned char>(dump[4]), BloomFilter::kCurrentVersion);
+}
+
+/**
+ * @brief Version 1 filters remain readable and round-trip unchanged.
+ *
+ * A v1 buffer with every bit set must answer "maybe" for any key, one with no
+ * bits set must answer "no"; both must re-serialize byte-for-byte.
+ */
+TEST(BloomFilter, DeserializesLegacyVersion) {
+    auto make_v1 = [](std::uint64_t m_bits, std::uint32_t k, unsigned char fill) {
+        std::string out;
+        auto put32 = [&](std::uint32_t v) { for (int i = 0; i < 4; ++i) out.push_back(char((v >> (8 * i)) & 0xFF)); };
+        auto put64 = [&](std::uint64_t v) { for (int i = 0; i < 8; ++i) out.push_back(char((v >> (8 * i)) & 0xFF)); };
+        put32(0x46424B56u);
+        put32(1u);
+        put64(m_bits);
+        put32(k);
+        put32(0u);
+        out.append(static_cast<std::size_t>((m_bits + 7) / 8), static_cast<char>(fill));
+        return out;
+    };
+
+    const std::string full = make_v1(1000, 7, 0xFF);
+    BloomFilter all = BloomFilter::Deserialize(full);
+    EXPECT_EQ(all.format_version(), BloomFilter::kLegacyVersion);
+    EXPECT_TRUE(all.might_contain("anything"));
+    EXPECT_EQ(all.serialize(), full);
+
+    const std::string empty = make_v1(1000, 7, 0x00);
+    BloomFilter none = BloomFilter::Deserialize(empty);
+    EXPECT_FALSE(none.might_contain("anything"));
+    EXPECT_EQ(none.serialize(), empty);
+
+    // Adding to a legacy filter keeps using the legacy probe scheme.
+    none.add("anything");
+    EXPECT_TRUE(none.might_contain("anything"));
+    EXPECT_EQ(none.format_version(), BloomFilter::kLegacyVersion);
+}
+
+/**
+ * @brief Unknown format versions are rejected.
+ */
+TEST(BloomFilter, RejectsUnknownVersion) {
+    BloomFilter bf(100, 0.01);
+    std::string dump = bf.serialize();
+    dump[4] = 9;
+    EXPECT_THROW(BloomFilter::Deserialize(dump), std::runtime_error);
+}
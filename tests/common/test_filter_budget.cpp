@@ -0,0 +1,95 @@
+/**
+ * @file test_filter_budget.cpp
+ * @author Vrutik Halani
+ * @brief Unit tests for FilterBudget (Monkey-style per-level bits-per-key):
+ *   - Allocation respects the total memory budget.
+ *   - Smaller levels receive more bits per key than larger ones.
+ *   - Expected false-positive I/O beats a uniform allocation of the same memory.
+ *   - Runtime budget changes are reflected in subsequent queries.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include "VrootKV/common/filter_budget.h"
+
+using VrootKV::common::FilterBudget;
+
+namespace {
+
+double TotalBits(const std::vector<std::uint64_t>& n, const std::vector<double>& b) {
+    double total = 0;
+    for (std::size_t i = 0; i < n.size(); ++i) total += static_cast<double>(n[i]) * b[i];
+    return total;
+}
+
+} // namespace
+
+TEST(FilterBudget, AllocationUsesBudgetAndFavorsSmallLevels) {
+    const std::vector<std::uint64_t> n = {10'000, 100'000, 1'000'000, 10'000'000};
+    const double keys = static_cast<double>(std::accumulate(n.begin(), n.end(), std::uint64_t{0}));
+    const double budget = 5.0 * keys;
+
+    const std::vector<double> bits = FilterBudget::Allocate(n, budget);
+    ASSERT_EQ(bits.size(), n.size());
+
+    EXPECT_NEAR(TotalBits(n, bits), budget, budget * 1e-6);
+    for (std::size_t i = 1; i < bits.size(); ++i) {
+        EXPECT_GT(bits[i - 1], bits[i]) << "level " << i;
+    }
+}
+
+TEST(FilterBudget, BeatsUniformAllocationAtSameMemory) {
+    const std::vector<std::uint64_t> n = {10'000, 100'000, 1'000'000, 10'000'000};
+    const double keys = static_cast<double>(std::accumulate(n.begin(), n.end(), std::uint64_t{0}));
+
+    for (double bpk : {2.0, 5.0, 10.0}) {
+        const std::vector<double> monkey = FilterBudget::Allocate(n, bpk * keys);
+        const std::vector<double> uniform(n.size(), bpk);
+        EXPECT_LT(FilterBudget::ExpectedFalsePositives(n, monkey),
+                  FilterBudget::ExpectedFalsePositives(n, uniform))
+            << "bits/key " << bpk;
+    }
+}
+
+TEST(FilterBudget, TinyBudgetDropsFiltersOnLargestLevels) {
+    const std::vector<std::uint64_t> n = {1'000, 1'000'000};
+    // Budget is ~1 bit per key in the small level only; the big level gets none.
+    const std::vector<double> bits = FilterBudget::Allocate(n, 8'000.0);
+    EXPECT_GT(bits[0], 0.0);
+    EXPECT_EQ(bits[1], 0.0);
+    EXPECT_NEAR(TotalBits(n, bits), 8'000.0, 1e-3);
+}
+
+TEST(FilterBudget, EmptyLevelsAndZeroBudget) {
+    const std::vector<std::uint64_t> n = {0, 5'000, 0};
+    const std::vector<double> bits = FilterBudget::Allocate(n, 50'000.0);
+    EXPECT_EQ(bits[0], 0.0);
+    EXPECT_NEAR(bits[1], 10.0, 1e-9);
+    EXPECT_EQ(bits[2], 0.0);
+
+    const std::vector<double> none = FilterBudget::Allocate(n, 0.0);
+    EXPECT_EQ(none[1], 0.0);
+    EXPECT_DOUBLE_EQ(FilterBudget::FalsePositiveRate(0.0), 1.0);
+}
+
+TEST(FilterBudget, RuntimeTunableBudget) {
+    FilterBudget budget(10.0);
+    // Unknown shape: uniform budget.
+    EXPECT_DOUBLE_EQ(budget.BitsPerKeyForLevel(3), 10.0);
+
+    budget.SetLevelEntries({1'000, 10'000, 100'000});
+    const double l0 = budget.BitsPerKeyForLevel(0);
+    const double l2 = budget.BitsPerKeyForLevel(2);
+    EXPECT_GT(l0, 10.0);
+    EXPECT_LT(l2, 10.0);
+
+    budget.SetBitsPerKey(4.0);
+    EXPECT_DOUBLE_EQ(budget.bits_per_key(), 4.0);
+    EXPECT_LT(budget.BitsPerKeyForLevel(2), l2);
+
+    // Levels beyond the published shape fall back to the uniform budget.
+    EXPECT_DOUBLE_EQ(budget.BitsPerKeyForLevel(7), 4.0);
+}
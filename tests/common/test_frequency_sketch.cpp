@@ -0,0 +1,67 @@
+/**
+ * @file test_frequency_sketch.cpp
+ * @author Vrutik Halani
+ * @brief Unit tests for the TinyLFU FrequencySketch:
+ *   - Estimates follow increments and saturate at kMaxCount.
+ *   - Frequently and rarely seen keys are told apart among many keys.
+ *   - Aging halves the counts after the sample period.
+ *   - Concurrent increments stay within bounds.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "src/common/frequency_sketch.h"
+
+using VrootKV::common::FrequencySketch;
+
+namespace {
+uint64_t H(uint64_t i) { return i * 0x9E3779B97F4A7C15ull + 12345; }
+} // namespace
+
+TEST(FrequencySketch, CountsAndSaturates) {
+    FrequencySketch sketch(1024);
+    EXPECT_EQ(sketch.Estimate(H(1)), 0u);
+    for (int i = 0; i < 5; ++i) sketch.Increment(H(1));
+    EXPECT_EQ(sketch.Estimate(H(1)), 5u);
+    for (int i = 0; i < 100; ++i) sketch.Increment(H(1));
+    EXPECT_EQ(sketch.Estimate(H(1)), FrequencySketch::kMaxCount);
+}
+
+TEST(FrequencySketch, SeparatesHotFromCold) {
+    FrequencySketch sketch(1000);
+    for (uint64_t i = 0; i < 1000; ++i) sketch.Increment(H(i));  // cold: once each
+    for (int r = 0; r < 8; ++r) {
+        for (uint64_t i = 0; i < 50; ++i) sketch.Increment(H(1000 + i));
+    }
+    int cold_over = 0;
+    for (uint64_t i = 0; i < 1000; ++i) cold_over += sketch.Estimate(H(i)) > 2;
+    for (uint64_t i = 0; i < 50; ++i) EXPECT_GE(sketch.Estimate(H(1000 + i)), 8u);
+    EXPECT_LT(cold_over, 20);  // collisions inflate very few cold keys
+}
+
+TEST(FrequencySketch, AgingHalvesCounts) {
+    FrequencySketch sketch(100);  // resets after 1000 increments
+    for (int i = 0; i < 12; ++i) sketch.Increment(H(7));
+    for (uint64_t i = 0; i < 1000; ++i) sketch.Increment(H(100 + i));
+    EXPECT_EQ(sketch.resets(), 1u);
+    EXPECT_GE(sketch.Estimate(H(7)), 5u);
+    EXPECT_LE(sketch.Estimate(H(7)), 7u);
+}
+
+TEST(FrequencySketch, ConcurrentIncrements) {
+    FrequencySketch sketch(4096);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&sketch] {
+            for (uint64_t i = 0; i < 50000; ++i) sketch.Increment(H(i % 3000));
+        });
+    }
+    for (auto& t : threads) t.join();
+    for (uint64_t i = 0; i < 3000; i += 97) {
+        EXPECT_LE(sketch.Estimate(H(i)), FrequencySketch::kMaxCount);
+    }
+    EXPECT_GT(sketch.resets(), 0u);
+}
@@ -0,0 +1,75 @@
+/**
+ * @file test_histogram.cpp
+ * @author Vrutik Halani
+ * @brief Unit tests for the log-linear Histogram:
+ *   - Bucket boundaries are contiguous and monotonic.
+ *   - Percentiles stay within the 12.5% bucket error on a uniform sample.
+ *   - Count/sum/min/max/mean, Merge() and Clear().
+ *   - Concurrent Add() from several threads loses no samples.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "VrootKV/common/histogram.h"
+
+using VrootKV::common::Histogram;
+
+TEST(Histogram, BucketsAreContiguous) {
+    for (size_t b = 0; b + 1 < Histogram::kNumBuckets; ++b) {
+        const uint64_t lo = Histogram::BucketLowerBound(b);
+        const uint64_t next = Histogram::BucketLowerBound(b + 1);
+        ASSERT_LT(lo, next);
+        EXPECT_EQ(Histogram::BucketFor(lo), b);
+        EXPECT_EQ(Histogram::BucketFor(next - 1), b);
+    }
+    EXPECT_EQ(Histogram::BucketFor(UINT64_MAX), Histogram::kNumBuckets - 1);
+}
+
+TEST(Histogram, PercentilesWithinBucketError) {
+    Histogram h;
+    for (uint64_t v = 1; v <= 100000; ++v) h.Add(v);
+    EXPECT_EQ(h.Count(), 100000u);
+    EXPECT_EQ(h.Min(), 1u);
+    EXPECT_EQ(h.Max(), 100000u);
+    EXPECT_DOUBLE_EQ(h.Mean(), 50000.5);
+    for (double p : {10.0, 50.0, 90.0, 99.0, 99.9}) {
+        const double expect = p * 1000.0;
+        EXPECT_NEAR(static_cast<double>(h.Percentile(p)), expect, expect * 0.125) << "p" << p;
+    }
+    EXPECT_EQ(h.Percentile(100.0), 100000u);
+}
+
+TEST(Histogram, MergeAndClear) {
+    Histogram a, b;
+    EXPECT_EQ(a.Percentile(50.0), 0u);
+    EXPECT_EQ(a.Min(), 0u);
+    a.Add(10);
+    b.Add(5);
+    b.Add(1000);
+    a.Merge(b);
+    EXPECT_EQ(a.Count(), 3u);
+    EXPECT_EQ(a.Sum(), 1015u);
+    EXPECT_EQ(a.Min(), 5u);
+    EXPECT_EQ(a.Max(), 1000u);
+    EXPECT_NE(a.ToString().find("count=3"), std::string::npos);
+    a.Clear();
+    EXPECT_EQ(a.Count(), 0u);
+    EXPECT_EQ(a.Max(), 0u);
+}
+
+TEST(Histogram, ConcurrentAdds) {
+    Histogram h;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&h, t] {
+            for (uint64_t i = 0; i < 50000; ++i) h.Add(i * 4 + t);
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(h.Count(), 200000u);
+    EXPECT_EQ(h.Min(), 0u);
+    EXPECT_EQ(h.Max(), 199999u);
+}
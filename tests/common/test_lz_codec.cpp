@@ -0,0 +1,95 @@
+/**
+ * @file test_lz_codec.cpp
+ * @author Vrutik Halani
+ * @brief Unit tests for the LZ77 block codec:
+ *   - Round trips of empty, short, repetitive, text-like and random inputs.
+ *   - Overlapping matches (runs) and long literal/match length encodings.
+ *   - Repetitive data actually shrinks; random data grows only slightly.
+ *   - Truncated or corrupted encodings throw instead of overrunning.
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "src/common/lz_codec.h"
+
+using VrootKV::common::LZCompress;
+using VrootKV::common::LZDecompress;
+
+namespace {
+
+std::string RoundTrip(const std::string& input, std::string* encoded = nullptr) {
+    std::string compressed;
+    LZCompress(input, &compressed);
+    std::string output = "stale";
+    LZDecompress(compressed, &output);
+    if (encoded != nullptr) *encoded = compressed;
+    return output;
+}
+
+std::string RandomBytes(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::string s(n, '\0');
+    for (char& c : s) c = static_cast<char>(rng());
+    return s;
+}
+
+} // namespace
+
+TEST(LZCodec, RoundTripsSmallInputs) {
+    for (const std::string input : {"", "a", "abc", "abcd", "abcdabcd", "hello, world"}) {
+        EXPECT_EQ(RoundTrip(input), input);
+    }
+}
+
+TEST(LZCodec, CompressesRepetitiveData) {
+    std::string input;
+    for (int i = 0; i < 500; ++i) input += "key" + std::to_string(i % 50) + "=value-payload;";
+    std::string encoded;
+    EXPECT_EQ(RoundTrip(input, &encoded), input);
+    EXPECT_LT(encoded.size(), input.size() / 4);
+}
+
+TEST(LZCodec, OverlappingRunsAndLongLengths) {
+    const std::string run(100000, 'x');          // offset-1 match far longer than 15 + 255
+    EXPECT_EQ(RoundTrip(run), run);
+
+    const std::string random = RandomBytes(5000, 1);  // one long literal run
+    const std::string mixed = random + std::string(3000, 'y') + random.substr(0, 700) + "tail";
+    EXPECT_EQ(RoundTrip(mixed), mixed);
+}
+
+TEST(LZCodec, IncompressibleDataGrowsLittle) {
+    const std::string input = RandomBytes(64 << 10, 7);
+    std::string encoded;
+    EXPECT_EQ(RoundTrip(input, &encoded), input);
+    EXPECT_LT(encoded.size(), input.size() + input.size() / 100 + 16);
+}
+
+TEST(LZCodec, MatchesBeyondTheWindowAreNotUsed) {
+    const std::string block = RandomBytes(1000, 3);
+    const std::string input = block + RandomBytes(70000, 4) + block;
+    EXPECT_EQ(RoundTrip(input), input);
+}
+
+TEST(LZCodec, CorruptInputThrows) {
+    std::string input;
+    for (int i = 0; i < 200; ++i) input += "abcdefgh" + std::to_string(i % 10);
+    std::string encoded;
+    LZCompress(input, &encoded);
+    std::string out;
+
+    EXPECT_THROW(LZDecompress(std::string_view(), &out), std::runtime_error);
+    EXPECT_THROW(LZDecompress(std::string_view(encoded).substr(0, encoded.size() / 2), &out),
+                 std::runtime_error);
+
+    std::string bad_size = encoded;
+    bad_size[0] = static_cast<char>(bad_size[0] ^ 0x01);  // header no longer matches the body
+    EXPECT_THROW(LZDecompress(bad_size, &out), std::runtime_error);
+
+    // A match reaching back before the start of the output.
+    const std::string bad_offset("\x08\x40" "abcd" "\xff\x00", 8);
+    EXPECT_THROW(LZDecompress(bad_offset, &out), std::runtime_error);
+}
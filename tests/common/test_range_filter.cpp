@@ -0,0 +1,95 @@
+/**
+ * @file test_range_filter.cpp
+ * @author Vrutik Halani
+ * @brief Unit tests for RangeFilter:
+ *   - No false negatives for ranges that contain inserted keys.
+ *   - Empty gaps wider than the prefix resolution are rejected.
+ *   - Serialization round-trip and corruption detection.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "VrootKV/common/range_filter.h"
+
+using VrootKV::common::RangeFilter;
+
+namespace {
+
+std::string UserKey(int user, int item) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "user%04d:item%05d", user, item);
+    return buf;
+}
+
+} // namespace
+
+TEST(RangeFilter, NoFalseNegatives) {
+    RangeFilter rf(8);
+    std::vector<std::string> keys;
+    for (int u = 0; u < 1000; u += 37) {
+        for (int i = 0; i < 20; ++i) keys.push_back(UserKey(u, i * 3));
+    }
+    for (const auto& k : keys) rf.add(k);
+
+    for (const auto& k : keys) {
+        EXPECT_TRUE(rf.might_contain(k));
+        EXPECT_TRUE(rf.may_contain_range(k, k + "~"));
+    }
+    // Range spanning several users always matches.
+    EXPECT_TRUE(rf.may_contain_range(UserKey(30, 0), UserKey(80, 0)));
+}
+
+TEST(RangeFilter, RejectsEmptyGaps) {
+    RangeFilter rf(8);
+    for (int u = 0; u < 1000; u += 100) {
+        for (int i = 0; i < 10; ++i) rf.add(UserKey(u, i));
+    }
+    EXPECT_EQ(rf.num_prefixes(), 10u);
+
+    // Whole users with no keys.
+    EXPECT_FALSE(rf.may_contain_range(UserKey(1, 0), UserKey(99, 99999)));
+    EXPECT_FALSE(rf.may_contain_range(UserKey(950, 0), UserKey(999, 0)));
+    // Before the first / after the last stored prefix.
+    EXPECT_FALSE(rf.may_contain_range("a", "b"));
+    EXPECT_FALSE(rf.may_contain_range("zz", "zzz"));
+    // Inverted interval.
+    EXPECT_FALSE(rf.may_contain_range(UserKey(500, 0), UserKey(400, 0)));
+    // Within a populated user, the prefix cannot tell items apart (false positive).
+    EXPECT_TRUE(rf.may_contain_range(UserKey(100, 50), UserKey(100, 60)));
+}
+
+TEST(RangeFilter, ShortKeysAndOrdering) {
+    RangeFilter rf(4);
+    rf.add("a");
+    rf.add("ab");
+    rf.add("abcdef");
+    rf.add("abcdzz");   // same 4-byte prefix, de-duplicated
+    EXPECT_EQ(rf.num_prefixes(), 3u);
+    EXPECT_TRUE(rf.might_contain("a"));
+    EXPECT_FALSE(rf.might_contain("b"));
+    EXPECT_THROW(rf.add("aa"), std::runtime_error);
+}
+
+TEST(RangeFilter, SerializationRoundTrip) {
+    RangeFilter rf(6);
+    for (int u = 0; u < 100; u += 3) rf.add(UserKey(u, 1));
+    const std::string dump = rf.serialize();
+
+    RangeFilter rf2 = RangeFilter::Deserialize(dump);
+    EXPECT_EQ(rf2.prefix_len(), 6u);
+    EXPECT_EQ(rf2.num_prefixes(), rf.num_prefixes());
+    EXPECT_EQ(rf2.serialize(), dump);
+    for (int u = 0; u < 100; ++u) {
+        EXPECT_EQ(rf.might_contain(UserKey(u, 1)), rf2.might_contain(UserKey(u, 1)));
+    }
+
+    std::string bad = dump;
+    bad[0] = 'X';
+    EXPECT_THROW(RangeFilter::Deserialize(bad), std::runtime_error);
+    EXPECT_THROW(RangeFilter::Deserialize(dump.substr(0, dump.size() - 1)), std::runtime_error);
+    EXPECT_THROW(RangeFilter::Deserialize("short"), std::runtime_error);
+}
@@ -0,0 +1,220 @@
+/**
+ * @file test_sharded_cache.cpp
+ * @author Vrutik Halani
+ * @brief Unit tests for ShardedLRUCache and ShardedClockCache:
+ *   - Least recently used entries are evicted first, by charge.
+ *   - Insert keeps the first value for a key; Erase removes it.
+ *   - Evicted values stay valid while a caller still holds them.
+ *   - CLOCK gives referenced entries a second chance; stats are counted.
+ *   - Concurrent lookups and inserts across shards.
+ *   - Low-priority lookups and inserts do not displace the hot set.
+ *   - The admission policy can refuse an insert that would evict.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/common/sharded_cache.h"
+
+using VrootKV::common::ShardedClockCache;
+using VrootKV::common::ShardedLRUCache;
+
+TEST(ShardedLRUCache, EvictsLeastRecentlyUsed) {
+    ShardedLRUCache<int, std::string> cache(3, /*num_shard_bits=*/0);
+    cache.Insert(1, std::make_shared<std::string>("one"));
+    cache.Insert(2, std::make_shared<std::string>("two"));
+    cache.Insert(3, std::make_shared<std::string>("three"));
+    ASSERT_NE(cache.Lookup(1), nullptr);  // 2 is now the LRU entry
+    cache.Insert(4, std::make_shared<std::string>("four"));
+
+    EXPECT_EQ(cache.Size(), 3u);
+    EXPECT_EQ(cache.Lookup(2), nullptr);
+    EXPECT_EQ(*cache.Lookup(1), "one");
+    EXPECT_EQ(*cache.Lookup(4), "four");
+}
+
+TEST(ShardedLRUCache, ChargeBasedCapacity) {
+    ShardedLRUCache<int, std::string> cache(100, 0);
+    cache.Insert(1, std::make_shared<std::string>("a"), 40);
+    cache.Insert(2, std::make_shared<std::string>("b"), 40);
+    cache.Insert(3, std::make_shared<std::string>("c"), 40);
+    EXPECT_EQ(cache.TotalCharge(), 80u);
+    EXPECT_EQ(cache.Lookup(1), nullptr);
+
+    // An entry larger than the whole shard is still admitted on its own.
+    cache.Insert(4, std::make_shared<std::string>("big"), 500);
+    EXPECT_EQ(cache.Size(), 1u);
+    EXPECT_EQ(cache.TotalCharge(), 500u);
+}
+
+TEST(ShardedLRUCache, InsertKeepsFirstAndErase) {
+    ShardedLRUCache<int, std::string> cache(10);
+    auto first = cache.Insert(7, std::make_shared<std::string>("first"));
+    auto second = cache.Insert(7, std::make_shared<std::string>("second"));
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(*second, "first");
+
+    cache.Erase(7);
+    cache.Erase(8);  // absent: no-op
+    EXPECT_EQ(cache.Lookup(7), nullptr);
+    EXPECT_EQ(cache.TotalCharge(), 0u);
+}
+
+TEST(ShardedLRUCache, PinnedValueSurvivesEviction) {
+    ShardedLRUCache<int, std::string> cache(1, 0);
+    std::shared_ptr<std::string> pinned = cache.Insert(1, std::make_shared<std::string>("pinned"));
+    cache.Insert(2, std::make_shared<std::string>("other"));
+    EXPECT_EQ(cache.Lookup(1), nullptr);
+    EXPECT_EQ(*pinned, "pinned");
+}
+
+TEST(ShardedLRUCache, ConcurrentAccess) {
+    ShardedLRUCache<int, int> cache(256, 4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t] {
+            for (int i = 0; i < 20000; ++i) {
+                const int key = (i * 7 + t) % 512;
+                auto v = cache.Lookup(key);
+                if (v == nullptr) v = cache.Insert(key, std::make_shared<int>(key));
+                ASSERT_EQ(*v, key);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    // Per-shard capacity is rounded up, so the total may slightly exceed 256.
+    EXPECT_LE(cache.Size(), 256u + 16u);
+}
+
+TEST(ShardedClockCache, SecondChanceAndStats) {
+    ShardedClockCache<int, int> cache(3, 0);
+    for (int k = 1; k <= 3; ++k) cache.Insert(k, std::make_shared<int>(k));
+    ASSERT_NE(cache.Lookup(1), nullptr);  // referenced: survives the next sweep
+    ASSERT_NE(cache.Lookup(3), nullptr);
+    cache.Insert(4, std::make_shared<int>(4));
+
+    EXPECT_EQ(cache.Size(), 3u);
+    EXPECT_EQ(cache.Lookup(2), nullptr);
+    EXPECT_NE(cache.Lookup(1), nullptr);
+    EXPECT_NE(cache.Lookup(4), nullptr);
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.inserts, 4u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.hits, 4u);
+    EXPECT_EQ(stats.misses, 1u);
+}
+
+TEST(ShardedClockCache, ChargeEraseAndPinning) {
+    ShardedClockCache<int, std::string> cache(100, 0);
+    auto pinned = cache.Insert(1, std::make_shared<std::string>("a"), 60);
+    cache.Insert(2, std::make_shared<std::string>("b"), 60);
+    EXPECT_EQ(cache.Lookup(1), nullptr);
+    EXPECT_EQ(*pinned, "a");
+    EXPECT_EQ(cache.TotalCharge(), 60u);
+
+    cache.Erase(2);
+    EXPECT_EQ(cache.TotalCharge(), 0u);
+    // Freed slots are reused.
+    for (int k = 10; k < 20; ++k) cache.Insert(k, std::make_shared<std::string>("x"), 10);
+    EXPECT_EQ(cache.Size(), 10u);
+    EXPECT_EQ(cache.TotalCharge(), 100u);
+}
+
+TEST(ShardedLRUCache, Stats) {
+    ShardedLRUCache<int, int> cache(2, 0);
+    cache.Insert(1, std::make_shared<int>(1));
+    cache.Insert(2, std::make_shared<int>(2));
+    cache.Insert(3, std::make_shared<int>(3));
+    cache.Lookup(1);
+    cache.Lookup(3);
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(stats.inserts, 3u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+}
+
+TEST(ShardedClockCache, ConcurrentAccess) {
+    ShardedClockCache<int, int> cache(256, 4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t] {
+            for (int i = 0; i < 20000; ++i) {
+                const int key = (i * 7 + t) % 512;
+                auto v = cache.Lookup(key);
+                if (v == nullptr) v = cache.Insert(key, std::make_shared<int>(key));
+                ASSERT_EQ(*v, key);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_LE(cache.Size(), 256u + 16u);
+}
+
+TEST(ShardedLRUCache, LowPriorityIsEvictedFirst) {
+    using VrootKV::common::CachePriority;
+    ShardedLRUCache<int, int> cache(3, 0);
+    cache.Insert(1, std::make_shared<int>(1));
+    cache.Insert(2, std::make_shared<int>(2));
+    cache.Insert(3, std::make_shared<int>(3), 1, CachePriority::kLow);
+    ASSERT_NE(cache.Lookup(3, CachePriority::kLow), nullptr);  // no refresh
+    cache.Insert(4, std::make_shared<int>(4));
+    EXPECT_EQ(cache.Lookup(3), nullptr);
+
+    ASSERT_NE(cache.Lookup(1, CachePriority::kLow), nullptr);  // still least recent
+    cache.Insert(5, std::make_shared<int>(5));
+    EXPECT_EQ(cache.Lookup(1), nullptr);
+    EXPECT_NE(cache.Lookup(2), nullptr);
+}
+
+TEST(ShardedClockCache, LowPriorityIsEvictedFirst) {
+    using VrootKV::common::CachePriority;
+    ShardedClockCache<int, int> cache(3, 0);
+    cache.Insert(1, std::make_shared<int>(1));
+    cache.Insert(2, std::make_shared<int>(2));
+    cache.Insert(3, std::make_shared<int>(3), 1, CachePriority::kLow);
+    ASSERT_NE(cache.Lookup(3, CachePriority::kLow), nullptr);  // no reference bit
+    cache.Insert(4, std::make_shared<int>(4));
+    EXPECT_EQ(cache.Lookup(3), nullptr);
+    EXPECT_NE(cache.Lookup(1), nullptr);
+    EXPECT_NE(cache.Lookup(2), nullptr);
+}
+
+template <typename Cache>
+void CheckAdmission(Cache& cache) {
+    int asked = 0;
+    cache.SetAdmissionPolicy([&asked](const int& candidate, const int& victim) {
+        ++asked;
+        EXPECT_EQ(victim, 1);
+        return candidate % 2 == 0;
+    });
+    cache.Insert(1, std::make_shared<int>(1));
+    cache.Insert(2, std::make_shared<int>(2));
+    EXPECT_EQ(asked, 0);  // room left: no admission decision
+
+    auto rejected = cache.Insert(3, std::make_shared<int>(3));
+    ASSERT_NE(rejected, nullptr);
+    EXPECT_EQ(*rejected, 3);
+    EXPECT_EQ(cache.Lookup(3), nullptr);
+
+    cache.Insert(4, std::make_shared<int>(4));
+    EXPECT_EQ(asked, 2);
+    EXPECT_EQ(cache.Lookup(1), nullptr);
+    EXPECT_NE(cache.Lookup(4), nullptr);
+    EXPECT_EQ(cache.GetStats().admission_rejects, 1u);
+    EXPECT_EQ(cache.GetStats().evictions, 1u);
+}
+
+TEST(ShardedLRUCache, AdmissionPolicy) {
+    ShardedLRUCache<int, int> cache(2, 0);
+    CheckAdmission(cache);
+}
+
+TEST(ShardedClockCache, AdmissionPolicy) {
+    ShardedClockCache<int, int> cache(2, 0);
+    CheckAdmission(cache);
+}
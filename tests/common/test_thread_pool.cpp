@@ -0,0 +1,35 @@
+/**
+ * @file test_thread_pool.cpp
+ * @author Vrutik Halani
+ * @brief Tests for `ThreadPool`: execution, WaitIdle() and drain-on-destroy.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+
+#include "src/common/thread_pool.h"
+
+using VrootKV::common::ThreadPool;
+
+TEST(ThreadPoolTest, RunsEveryTaskAndWaitsIdle) {
+    ThreadPool pool(3);
+    EXPECT_EQ(pool.num_threads(), 3u);
+    std::atomic<int> sum{0};
+    for (int i = 1; i <= 100; ++i) {
+        pool.Schedule([&sum, i] { sum += i; });
+    }
+    pool.WaitIdle();
+    EXPECT_EQ(sum.load(), 5050);
+    EXPECT_EQ(pool.QueueLength(), 0u);
+}
+
+TEST(ThreadPoolTest, DestructorDrainsQueuedTasks) {
+    std::atomic<int> ran{0};
+    {
+        ThreadPool pool(1);
+        for (int i = 0; i < 50; ++i) {
+            pool.Schedule([&ran] { ++ran; });
+        }
+    }
+    EXPECT_EQ(ran.load(), 50);
+}
@@ -0,0 +1,596 @@
+/**
+ * @file test_db.cpp
+ * @author Vrutik Halani
+ * @brief Tests for the `DB` engine (WAL + memtable + SSTables).
+ *
+ * What these tests cover
+ * ----------------------
+ * • Put/Get/Delete and atomic, ordered `WriteBatch`es.
+ * • Recovery from the log on reopen, with and without flushed tables.
+ * • Memtable switches and background flushes to level 0 when the write
+ *   buffer fills; reads span memtables and tables.
+ * • Iterators merge all sources newest-first, hide tombstones and support
+ *   Seek, reverse iteration and direction changes.
+ * • A torn log tail drops only the incomplete transaction.
+ * • The row cache serves repeated lookups and never returns stale rows.
+ * • create_if_missing / error_if_exists.
+ * • Leveled compaction: level 0 and every level stay within their targets,
+ *   data survives compaction and reopen, tombstones are dropped at the
+ *   bottom, and parallel compactions agree with a model.
+ * • A shared filter budget learns the level sizes; the memtable Bloom
+ *   filter option keeps lookups exact.
+ * • Universal compaction: agrees with a model, keeps the sorted-run count
+ *   bounded, merges everything on excess space amplification, and writes
+ *   fewer table bytes than leveled for the same random inserts.
+ * • Subcompactions: split points divide input bytes evenly, and split
+ *   compactions agree with a model.
+ * • Concurrent writers and readers.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/db/compaction.h"
+#include "src/db/filename.h"
+#include "src/io/table_cache.h"
+#include "VrootKV/db/db.h"
+#include "VrootKV/io/io_stats.h"
+#include "VrootKV/io/mem_file_manager.h"
+
+using namespace VrootKV;
+using db::DB;
+
+namespace {
+
+std::string Key(int i) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "key%06d", i);
+    return buf;
+}
+
+} // namespace
+
+class DBTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        fm_ = io::NewMemFileManager();
+        options_.file_manager = fm_.get();
+    }
+
+    std::unique_ptr<DB> Open() { return DB::Open("db", options_); }
+
+    std::string Get(DB& d, const std::string& key) {
+        std::string value;
+        return d.Get(key, value) ? value : "NOT_FOUND";
+    }
+
+    /// Every live key/value pair seen by a forward scan.
+    std::map<std::string, std::string> Scan(DB& d) {
+        std::map<std::string, std::string> out;
+        auto it = d.NewIterator();
+        for (it->SeekToFirst(); it->Valid(); it->Next()) out[std::string(it->key())] = std::string(it->value());
+        return out;
+    }
+
+    std::unique_ptr<io::IFileManager> fm_;
+    db::Options options_;
+};
+
+TEST_F(DBTest, PutGetDelete) {
+    auto d = Open();
+    EXPECT_EQ(Get(*d, "a"), "NOT_FOUND");
+    ASSERT_TRUE(d->Put("a", "1"));
+    ASSERT_TRUE(d->Put("b", "2"));
+    EXPECT_EQ(Get(*d, "a"), "1");
+    ASSERT_TRUE(d->Put("a", "3"));
+    EXPECT_EQ(Get(*d, "a"), "3");
+    ASSERT_TRUE(d->Delete("a"));
+    EXPECT_EQ(Get(*d, "a"), "NOT_FOUND");
+    EXPECT_EQ(Get(*d, "b"), "2");
+    ASSERT_TRUE(d->Put("empty", ""));
+    EXPECT_EQ(Get(*d, "empty"), "");
+}
+
+TEST_F(DBTest, WriteBatchAppliesInOrder) {
+    auto d = Open();
+    db::WriteBatch batch;
+    batch.Put("x", "1");
+    batch.Put("y", "2");
+    batch.Delete("x");
+    batch.Put("y", "3");
+    EXPECT_EQ(batch.Count(), 4u);
+    ASSERT_TRUE(d->Write(batch));
+    EXPECT_EQ(Get(*d, "x"), "NOT_FOUND");
+    EXPECT_EQ(Get(*d, "y"), "3");
+    ASSERT_TRUE(d->Write(db::WriteBatch()));  // empty batch is a no-op
+}
+
+TEST_F(DBTest, RecoversFromLog) {
+    {
+        auto d = Open();
+        ASSERT_TRUE(d->Put("a", "1"));
+        ASSERT_TRUE(d->Put("b", "2"));
+        ASSERT_TRUE(d->Delete("a"));
+        db::WriteOptions sync;
+        sync.sync = true;
+        ASSERT_TRUE(d->Put("c", "3", sync));
+        EXPECT_EQ(d->NumFilesAtLevel(0), 0);
+    }
+    auto d = Open();
+    EXPECT_EQ(Get(*d, "a"), "NOT_FOUND");
+    EXPECT_EQ(Get(*d, "b"), "2");
+    EXPECT_EQ(Get(*d, "c"), "3");
+    // Recovery moved the log contents into a table.
+    EXPECT_EQ(d->NumFilesAtLevel(0), 1);
+
+    // A second reopen sees the same state without replaying anything twice.
+    d.reset();
+    d = Open();
+    EXPECT_EQ(Get(*d, "b"), "2");
+    EXPECT_EQ(d->NumFilesAtLevel(0), 1);
+}
+
+TEST_F(DBTest, FlushWritesLevel0Tables) {
+    auto d = Open();
+    for (int i = 0; i < 100; ++i) ASSERT_TRUE(d->Put(Key(i), "v" + std::to_string(i)));
+    ASSERT_TRUE(d->Flush());
+    EXPECT_EQ(d->NumFilesAtLevel(0), 1);
+    ASSERT_TRUE(d->Flush());  // nothing new: no empty table
+    EXPECT_EQ(d->NumFilesAtLevel(0), 1);
+
+    // Newer tables and memtables shadow older tables.
+    ASSERT_TRUE(d->Delete(Key(5)));
+    ASSERT_TRUE(d->Put(Key(6), "new"));
+    ASSERT_TRUE(d->Flush());
+    ASSERT_TRUE(d->Put(Key(7), "newer"));
+    EXPECT_EQ(d->NumFilesAtLevel(0), 2);
+    EXPECT_EQ(Get(*d, Key(4)), "v4");
+    EXPECT_EQ(Get(*d, Key(5)), "NOT_FOUND");
+    EXPECT_EQ(Get(*d, Key(6)), "new");
+    EXPECT_EQ(Get(*d, Key(7)), "newer");
+    EXPECT_EQ(Get(*d, Key(1000)), "NOT_FOUND");
+
+    d.reset();
+    d = Open();
+    EXPECT_EQ(Get(*d, Key(4)), "v4");
+    EXPECT_EQ(Get(*d, Key(5)), "NOT_FOUND");
+    EXPECT_EQ(Get(*d, Key(7)), "newer");
+}
+
+TEST_F(DBTest, FullMemtableIsFlushedInBackground) {
+    options_.write_buffer_size = 16 << 10;
+    options_.level0_file_num_compaction_trigger = 1000;  // keep every flushed table at L0
+    options_.level0_stop_writes_trigger = 1000;
+    auto d = Open();
+    const std::string value(100, 'v');
+    for (int i = 0; i < 2000; ++i) ASSERT_TRUE(d->Put(Key(i), value + std::to_string(i)));
+    ASSERT_TRUE(d->Flush());
+    EXPECT_GT(d->NumFilesAtLevel(0), 5);
+    for (int i = 0; i < 2000; i += 13) ASSERT_EQ(Get(*d, Key(i)), value + std::to_string(i)) << i;
+
+    d.reset();
+    d = Open();
+    for (int i = 0; i < 2000; i += 13) ASSERT_EQ(Get(*d, Key(i)), value + std::to_string(i)) << i;
+    EXPECT_EQ(Scan(*d).size(), 2000u);
+}
+
+TEST_F(DBTest, IteratorMergesSourcesAndHidesTombstones) {
+    auto d = Open();
+    std::map<std::string, std::string> model;
+    std::mt19937 rng(7);
+    for (int round = 0; round < 4; ++round) {
+        for (int n = 0; n < 300; ++n) {
+            const std::string k = Key(static_cast<int>(rng() % 500));
+            if (rng() % 4 == 0) {
+                ASSERT_TRUE(d->Delete(k));
+                model.erase(k);
+            } else {
+                const std::string v = "r" + std::to_string(round) + "-" + std::to_string(n);
+                ASSERT_TRUE(d->Put(k, v));
+                model[k] = v;
+            }
+        }
+        if (round < 3) {
+            ASSERT_TRUE(d->Flush());  // last round stays in the memtable
+        }
+    }
+    EXPECT_EQ(Scan(*d), model);
+
+    auto it = d->NewIterator();
+    auto rit = model.rbegin();
+    for (it->SeekToLast(); it->Valid(); it->Prev(), ++rit) {
+        ASSERT_NE(rit, model.rend());
+        ASSERT_EQ(it->key(), rit->first);
+        ASSERT_EQ(it->value(), rit->second);
+    }
+    EXPECT_EQ(rit, model.rend());
+
+    // Seek plus direction changes.
+    const std::string target = Key(250);
+    auto m = model.lower_bound(target);
+    it->Seek(target);
+    ASSERT_TRUE(it->Valid());
+    ASSERT_EQ(it->key(), m->first);
+    it->Next();
+    ++m;
+    ASSERT_EQ(it->key(), m->first);
+    it->Prev();
+    --m;
+    ASSERT_EQ(it->key(), m->first);
+    it->Prev();
+    --m;
+    ASSERT_EQ(it->key(), m->first);
+    it->Next();
+    ++m;
+    ASSERT_EQ(it->key(), m->first);
+
+    // The iterator is a snapshot: later writes are invisible to it.
+    auto snapshot = d->NewIterator();
+    ASSERT_TRUE(d->Put("zzz", "late"));
+    ASSERT_TRUE(d->Put(model.begin()->first, "late"));
+    snapshot->SeekToLast();
+    ASSERT_TRUE(snapshot->Valid());
+    EXPECT_EQ(snapshot->key(), model.rbegin()->first);
+    snapshot->SeekToFirst();
+    ASSERT_TRUE(snapshot->Valid());
+    EXPECT_EQ(snapshot->value(), model.begin()->second);
+}
+
+TEST_F(DBTest, TornLogTailDropsOnlyIncompleteTransaction) {
+    {
+        auto d = Open();
+        ASSERT_TRUE(d->Put("a", "1"));
+        db::WriteBatch batch;
+        batch.Put("b", "2");
+        batch.Put("c", "3");
+        ASSERT_TRUE(d->Write(batch));
+    }
+    // A fresh database writes its first log as number 1; cut its last bytes
+    // (the batch's COMMIT frame), as a crash mid-append would.
+    const std::string log = db::LogFileName("db", 1);
+    std::string contents;
+    ASSERT_TRUE(db::ReadFileToString(fm_.get(), log, &contents));
+    contents.resize(contents.size() - 5);
+    std::unique_ptr<io::IWritableFile> file;
+    ASSERT_TRUE(fm_->NewWritableFile(log, file));
+    ASSERT_TRUE(file->Write(contents));
+    ASSERT_TRUE(file->Close());
+
+    auto d = Open();
+    EXPECT_EQ(Get(*d, "a"), "1");
+    EXPECT_EQ(Get(*d, "b"), "NOT_FOUND");
+    EXPECT_EQ(Get(*d, "c"), "NOT_FOUND");
+    ASSERT_TRUE(d->Put("b", "again"));
+    d.reset();
+    d = Open();
+    EXPECT_EQ(Get(*d, "b"), "again");
+}
+
+TEST_F(DBTest, RowCacheServesRepeatedLookups) {
+    options_.row_cache_size = 1 << 20;
+    auto d = Open();
+    ASSERT_TRUE(d->Put("k", "v1"));
+    ASSERT_TRUE(d->Flush());
+    for (int i = 0; i < 3; ++i) EXPECT_EQ(Get(*d, "k"), "v1");
+    EXPECT_EQ(Get(*d, "missing"), "NOT_FOUND");
+    EXPECT_EQ(Get(*d, "missing"), "NOT_FOUND");
+
+    // Overwrite and flush: the cached row must not be served.
+    ASSERT_TRUE(d->Put("k", "v2"));
+    ASSERT_TRUE(d->Flush());
+    EXPECT_EQ(Get(*d, "k"), "v2");
+    ASSERT_TRUE(d->Put("missing", "now"));
+    ASSERT_TRUE(d->Flush());
+    EXPECT_EQ(Get(*d, "missing"), "now");
+}
+
+TEST_F(DBTest, CreateAndExistenceChecks) {
+    options_.create_if_missing = false;
+    EXPECT_THROW(Open(), std::runtime_error);
+
+    options_.create_if_missing = true;
+    Open().reset();
+    options_.error_if_exists = true;
+    EXPECT_THROW(Open(), std::runtime_error);
+}
+
+TEST_F(DBTest, ConcurrentWritersAndReaders) {
+    options_.write_buffer_size = 32 << 10;
+    auto d = Open();
+    constexpr int kWriters = 4;
+    constexpr int kPerWriter = 1000;
+    std::vector<std::thread> threads;
+    for (int w = 0; w < kWriters; ++w) {
+        threads.emplace_back([&, w] {
+            for (int i = 0; i < kPerWriter; ++i) {
+                ASSERT_TRUE(d->Put(Key(w * kPerWriter + i), std::string(50, 'a' + w)));
+            }
+        });
+    }
+    threads.emplace_back([&] {
+        std::string value;
+        for (int i = 0; i < 2000; ++i) {
+            if (d->Get(Key(i % (kWriters * kPerWriter)), value)) {
+                ASSERT_EQ(value.size(), 50u);
+            }
+        }
+    });
+    for (auto& t : threads) t.join();
+
+    for (int w = 0; w < kWriters; ++w) {
+        for (int i = 0; i < kPerWriter; i += 37) {
+            ASSERT_EQ(Get(*d, Key(w * kPerWriter + i)), std::string(50, 'a' + w));
+        }
+    }
+    EXPECT_EQ(Scan(*d).size(), static_cast<size_t>(kWriters * kPerWriter));
+}
+
+namespace {
+
+/// Small sizes so a few thousand keys exercise several levels.
+void UseTinyLevels(db::Options& options) {
+    options.write_buffer_size = 8 << 10;
+    options.level0_file_num_compaction_trigger = 2;
+    options.level0_stop_writes_trigger = 6;
+    options.max_bytes_for_level_base = 32 << 10;
+    options.max_bytes_for_level_multiplier = 4;
+    options.target_file_size = 8 << 10;
+    options.block_size = 1024;
+}
+
+} // namespace
+
+TEST_F(DBTest, LeveledCompactionKeepsLevelsWithinTargets) {
+    UseTinyLevels(options_);
+    auto d = Open();
+    std::map<std::string, std::string> model;
+    std::mt19937 rng(11);
+    size_t max_l0 = 0;
+    for (int n = 0; n < 20000; ++n) {
+        const std::string k = Key(static_cast<int>(rng() % 5000));
+        if (rng() % 8 == 0) {
+            ASSERT_TRUE(d->Delete(k));
+            model.erase(k);
+        } else {
+            const std::string v = std::to_string(n) + std::string(20, 'x');
+            ASSERT_TRUE(d->Put(k, v));
+            model[k] = v;
+        }
+        max_l0 = std::max(max_l0, static_cast<size_t>(d->NumFilesAtLevel(0)));
+    }
+    ASSERT_TRUE(d->WaitForCompactions());
+
+    // Writers stall rather than letting level 0 (and read amplification) grow.
+    EXPECT_LE(max_l0, static_cast<size_t>(options_.level0_stop_writes_trigger));
+    EXPECT_LT(d->NumFilesAtLevel(0), options_.level0_file_num_compaction_trigger);
+    int deepest = 0;
+    for (int level = 1; level < 7; ++level) {
+        if (d->NumFilesAtLevel(level) > 0) deepest = level;
+    }
+    EXPECT_GE(deepest, 2);
+    for (int level = 1; level < deepest; ++level) {
+        double target = static_cast<double>(options_.max_bytes_for_level_base);
+        for (int l = 1; l < level; ++l) target *= options_.max_bytes_for_level_multiplier;
+        EXPECT_LE(static_cast<double>(d->NumBytesAtLevel(level)), target) << "level " << level;
+    }
+
+    for (const auto& [k, v] : model) ASSERT_EQ(Get(*d, k), v) << k;
+    EXPECT_EQ(Get(*d, Key(5001)), "NOT_FOUND");
+    EXPECT_EQ(Scan(*d), model);
+
+    d.reset();
+    d = Open();
+    EXPECT_EQ(Scan(*d), model);
+}
+
+TEST_F(DBTest, FilterBudgetAndMemtableBloomAreWiredThrough) {
+    UseTinyLevels(options_);
+    common::FilterBudget budget(10.0);
+    options_.filter_budget = &budget;
+    options_.memtable_bloom_expected_entries = 1000;
+    auto d = Open();
+    std::map<std::string, std::string> model;
+    std::mt19937 rng(13);
+    for (int n = 0; n < 20000; ++n) {
+        const std::string k = Key(static_cast<int>(rng() % 5000));
+        const std::string v = std::to_string(n) + std::string(20, 'x');
+        ASSERT_TRUE(d->Put(k, v));
+        model[k] = v;
+    }
+    ASSERT_TRUE(d->WaitForCompactions());
+
+    // The DB publishes its level sizes, so the largest level gets fewer bits
+    // per key than the budget's average and the smallest one gets more.
+    int largest = -1, smallest = -1;
+    for (int level = 0; level < 7; ++level) {
+        const uint64_t bytes = d->NumBytesAtLevel(level);
+        if (bytes == 0) continue;
+        if (largest < 0 || bytes > d->NumBytesAtLevel(largest)) largest = level;
+        if (smallest < 0 || bytes < d->NumBytesAtLevel(smallest)) smallest = level;
+    }
+    ASSERT_NE(largest, smallest);
+    EXPECT_LT(budget.BitsPerKeyForLevel(largest), 10.0);
+    EXPECT_GT(budget.BitsPerKeyForLevel(smallest), budget.BitsPerKeyForLevel(largest));
+
+    // Lookups (including memtable misses screened by its filter) stay exact.
+    for (const auto& [k, v] : model) ASSERT_EQ(Get(*d, k), v) << k;
+    for (int i = 5000; i < 5100; ++i) EXPECT_EQ(Get(*d, Key(i)), "NOT_FOUND");
+    ASSERT_TRUE(d->Put("fresh", "1"));
+    EXPECT_EQ(Get(*d, "fresh"), "1");
+}
+
+TEST_F(DBTest, CompactionDropsTombstonesAtBottomLevel) {
+    options_.level0_file_num_compaction_trigger = 2;
+    auto d = Open();
+    for (int i = 0; i < 500; ++i) ASSERT_TRUE(d->Put(Key(i), "v"));
+    ASSERT_TRUE(d->Flush());
+    for (int i = 0; i < 500; ++i) ASSERT_TRUE(d->Delete(Key(i)));
+    ASSERT_TRUE(d->Flush());
+    ASSERT_TRUE(d->WaitForCompactions());
+
+    // Values and tombstones cancel out: nothing is left on disk.
+    for (int level = 0; level < 7; ++level) EXPECT_EQ(d->NumFilesAtLevel(level), 0) << level;
+    EXPECT_TRUE(Scan(*d).empty());
+    EXPECT_FALSE(fm_->FileExists(io::TableFileName("db", 3)));  // first flushed table was deleted
+}
+
+TEST_F(DBTest, ParallelCompactionsWithConcurrentWriters) {
+    UseTinyLevels(options_);
+    options_.max_background_compactions = 4;
+    auto d = Open();
+    constexpr int kWriters = 4;
+    constexpr int kPerWriter = 3000;
+    std::vector<std::thread> threads;
+    for (int w = 0; w < kWriters; ++w) {
+        threads.emplace_back([&, w] {
+            for (int i = 0; i < kPerWriter; ++i) {
+                // Interleave writers across the key space so compactions overlap in time.
+                ASSERT_TRUE(d->Put(Key(i * kWriters + w), std::to_string(w) + std::string(30, 'p')));
+            }
+        });
+    }
+    threads.emplace_back([&] {
+        for (int round = 0; round < 20; ++round) {
+            auto it = d->NewIterator();
+            std::string prev;
+            for (it->SeekToFirst(); it->Valid(); it->Next()) {
+                ASSERT_LT(prev, std::string(it->key()));
+                prev.assign(it->key());
+            }
+        }
+    });
+    for (auto& t : threads) t.join();
+    ASSERT_TRUE(d->WaitForCompactions());
+
+    const auto all = Scan(*d);
+    ASSERT_EQ(all.size(), static_cast<size_t>(kWriters * kPerWriter));
+    for (int i = 0; i < kPerWriter * kWriters; i += 17) {
+        ASSERT_EQ(Get(*d, Key(i)), std::to_string(i % kWriters) + std::string(30, 'p'));
+    }
+}
+
+TEST_F(DBTest, UniversalCompactionAgreesWithModelAndBoundsRuns) {
+    UseTinyLevels(options_);
+    options_.compaction_style = db::CompactionStyle::kUniversal;
+    options_.level0_stop_writes_trigger = 12;
+    auto d = Open();
+    std::map<std::string, std::string> model;
+    std::mt19937 rng(23);
+    for (int n = 0; n < 20000; ++n) {
+        const std::string k = Key(static_cast<int>(rng() % 5000));
+        if (rng() % 8 == 0) {
+            ASSERT_TRUE(d->Delete(k));
+            model.erase(k);
+        } else {
+            const std::string v = std::to_string(n) + std::string(20, 'u');
+            ASSERT_TRUE(d->Put(k, v));
+            model[k] = v;
+        }
+    }
+    ASSERT_TRUE(d->WaitForCompactions());
+
+    int runs = d->NumFilesAtLevel(0);
+    for (int level = 1; level < 7; ++level) runs += d->NumFilesAtLevel(level) > 0 ? 1 : 0;
+    EXPECT_LT(runs, options_.level0_stop_writes_trigger);
+    EXPECT_GT(d->NumFilesAtLevel(6), 0);  // the oldest run lives at the bottom
+
+    for (const auto& [k, v] : model) ASSERT_EQ(Get(*d, k), v) << k;
+    EXPECT_EQ(Scan(*d), model);
+
+    d.reset();
+    d = Open();
+    EXPECT_EQ(Scan(*d), model);
+}
+
+TEST_F(DBTest, UniversalSpaceAmplificationTriggersFullMerge) {
+    options_.compaction_style = db::CompactionStyle::kUniversal;
+    options_.level0_file_num_compaction_trigger = 100;  // no tiering merges
+    options_.universal_max_size_amplification_percent = 100;
+    auto d = Open();
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 500; ++i) ASSERT_TRUE(d->Put(Key(i), "v" + std::to_string(round)));
+        ASSERT_TRUE(d->Flush());
+        ASSERT_TRUE(d->WaitForCompactions());
+    }
+
+    // Three copies of the same keys are 200% amplification: merged into one run.
+    EXPECT_EQ(d->NumFilesAtLevel(0), 0);
+    EXPECT_GT(d->NumFilesAtLevel(6), 0);
+    for (int i = 0; i < 500; ++i) ASSERT_EQ(Get(*d, Key(i)), "v2");
+}
+
+TEST_F(DBTest, UniversalWritesFewerTableBytesThanLeveled) {
+    auto table_bytes_written = [](db::CompactionStyle style) {
+        io::IOStats stats;
+        auto fm = io::NewInstrumentedFileManager(io::NewMemFileManager(), &stats);
+        db::Options options;
+        UseTinyLevels(options);
+        options.file_manager = fm.get();
+        options.compaction_style = style;
+        options.level0_stop_writes_trigger = 12;
+        auto d = DB::Open("db", options);
+        std::mt19937 rng(5);
+        for (int n = 0; n < 30000; ++n) {
+            EXPECT_TRUE(d->Put(Key(static_cast<int>(rng() % 1000000)), std::string(40, 'w')));
+        }
+        EXPECT_TRUE(d->WaitForCompactions());
+        d.reset();
+        return stats.Bytes(io::FileClass::kSSTable, io::IOOp::kWrite);
+    };
+    const uint64_t leveled = table_bytes_written(db::CompactionStyle::kLeveled);
+    const uint64_t universal = table_bytes_written(db::CompactionStyle::kUniversal);
+    EXPECT_LT(universal * 3, leveled * 2) << "leveled " << leveled << " universal " << universal;
+}
+
+TEST(SubcompactionTest, BoundariesSplitInputBytesEvenly) {
+    std::vector<db::KeySample> samples;
+    for (int i = 99; i >= 0; --i) samples.push_back(db::KeySample{Key(i), 10});  // unsorted on purpose
+    EXPECT_EQ(db::SubcompactionBoundaries(samples, 4), (std::vector<std::string>{Key(25), Key(50), Key(75)}));
+    EXPECT_TRUE(db::SubcompactionBoundaries(samples, 1).empty());
+
+    // Bytes, not sample counts, decide: the first key holds half the input.
+    samples.push_back(db::KeySample{Key(0), 990});
+    EXPECT_EQ(db::SubcompactionBoundaries(samples, 2), (std::vector<std::string>{Key(1)}));
+
+    // Never more ranges than distinct keys; boundaries stay strictly increasing.
+    std::vector<db::KeySample> few = {{"a", 1}, {"a", 1}, {"b", 1}};
+    EXPECT_EQ(db::SubcompactionBoundaries(few, 8), (std::vector<std::string>{"b"}));
+}
+
+TEST_F(DBTest, SubcompactionsAgreeWithModel) {
+    UseTinyLevels(options_);
+    options_.max_subcompactions = 4;
+    options_.level0_file_num_compaction_trigger = 4;
+    options_.level0_stop_writes_trigger = 12;
+    auto d = Open();
+    std::map<std::string, std::string> model;
+    std::mt19937 rng(31);
+    for (int n = 0; n < 20000; ++n) {
+        const std::string k = Key(static_cast<int>(rng() % 5000));
+        if (rng() % 8 == 0) {
+            ASSERT_TRUE(d->Delete(k));
+            model.erase(k);
+        } else {
+            const std::string v = std::to_string(n) + std::string(20, 's');
+            ASSERT_TRUE(d->Put(k, v));
+            model[k] = v;
+        }
+    }
+    ASSERT_TRUE(d->WaitForCompactions());
+
+    EXPECT_LT(d->NumFilesAtLevel(0), options_.level0_file_num_compaction_trigger);
+    for (const auto& [k, v] : model) ASSERT_EQ(Get(*d, k), v) << k;
+    EXPECT_EQ(Scan(*d), model);
+
+    d.reset();
+    d = Open();
+    EXPECT_EQ(Scan(*d), model);
+}
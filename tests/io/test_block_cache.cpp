@@ -0,0 +1,409 @@
+/**
+ * @file test_block_cache.cpp
+ * @author Vrutik Halani
+ * @brief Tests for the data-block cache and its use by `TableReader`.
+ *
+ * What these tests cover
+ * ----------------------
+ * • Both eviction policies: byte-budgeted eviction, pinning and statistics.
+ * • Repeated Gets on a table are served from the cache after the first read;
+ *   only misses reach the file.
+ * • MultiGet over a partly cached table reads just the missing blocks and
+ *   agrees with Get.
+ * • Tables reopened through `TableCache` keep hitting their cached blocks.
+ * • Many threads hammering one hot block.
+ * • Scan resistance: with TinyLFU admission, or with low-priority scan
+ *   reads, a one-pass scan leaves the hot blocks cached; `fill_cache=false`
+ *   reads bypass inserts entirely.
+ * • A compressed secondary tier: evicted blocks are demoted, promoted back on
+ *   a primary miss (or kept there if admission refuses the promotion), and
+ *   serve Gets with fewer file reads than the primary alone when the working
+ *   set exceeds it.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/io/block_cache.h"
+#include "src/io/secondary_cache.h"
+#include "src/io/table_builder.h"
+#include "src/io/table_cache.h"
+#include "src/io/table_reader.h"
+#include "VrootKV/io/mem_file_manager.h"
+
+using namespace VrootKV::io;
+
+namespace {
+
+std::string Key(int i) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "key%06d", i);
+    return buf;
+}
+
+void BuildTable(IFileManager& fm, const std::string& name, int n) {
+    std::unique_ptr<IWritableFile> file;
+    ASSERT_TRUE(fm.NewWritableFile(name, file));
+    TableBuilder builder(TableBuilderOptions(), file.get());
+    for (int i = 0; i < n; ++i) builder.Add(Key(i), "value-" + std::to_string(i));
+    ASSERT_TRUE(builder.Finish());
+    ASSERT_TRUE(file->Close());
+}
+
+std::unique_ptr<TableReader> OpenTable(IFileManager& fm, const std::string& name,
+                                       std::shared_ptr<BlockCache> cache) {
+    std::unique_ptr<IRandomAccessFile> file;
+    EXPECT_TRUE(fm.NewRandomAccessFile(name, file));
+    TableReaderOptions options;
+    options.block_cache = std::move(cache);
+    return TableReader::Open(std::move(file), options);
+}
+
+} // namespace
+
+class BlockCachePolicyTest : public ::testing::TestWithParam<CacheEvictionPolicy> {
+protected:
+    std::shared_ptr<BlockCache> NewCache(std::size_t capacity, int shard_bits = 0) {
+        BlockCacheOptions options;
+        options.capacity = capacity;
+        options.num_shard_bits = shard_bits;
+        options.policy = GetParam();
+        return std::make_shared<BlockCache>(options);
+    }
+};
+
+TEST_P(BlockCachePolicyTest, ByteBudgetPinningAndStats) {
+    auto cache = NewCache(10000);
+    const uint64_t id = cache->NewId();
+    EXPECT_NE(id, 0u);
+
+    CachedBlock first = cache->Insert({id, 0}, std::string(4000, 'a'));
+    cache->Insert({id, 4000}, std::string(4000, 'b'));
+    EXPECT_EQ(cache->GetUsage(), 8000u);
+    cache->Insert({id, 8000}, std::string(4000, 'c'));
+    EXPECT_LE(cache->GetUsage(), 10000u);
+
+    // The evicted block is still readable through the pin.
+    EXPECT_EQ(*first, std::string(4000, 'a'));
+    EXPECT_EQ(cache->Lookup({cache->NewId(), 0}), nullptr);
+    ASSERT_NE(cache->Lookup({id, 8000}), nullptr);
+
+    const auto stats = cache->GetStats();
+    EXPECT_EQ(stats.inserts, 3u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+
+    cache->Erase({id, 8000});
+    EXPECT_EQ(cache->Lookup({id, 8000}), nullptr);
+}
+
+TEST_P(BlockCachePolicyTest, GetServedFromCacheAfterFirstRead) {
+    auto fm = NewMemFileManager();
+    BuildTable(*fm, "t.sst", 5000);
+    auto cache = NewCache(64 << 20, 4);
+    auto table = OpenTable(*fm, "t.sst", cache);
+
+    std::string value;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 5000; i += 7) {
+            ASSERT_TRUE(table->Get(Key(i), value));
+            ASSERT_EQ(value, "value-" + std::to_string(i));
+        }
+    }
+    const uint64_t reads = table->data_block_reads();
+    const auto stats = cache->GetStats();
+    EXPECT_EQ(stats.misses, reads);
+    EXPECT_EQ(stats.inserts, reads);
+    EXPECT_GT(stats.hits, 2 * reads);
+    EXPECT_GT(cache->GetUsage(), 0u);
+
+    for (int i = 0; i < 5000; i += 7) ASSERT_TRUE(table->Get(Key(i), value));
+    EXPECT_EQ(table->data_block_reads(), reads);
+}
+
+TEST_P(BlockCachePolicyTest, MultiGetReadsOnlyMisses) {
+    auto fm = NewMemFileManager();
+    BuildTable(*fm, "t.sst", 5000);
+    auto cache = NewCache(64 << 20, 2);
+    auto table = OpenTable(*fm, "t.sst", cache);
+
+    std::string value;
+    for (int i = 0; i < 2500; i += 50) ASSERT_TRUE(table->Get(Key(i), value));
+    const uint64_t warm_reads = table->data_block_reads();
+
+    std::vector<std::string> owned;
+    for (int i = 0; i < 5000; i += 25) owned.push_back(Key(i));
+    owned.push_back("zzz-missing");
+    std::vector<std::string_view> keys(owned.begin(), owned.end());
+    std::vector<std::string> values;
+    const std::vector<bool> found = table->MultiGet(keys, &values, nullptr);
+    const uint64_t multiget_reads = table->data_block_reads() - warm_reads;
+
+    for (size_t i = 0; i + 1 < keys.size(); ++i) {
+        ASSERT_TRUE(found[i]) << keys[i];
+        EXPECT_EQ(values[i], "value-" + std::to_string(i * 25));
+    }
+    EXPECT_FALSE(found.back());
+
+    // The second half of the table was cold; the first half was cached.
+    auto uncached = OpenTable(*fm, "t.sst", nullptr);
+    uncached->MultiGet(keys, &values, nullptr);
+    EXPECT_LT(multiget_reads, uncached->data_block_reads());
+
+    // Everything is cached now.
+    table->MultiGet(keys, &values, nullptr);
+    EXPECT_EQ(table->data_block_reads() - warm_reads, multiget_reads);
+}
+
+TEST_P(BlockCachePolicyTest, HotBlockConcurrentReaders) {
+    auto fm = NewMemFileManager();
+    BuildTable(*fm, "t.sst", 1000);
+    auto cache = NewCache(1 << 20, 4);
+    auto table = OpenTable(*fm, "t.sst", cache);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&table, t] {
+            std::string value;
+            for (int i = 0; i < 5000; ++i) {
+                const int k = (i + t) % 8;  // all in the first block
+                ASSERT_TRUE(table->Get(Key(k), value));
+                ASSERT_EQ(value, "value-" + std::to_string(k));
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_LE(table->data_block_reads(), 4u);
+}
+
+INSTANTIATE_TEST_SUITE_P(Policies, BlockCachePolicyTest,
+                         ::testing::Values(CacheEvictionPolicy::kLRU, CacheEvictionPolicy::kClock),
+                         [](const ::testing::TestParamInfo<CacheEvictionPolicy>& info) {
+                             return info.param == CacheEvictionPolicy::kLRU ? "LRU" : "Clock";
+                         });
+
+TEST(BlockCacheTest, TableCacheReopenKeepsBlocks) {
+    auto fm = NewMemFileManager();
+    BuildTable(*fm, TableFileName("db", 1), 2000);
+    BuildTable(*fm, TableFileName("db", 2), 2000);
+
+    TableCacheOptions options;
+    options.max_open_tables = 1;
+    options.num_shard_bits = 0;
+    options.table_options.block_cache = std::make_shared<BlockCache>();
+    TableCache tables(fm.get(), "db", options);
+
+    std::string value;
+    ASSERT_TRUE(tables.Get(1, Key(10), value));
+    ASSERT_TRUE(tables.Get(2, Key(10), value));  // evicts table 1
+    const auto before = options.table_options.block_cache->GetStats();
+    ASSERT_TRUE(tables.Get(1, Key(11), value));  // reopened, same block
+    const auto after = options.table_options.block_cache->GetStats();
+
+    EXPECT_EQ(tables.table_opens(), 3u);
+    EXPECT_EQ(after.hits, before.hits + 1);
+    EXPECT_EQ(after.misses, before.misses);
+}
+
+TEST(BlockCacheTest, MappedTablesBypassCache) {
+    auto fm = NewDefaultFileManager();
+    const std::string path = (std::filesystem::temp_directory_path() / "block_cache_mmap.sst").string();
+    BuildTable(*fm, path, 1000);
+    FileOptions fopts;
+    fopts.use_mmap_reads = true;
+    std::unique_ptr<IRandomAccessFile> file;
+    ASSERT_TRUE(fm->NewRandomAccessFile(path, file, fopts));
+    TableReaderOptions options;
+    options.block_cache = std::make_shared<BlockCache>();
+    auto table = TableReader::Open(std::move(file), options);
+    std::string value;
+    ASSERT_TRUE(table->Get(Key(5), value));
+    EXPECT_EQ(options.block_cache->GetStats().inserts, 0u);
+    table.reset();
+    std::filesystem::remove(path);
+}
+
+TEST_P(BlockCachePolicyTest, ScanResistance) {
+    // 10 hot blocks read round-robin, one hot read per 4 scanned blocks; the
+    // cache holds 20 blocks, so a plain cache loses each hot block to the
+    // scan before it is read again.
+    auto hot_hit_rate = [&](bool tinylfu, CachePriority scan_priority) {
+        BlockCacheOptions options;
+        options.capacity = 20 * 4096;
+        options.num_shard_bits = 0;
+        options.policy = GetParam();
+        options.tinylfu_admission = tinylfu;
+        BlockCache cache(options);
+        int hot_reads = 0, hot_hits = 0;
+        for (uint64_t b = 0; b < 2000; ++b) {
+            if (!cache.Lookup({2, b}, scan_priority)) cache.Insert({2, b}, std::string(4096, 's'), scan_priority);
+            if (b % 4 != 0) continue;
+            const BlockCacheKey hot{1, (b / 4) % 10};
+            const bool hit = cache.Lookup(hot) != nullptr;
+            if (!hit) cache.Insert(hot, std::string(4096, 'h'));
+            if (b >= 1000) {
+                ++hot_reads;
+                hot_hits += hit;
+            }
+        }
+        EXPECT_LE(cache.GetUsage(), options.capacity);
+        return static_cast<double>(hot_hits) / hot_reads;
+    };
+
+    EXPECT_LT(hot_hit_rate(false, CachePriority::kHigh), 0.1);
+    EXPECT_GT(hot_hit_rate(true, CachePriority::kHigh), 0.9);
+    EXPECT_GT(hot_hit_rate(false, CachePriority::kLow), 0.9);
+}
+
+TEST_P(BlockCachePolicyTest, FillCacheFalseDoesNotInsert) {
+    auto fm = NewMemFileManager();
+    BuildTable(*fm, "t.sst", 2000);
+    auto cache = NewCache(1 << 20);
+    auto table = OpenTable(*fm, "t.sst", cache);
+
+    ReadOptions scan;
+    scan.fill_cache = false;
+    std::string value;
+    for (int i = 0; i < 2000; i += 10) ASSERT_TRUE(table->Get(Key(i), value, scan));
+    std::vector<std::string> owned = {Key(3), Key(1500)};
+    std::vector<std::string_view> keys(owned.begin(), owned.end());
+    std::vector<std::string> values;
+    EXPECT_EQ(table->MultiGet(keys, &values, nullptr, scan), std::vector<bool>({true, true}));
+    EXPECT_EQ(values[1], "value-1500");
+    EXPECT_EQ(cache->GetStats().inserts, 0u);
+    EXPECT_EQ(cache->GetUsage(), 0u);
+
+    // A normal read still fills the cache, and a later no-fill read can hit it.
+    ASSERT_TRUE(table->Get(Key(0), value));
+    const uint64_t reads = table->data_block_reads();
+    ASSERT_TRUE(table->Get(Key(1), value, scan));
+    EXPECT_EQ(table->data_block_reads(), reads);
+}
+
+// ============================================================================
+// Compressed secondary tier
+// ============================================================================
+
+TEST(SecondaryCacheTest, CompressesAndTakesOnLookup) {
+    SecondaryCacheOptions options;
+    options.capacity = 1 << 20;
+    options.num_shard_bits = 0;
+    CompressedSecondaryCache cache(options);
+
+    std::string text;
+    for (int i = 0; i < 200; ++i) text += Key(i) + "value-" + std::to_string(i);
+    cache.Insert({1, 0}, text);
+    EXPECT_LT(cache.GetUsage(), text.size() / 2);
+
+    std::mt19937 rng(42);
+    std::string noise(4096, '\0');
+    for (char& c : noise) c = static_cast<char>(rng());
+    const std::size_t before = cache.GetUsage();
+    cache.Insert({1, 4096}, noise);
+    EXPECT_EQ(cache.GetUsage() - before, noise.size() + 1);  // stored raw
+
+    std::string block;
+    ASSERT_TRUE(cache.Lookup({1, 0}, &block));
+    EXPECT_EQ(block, text);
+    EXPECT_FALSE(cache.Lookup({1, 0}, &block));  // promotion removed it
+    ASSERT_TRUE(cache.Lookup({1, 4096}, &block));
+    EXPECT_EQ(block, noise);
+    EXPECT_EQ(cache.GetUsage(), 0u);
+    EXPECT_GT(cache.raw_bytes_inserted(), cache.stored_bytes_inserted());
+}
+
+TEST_P(BlockCachePolicyTest, EvictedBlocksAreDemotedAndPromoted) {
+    SecondaryCacheOptions sec_options;
+    sec_options.num_shard_bits = 0;
+    auto secondary = std::make_shared<CompressedSecondaryCache>(sec_options);
+    BlockCacheOptions options;
+    options.capacity = 10000;
+    options.num_shard_bits = 0;
+    options.policy = GetParam();
+    options.secondary_cache = secondary;
+    BlockCache cache(options);
+
+    cache.Insert({1, 0}, std::string(4000, 'a'));
+    cache.Insert({1, 4000}, std::string(4000, 'b'));
+    cache.Insert({1, 8000}, std::string(4000, 'c'));  // evicts 'a' into the secondary
+    EXPECT_EQ(secondary->GetStats().inserts, 1u);
+    EXPECT_LT(secondary->GetUsage(), 4000u);
+
+    CachedBlock a = cache.Lookup({1, 0});
+    ASSERT_NE(a, nullptr);
+    EXPECT_EQ(*a, std::string(4000, 'a'));
+    EXPECT_EQ(cache.secondary_hits(), 1u);
+    EXPECT_EQ(secondary->GetStats().inserts, 2u);  // the promotion demoted another block
+    EXPECT_NE(cache.Lookup({1, 0}), nullptr);
+    EXPECT_EQ(cache.secondary_hits(), 1u);         // now a primary hit
+
+    cache.Erase({1, 0});
+    cache.Erase({1, 4000});
+    cache.Erase({1, 8000});
+    EXPECT_EQ(cache.Lookup({1, 4000}), nullptr);
+    EXPECT_EQ(cache.Lookup({1, 8000}), nullptr);
+    EXPECT_EQ(secondary->GetUsage(), 0u);
+}
+
+TEST_P(BlockCachePolicyTest, RejectedPromotionStaysInSecondary) {
+    auto secondary = std::make_shared<CompressedSecondaryCache>(SecondaryCacheOptions());
+    BlockCacheOptions options;
+    options.capacity = 8000;
+    options.num_shard_bits = 0;
+    options.policy = GetParam();
+    options.tinylfu_admission = true;
+    options.secondary_cache = secondary;
+    BlockCache cache(options);
+
+    cache.Insert({1, 0}, std::string(4000, 'a'));
+    cache.Insert({1, 4000}, std::string(4000, 'b'));
+    for (int i = 0; i < 8; ++i) {
+        cache.Lookup({1, 4000});
+        cache.Lookup({1, 8000});
+    }
+    cache.Insert({1, 8000}, std::string(4000, 'c'));  // hotter than 'a': demotes it
+    ASSERT_EQ(secondary->GetStats().inserts, 1u);
+
+    // 'a' is colder than both primary blocks, so admission refuses to promote
+    // it; the block must survive in the secondary tier rather than vanish.
+    for (int round = 1; round <= 2; ++round) {
+        CachedBlock a = cache.Lookup({1, 0});
+        ASSERT_NE(a, nullptr) << "round " << round;
+        EXPECT_EQ(*a, std::string(4000, 'a'));
+        EXPECT_EQ(cache.secondary_hits(), static_cast<uint64_t>(round));
+    }
+    EXPECT_GT(cache.GetStats().admission_rejects, 0u);
+}
+
+TEST(SecondaryCacheTest, WorkingSetLargerThanPrimaryAvoidsReads) {
+    auto fm = NewMemFileManager();
+    BuildTable(*fm, "t.sst", 20000);
+
+    auto run = [&](std::shared_ptr<CompressedSecondaryCache> secondary) {
+        BlockCacheOptions options;
+        options.capacity = 64 << 10;
+        options.num_shard_bits = 0;
+        options.secondary_cache = std::move(secondary);
+        auto table = OpenTable(*fm, "t.sst", std::make_shared<BlockCache>(options));
+        std::string value;
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < 20000; i += 3) {
+                EXPECT_TRUE(table->Get(Key(i), value));
+                EXPECT_EQ(value, "value-" + std::to_string(i));
+            }
+        }
+        return table->data_block_reads();
+    };
+
+    const uint64_t primary_only = run(nullptr);
+    SecondaryCacheOptions sec_options;
+    sec_options.capacity = 1 << 20;
+    const uint64_t tiered = run(std::make_shared<CompressedSecondaryCache>(sec_options));
+    EXPECT_LT(tiered * 2, primary_only);
+}
@@ -7,9 +7,15 @@
  * ---------------
  * These tests validate the core responsibilities of the default file manager:
  *   • Path utilities: existence checks, deletion, and renaming.
- *   • Writable files: open → write (including multiple writes) → sync → close.
- *   • Readable files: open → read (all-at-once and chunked) → close.
- *   • Error paths: operating on closed handles and non-existent files.
+ *   • Writable files: open → write (including multiple writes) → sync → close,
+ *     and user-space buffering (Flush() publishes, Close() flushes, size 0 = unbuffered).
+ *   • Readable files: open → read (all-at-once and chunked) → close, reads into
+ *     caller memory, and user-space readahead with mixed read sizes.
+ *   • Random-access files: positional reads, short reads at EOF, concurrent use,
+ *     and the memory-mapped variant (zero-copy views, access hints, empty files).
+ *   • Direct I/O (POSIX): unaligned appends/flushes and unaligned reads round-trip.
+ *   • Error paths: operating on closed handles and non-existent files, and a
+ *     failed write making every later flush, sync and close fail.
  *
  * Test layout
  * -----------
@@ -20,9 +26,16 @@
 
 #include "VrootKV/io/file_manager.h"
 #include <gtest/gtest.h>
+#include <csignal>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
 
 namespace VrootKV::io {
 
@@ -231,6 +244,285 @@ TEST_F(FileManagerTest, RenameFile_NonExistent) {
     EXPECT_FALSE(file_manager_->RenameFile(src_name, target_name));
 }
 
+/**
+ * @test Positional reads return exactly the requested range; reads past EOF are short.
+ */
+TEST_F(FileManagerTest, RandomAccessFile_PositionalReads) {
+    const std::string filename = TestPath("random_access.txt");
+    std::ofstream(filename, std::ios::binary) << "0123456789abcdef";
+
+    std::unique_ptr<IRandomAccessFile> file;
+    ASSERT_TRUE(file_manager_->NewRandomAccessFile(filename, file));
+    EXPECT_EQ(file->Size(), 16u);
+
+    char scratch[16];
+    std::string_view result;
+    ASSERT_TRUE(file->Read(10, 4, scratch, &result));
+    EXPECT_EQ(result, "abcd");
+    ASSERT_TRUE(file->Read(0, 3, scratch, &result));
+    EXPECT_EQ(result, "012");
+    ASSERT_TRUE(file->Read(12, 10, scratch, &result));
+    EXPECT_EQ(result, "cdef");
+    ASSERT_TRUE(file->Read(16, 4, scratch, &result));
+    EXPECT_TRUE(result.empty());
+    EXPECT_TRUE(file->Close());
+}
+
+/**
+ * @test Sequential reads land directly in the caller's buffer.
+ */
+TEST_F(FileManagerTest, ReadableFile_ReadsIntoScratch) {
+    const std::string filename = TestPath("scratch.txt");
+    std::ofstream(filename, std::ios::binary) << "hello world";
+
+    std::unique_ptr<IReadableFile> file;
+    ASSERT_TRUE(file_manager_->NewReadableFile(filename, file));
+    char scratch[8];
+    std::string_view result;
+    ASSERT_TRUE(file->Read(5, scratch, &result));
+    EXPECT_EQ(result, "hello");
+    EXPECT_EQ(result.data(), scratch);
+    ASSERT_TRUE(file->Read(8, scratch, &result));
+    EXPECT_EQ(result, " world");
+    ASSERT_TRUE(file->Read(8, scratch, &result));
+    EXPECT_TRUE(result.empty());
+}
+
+/**
+ * @test With readahead, small and large reads interleave without losing bytes.
+ */
+TEST_F(FileManagerTest, ReadableFile_ReadaheadMixedSizes) {
+    const std::string filename = TestPath("readahead.bin");
+    std::string contents;
+    for (int i = 0; i < 100000; ++i) contents.push_back(static_cast<char>('a' + (i * 7) % 26));
+    std::ofstream(filename, std::ios::binary) << contents;
+
+    FileOptions options;
+    options.readahead_size = 4096;
+    std::unique_ptr<IReadableFile> file;
+    ASSERT_TRUE(file_manager_->NewReadableFile(filename, file, options));
+
+    std::string out;
+    std::string scratch(20000, '\0');
+    std::string_view result;
+    for (size_t i = 0;; ++i) {
+        const size_t n = (i % 5 == 4) ? 9000 : 1 + (i * 131) % 700;
+        ASSERT_TRUE(file->Read(n, scratch.data(), &result));
+        if (result.empty()) break;
+        out.append(result.data(), result.size());
+    }
+    EXPECT_EQ(out, contents);
+}
+
+/**
+ * @test Opening a non-existent file for random access should fail.
+ */
+TEST_F(FileManagerTest, NewRandomAccessFile_NonExistent) {
+    std::unique_ptr<IRandomAccessFile> file;
+    EXPECT_FALSE(file_manager_->NewRandomAccessFile(TestPath("missing.txt"), file));
+}
+
+/**
+ * @test One handle serves positional reads from several threads at once.
+ */
+TEST_F(FileManagerTest, RandomAccessFile_ConcurrentReads) {
+    const std::string filename = TestPath("concurrent.txt");
+    std::string contents;
+    for (int i = 0; i < 4096; ++i) contents.push_back(static_cast<char>('a' + i % 26));
+    std::ofstream(filename, std::ios::binary) << contents;
+
+    std::unique_ptr<IRandomAccessFile> file;
+    ASSERT_TRUE(file_manager_->NewRandomAccessFile(filename, file));
+
+    std::vector<int> mismatches(4, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            char scratch[64];
+            std::string_view result;
+            for (uint64_t off = t * 7; off + 64 <= contents.size(); off += 61) {
+                if (!file->Read(off, 64, scratch, &result) ||
+                    result != std::string_view(contents).substr(off, 64)) {
+                    ++mismatches[t];
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    for (int m : mismatches) EXPECT_EQ(m, 0);
+}
+
+/**
+ * @test Memory-mapped reads return views into the mapping, not into scratch.
+ */
+TEST_F(FileManagerTest, MmapRandomAccessFile_ZeroCopyReads) {
+    const std::string filename = TestPath("mmap.txt");
+    std::ofstream(filename, std::ios::binary) << "0123456789abcdef";
+
+    for (AccessPattern pattern : {AccessPattern::kNormal, AccessPattern::kRandom,
+                                  AccessPattern::kSequential}) {
+        FileOptions options;
+        options.use_mmap_reads = true;
+        options.access_pattern = pattern;
+        std::unique_ptr<IRandomAccessFile> file;
+        ASSERT_TRUE(file_manager_->NewRandomAccessFile(filename, file, options));
+        EXPECT_TRUE(file->ReadsInPlace());
+        EXPECT_EQ(file->Size(), 16u);
+
+        char scratch[8];
+        std::string_view result;
+        ASSERT_TRUE(file->Read(4, 4, scratch, &result));
+        EXPECT_EQ(result, "4567");
+        EXPECT_FALSE(result.data() >= scratch && result.data() < scratch + sizeof(scratch));
+        ASSERT_TRUE(file->Read(14, 8, nullptr, &result));
+        EXPECT_EQ(result, "ef");
+        ASSERT_TRUE(file->Read(20, 8, nullptr, &result));
+        EXPECT_TRUE(result.empty());
+        EXPECT_TRUE(file->Close());
+        EXPECT_FALSE(file->Read(0, 4, nullptr, &result));
+    }
+}
+
+/**
+ * @test An empty file can be opened with mmap reads (nothing to map).
+ */
+TEST_F(FileManagerTest, MmapRandomAccessFile_EmptyFile) {
+    const std::string filename = TestPath("empty.txt");
+    std::ofstream(filename, std::ios::binary).close();
+
+    FileOptions options;
+    options.use_mmap_reads = true;
+    std::unique_ptr<IRandomAccessFile> file;
+    ASSERT_TRUE(file_manager_->NewRandomAccessFile(filename, file, options));
+    EXPECT_EQ(file->Size(), 0u);
+    std::string_view result;
+    ASSERT_TRUE(file->Read(0, 4, nullptr, &result));
+    EXPECT_TRUE(result.empty());
+}
+
+/**
+ * @test Small appends stay in the user-space buffer until Flush().
+ */
+TEST_F(FileManagerTest, BufferedWrites_VisibleAfterFlush) {
+    const std::string filename = TestPath("buffered.txt");
+    std::unique_ptr<IWritableFile> file;
+    ASSERT_TRUE(file_manager_->NewWritableFile(filename, file));
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(file->Write("0123456789"));
+    }
+    EXPECT_EQ(std::filesystem::file_size(filename), 0u);
+    ASSERT_TRUE(file->Flush());
+    EXPECT_EQ(std::filesystem::file_size(filename), 1000u);
+
+    ASSERT_TRUE(file->Write("tail"));
+    ASSERT_TRUE(file->Close());
+    EXPECT_EQ(std::filesystem::file_size(filename), 1004u);
+}
+
+/**
+ * @test Appends that overflow the buffer (or exceed it) are written in order.
+ */
+TEST_F(FileManagerTest, BufferedWrites_OverflowPreservesOrder) {
+    const std::string filename = TestPath("overflow.txt");
+    FileOptions options;
+    options.write_buffer_size = 16;
+    std::unique_ptr<IWritableFile> file;
+    ASSERT_TRUE(file_manager_->NewWritableFile(filename, file, options));
+
+    std::string expected;
+    for (int i = 0; i < 50; ++i) {
+        const std::string chunk(static_cast<size_t>(i % 23), static_cast<char>('a' + i % 26));
+        ASSERT_TRUE(file->Write(chunk));
+        expected += chunk;
+    }
+    ASSERT_TRUE(file->Close());
+
+    std::ifstream in(filename, std::ios::binary);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    EXPECT_EQ(contents.str(), expected);
+}
+
+/**
+ * @test Incremental syncing (bytes_per_sync) does not change what is written.
+ */
+TEST_F(FileManagerTest, BytesPerSync_PreservesContents) {
+    const std::string filename = TestPath("bytes_per_sync.txt");
+    FileOptions options;
+    options.write_buffer_size = 1000;
+    options.bytes_per_sync = 4096;
+    std::unique_ptr<IWritableFile> file;
+    ASSERT_TRUE(file_manager_->NewWritableFile(filename, file, options));
+
+    std::string expected;
+    for (int i = 0; i < 500; ++i) {
+        const std::string chunk(97, static_cast<char>('a' + i % 26));
+        ASSERT_TRUE(file->Write(chunk));
+        expected += chunk;
+    }
+    ASSERT_TRUE(file->Sync());
+    ASSERT_TRUE(file->Close());
+
+    std::ifstream in(filename, std::ios::binary);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    EXPECT_EQ(contents.str(), expected);
+}
+
+/**
+ * @test A zero-sized buffer makes every Write() reach the OS immediately.
+ */
+TEST_F(FileManagerTest, UnbufferedWrites_VisibleImmediately) {
+    const std::string filename = TestPath("unbuffered.txt");
+    FileOptions options;
+    options.write_buffer_size = 0;
+    std::unique_ptr<IWritableFile> file;
+    ASSERT_TRUE(file_manager_->NewWritableFile(filename, file, options));
+    ASSERT_TRUE(file->Write("abc"));
+    EXPECT_EQ(std::filesystem::file_size(filename), 3u);
+}
+
+#ifndef _WIN32
+/**
+ * @test O_DIRECT writes with unaligned appends and mid-stream flushes produce
+ * exactly the logical bytes; O_DIRECT reads at unaligned offsets return them.
+ */
+TEST_F(FileManagerTest, DirectIO_UnalignedRoundTrip) {
+    const std::string filename = TestPath("direct.bin");
+    FileOptions options;
+    options.use_direct_io = true;
+    options.write_buffer_size = 8192;
+
+    std::string expected;
+    {
+        std::unique_ptr<IWritableFile> file;
+        ASSERT_TRUE(file_manager_->NewWritableFile(filename, file, options));
+        for (int i = 0; i < 300; ++i) {
+            const std::string chunk(static_cast<size_t>(1 + (i * 37) % 700), static_cast<char>('A' + i % 26));
+            ASSERT_TRUE(file->Write(chunk));
+            expected += chunk;
+            if (i % 40 == 0) {
+                ASSERT_TRUE(file->Flush());
+                EXPECT_EQ(std::filesystem::file_size(filename), expected.size());
+            }
+        }
+        ASSERT_TRUE(file->Close());
+    }
+    ASSERT_EQ(std::filesystem::file_size(filename), expected.size());
+
+    std::unique_ptr<IRandomAccessFile> file;
+    ASSERT_TRUE(file_manager_->NewRandomAccessFile(filename, file, options));
+    std::string scratch(10000, '\0');
+    std::string_view result;
+    for (uint64_t off : {uint64_t{0}, uint64_t{1}, uint64_t{4095}, uint64_t{4096}, uint64_t{12345}}) {
+        ASSERT_TRUE(file->Read(off, 5000, scratch.data(), &result));
+        EXPECT_EQ(result, std::string_view(expected).substr(off, 5000)) << off;
+    }
+    ASSERT_TRUE(file->Read(expected.size() - 10, 100, scratch.data(), &result));
+    EXPECT_EQ(result, std::string_view(expected).substr(expected.size() - 10));
+}
+#endif
+
 /**
  * @test After closing a writable file, subsequent writes must fail.
  */
@@ -242,6 +534,56 @@ TEST_F(FileManagerTest, Write_AfterClose) {
     EXPECT_FALSE(writable_file->Write("test"));
 }
 
+#ifdef __linux__
+/**
+ * @test A failed write to the OS is sticky: later Flush/Sync/Close also fail
+ * instead of reporting success over the dropped bytes (/dev/full: ENOSPC).
+ */
+TEST_F(FileManagerTest, BufferedWrites_FailedFlushIsSticky) {
+    std::unique_ptr<IWritableFile> file;
+    ASSERT_TRUE(file_manager_->NewWritableFile("/dev/full", file));
+    ASSERT_TRUE(file->Write("buffered"));
+    EXPECT_FALSE(file->Flush());
+    EXPECT_FALSE(file->Flush());
+    EXPECT_FALSE(file->Write("more"));
+    EXPECT_FALSE(file->Sync());
+    EXPECT_FALSE(file->Close());
+}
+
+/**
+ * @test The O_DIRECT writer makes the same failure sticky, including one hit
+ * mid-`Write()` after part of the data was already buffered. O_DIRECT cannot
+ * open /dev/full, so a file-size limit makes the second block fail (EFBIG).
+ */
+TEST_F(FileManagerTest, DirectIO_FailedWriteIsSticky) {
+    FileOptions options;
+    options.use_direct_io = true;
+    options.write_buffer_size = 4096;
+    std::unique_ptr<IWritableFile> file;
+    ASSERT_TRUE(file_manager_->NewWritableFile(TestPath("direct_full.bin"), file, options));
+
+    rlimit old_limit{};
+    ASSERT_EQ(::getrlimit(RLIMIT_FSIZE, &old_limit), 0);
+    rlimit limit = old_limit;
+    limit.rlim_cur = 4096;
+    auto old_handler = std::signal(SIGXFSZ, SIG_IGN);
+    ASSERT_EQ(::setrlimit(RLIMIT_FSIZE, &limit), 0);
+
+    const bool wrote = file->Write(std::string(10000, 'x'));  // block 1 lands, block 2 fails
+    const bool wrote_more = file->Write("more");
+    const bool flushed = file->Flush();
+
+    ::setrlimit(RLIMIT_FSIZE, &old_limit);
+    std::signal(SIGXFSZ, old_handler);
+
+    EXPECT_FALSE(wrote);
+    EXPECT_FALSE(wrote_more);
+    EXPECT_FALSE(flushed);
+    EXPECT_FALSE(file->Sync());
+    EXPECT_FALSE(file->Close());
+}
+#endif
+
 /**
  * @test After closing a readable file, subsequent reads should return 0 (no data).
  */
@@ -0,0 +1,122 @@
+/**
+ * @file test_io_stats.cpp
+ * @author Vrutik Halani
+ * @brief Tests for `IOStats` and the instrumenting file-manager decorator.
+ *
+ * What these tests cover
+ * ----------------------
+ * • File names map to the expected file classes.
+ * • Writes, flushes, syncs, sequential reads and preads are counted with
+ *   their byte totals under the right class, with latencies recorded.
+ * • Injected device latency shows up in the pread histogram.
+ * • Disabled stats record nothing while files keep working.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "VrootKV/io/io_stats.h"
+#include "VrootKV/io/mem_file_manager.h"
+
+using namespace VrootKV::io;
+
+TEST(IOStatsTest, ClassifyFile) {
+    EXPECT_EQ(ClassifyFile("/db/000012.log"), FileClass::kWAL);
+    EXPECT_EQ(ClassifyFile("/db/000013.sst"), FileClass::kSSTable);
+    EXPECT_EQ(ClassifyFile("C:\\db\\000013.ldb"), FileClass::kSSTable);
+    EXPECT_EQ(ClassifyFile("/db/MANIFEST-000004"), FileClass::kManifest);
+    EXPECT_EQ(ClassifyFile("CURRENT"), FileClass::kManifest);
+    EXPECT_EQ(ClassifyFile("/db/000020.blob"), FileClass::kBlob);
+    EXPECT_EQ(ClassifyFile("/db/LOCK"), FileClass::kOther);
+    EXPECT_EQ(ClassifyFile("/db.log/data"), FileClass::kOther);
+}
+
+TEST(IOStatsTest, CountsOpsAndBytesPerClass) {
+    IOStats stats;
+    auto fm = NewInstrumentedFileManager(NewMemFileManager(), &stats);
+
+    std::unique_ptr<IWritableFile> wal;
+    ASSERT_TRUE(fm->NewWritableFile("/db/000001.log", wal));
+    for (int i = 0; i < 10; ++i) ASSERT_TRUE(wal->Write(std::string(100, 'w')));
+    ASSERT_TRUE(wal->Sync());
+    ASSERT_TRUE(wal->Close());
+
+    std::unique_ptr<IWritableFile> sst;
+    ASSERT_TRUE(fm->NewWritableFile("/db/000002.sst", sst));
+    ASSERT_TRUE(sst->Write(std::string(5000, 's')));
+    ASSERT_TRUE(sst->Close());
+
+    std::unique_ptr<IRandomAccessFile> ra;
+    ASSERT_TRUE(fm->NewRandomAccessFile("/db/000002.sst", ra));
+    char scratch[1000];
+    std::string_view got;
+    for (int i = 0; i < 5; ++i) ASSERT_TRUE(ra->Read(i * 1000, sizeof(scratch), scratch, &got));
+    ASSERT_TRUE(ra->Read(4900, sizeof(scratch), scratch, &got));  // short read at EOF
+
+    std::unique_ptr<IReadableFile> seq;
+    ASSERT_TRUE(fm->NewReadableFile("/db/000001.log", seq));
+    std::string all;
+    EXPECT_EQ(seq->Read(4096, &all), 1000u);
+
+    EXPECT_EQ(stats.Count(FileClass::kWAL, IOOp::kWrite), 10u);
+    EXPECT_EQ(stats.Bytes(FileClass::kWAL, IOOp::kWrite), 1000u);
+    EXPECT_EQ(stats.Count(FileClass::kWAL, IOOp::kSync), 1u);
+    EXPECT_EQ(stats.Count(FileClass::kWAL, IOOp::kRead), 1u);
+    EXPECT_EQ(stats.Bytes(FileClass::kWAL, IOOp::kRead), 1000u);
+
+    EXPECT_EQ(stats.Bytes(FileClass::kSSTable, IOOp::kWrite), 5000u);
+    EXPECT_EQ(stats.Count(FileClass::kSSTable, IOOp::kFlush), 1u);
+    EXPECT_EQ(stats.Count(FileClass::kSSTable, IOOp::kPRead), 6u);
+    EXPECT_EQ(stats.Bytes(FileClass::kSSTable, IOOp::kPRead), 5100u);
+    EXPECT_EQ(stats.Count(FileClass::kManifest, IOOp::kWrite), 0u);
+
+    const std::string report = stats.ToString();
+    EXPECT_NE(report.find("wal"), std::string::npos);
+    EXPECT_NE(report.find("pread"), std::string::npos);
+
+    stats.Reset();
+    EXPECT_EQ(stats.Count(FileClass::kSSTable, IOOp::kPRead), 0u);
+    EXPECT_EQ(stats.Bytes(FileClass::kWAL, IOOp::kWrite), 0u);
+}
+
+TEST(IOStatsTest, LatencyHistogramReflectsDevice) {
+    MemDeviceModel model;
+    model.read_latency_us = 300;
+    IOStats stats;
+    auto fm = NewInstrumentedFileManager(NewMemFileManager(model), &stats);
+
+    std::unique_ptr<IWritableFile> w;
+    ASSERT_TRUE(fm->NewWritableFile("t.sst", w));
+    ASSERT_TRUE(w->Write(std::string(4096, 'x')));
+    ASSERT_TRUE(w->Close());
+    std::unique_ptr<IRandomAccessFile> ra;
+    ASSERT_TRUE(fm->NewRandomAccessFile("t.sst", ra));
+    char scratch[4096];
+    std::string_view got;
+    for (int i = 0; i < 20; ++i) ASSERT_TRUE(ra->Read(0, sizeof(scratch), scratch, &got));
+
+    const auto& h = stats.Latency(FileClass::kSSTable, IOOp::kPRead);
+    EXPECT_EQ(h.Count(), 20u);
+    EXPECT_GE(h.Percentile(50.0), 300u * 1000u * 7 / 8);
+    EXPECT_GE(h.Min(), 300u * 1000u);
+}
+
+TEST(IOStatsTest, DisabledRecordsNothing) {
+    IOStats stats(/*enabled=*/false);
+    auto fm = NewInstrumentedFileManager(NewMemFileManager(), &stats);
+    std::unique_ptr<IWritableFile> w;
+    ASSERT_TRUE(fm->NewWritableFile("x.log", w));
+    ASSERT_TRUE(w->Write("abc"));
+    ASSERT_TRUE(w->Sync());
+    ASSERT_TRUE(w->Close());
+    EXPECT_EQ(stats.Count(FileClass::kWAL, IOOp::kWrite), 0u);
+    EXPECT_EQ(stats.ToString(), "");
+
+    stats.SetEnabled(true);
+    std::unique_ptr<IReadableFile> r;
+    ASSERT_TRUE(fm->NewReadableFile("x.log", r));
+    std::string data;
+    EXPECT_EQ(r->Read(10, &data), 3u);
+    EXPECT_EQ(data, "abc");
+    EXPECT_EQ(stats.Count(FileClass::kWAL, IOOp::kRead), 1u);
+}
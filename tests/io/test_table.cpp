@@ -0,0 +1,417 @@
+/**
+ * @file test_table.cpp
+ * @author Vrutik Halani
+ * @brief Tests for the full-table writer/reader (`TableBuilder` / `TableReader`).
+ *
+ * What these tests cover
+ * ----------------------
+ * • Round trip of many entries across multiple data blocks (hits and misses).
+ * • Tables written without a filter still answer correctly.
+ * • Per-level filter sizing: on a three-level dataset, Monkey-style allocation
+ *   uses no more filter memory than a uniform allocation and performs fewer
+ *   data-block reads for absent keys.
+ * • Range filter meta block: short scans over a sparse key space skip most
+ *   overlapping tables.
+ * • Partitioned filters: only the top-level partition index stays resident and
+ *   lookups load just the covering partition.
+ * • Tables with the legacy footer (filter handle = Bloom block) stay readable.
+ * • Concurrent Get() from many threads on one reader (positional reads).
+ * • Memory-mapped table files answer identically to pread-backed ones.
+ * • Ordering violations are rejected.
+ * • Iteration: full forward/backward walks across block boundaries and Seek
+ *   to present, absent, leading and trailing keys.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/io/sstable_blocks.h"
+#include "src/io/table_builder.h"
+#include "src/io/table_reader.h"
+#include "VrootKV/common/bloom_filter.h"
+#include "VrootKV/common/filter_budget.h"
+#include "VrootKV/io/file_manager.h"
+
+using namespace VrootKV::io;
+using VrootKV::common::FilterBudget;
+
+namespace {
+
+std::string Key(int level, int i) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "L%d-key%08d", level, i);
+    return buf;
+}
+
+} // namespace
+
+class TableTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const auto* test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+        test_dir_ = std::filesystem::temp_directory_path() / test_info->name();
+        std::filesystem::create_directory(test_dir_);
+        file_manager_ = NewDefaultFileManager();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    std::string TestPath(const std::string& filename) {
+        return (test_dir_ / filename).string();
+    }
+
+    /**
+     * @brief Build a table of `n` keys for `level`, then open it for reading.
+     */
+    std::unique_ptr<TableReader> BuildTable(const std::string& name, int level, int n,
+                                            const TableBuilderOptions& options) {
+        std::unique_ptr<IWritableFile> file;
+        EXPECT_TRUE(file_manager_->NewWritableFile(TestPath(name), file));
+        TableBuilder builder(options, file.get());
+        for (int i = 0; i < n; ++i) {
+            builder.Add(Key(level, i), "value-" + std::to_string(i));
+        }
+        EXPECT_TRUE(builder.Finish());
+        EXPECT_TRUE(file->Close());
+
+        std::unique_ptr<IRandomAccessFile> in;
+        EXPECT_TRUE(file_manager_->NewRandomAccessFile(TestPath(name), in));
+        return TableReader::Open(std::move(in));
+    }
+
+    std::filesystem::path test_dir_;
+    std::unique_ptr<IFileManager> file_manager_;
+};
+
+TEST_F(TableTest, RoundTripManyBlocks) {
+    TableBuilderOptions options;
+    options.block_size = 512;
+    auto table = BuildTable("t.sst", 0, 5000, options);
+    ASSERT_TRUE(table->HasFilter());
+
+    std::string value;
+    for (int i = 0; i < 5000; i += 7) {
+        ASSERT_TRUE(table->Get(Key(0, i), value)) << i;
+        EXPECT_EQ(value, "value-" + std::to_string(i));
+    }
+    EXPECT_FALSE(table->Get(Key(0, 5000), value));
+    EXPECT_FALSE(table->Get("A-before-everything", value));
+    EXPECT_FALSE(table->Get("zzz-after-everything", value));
+}
+
+TEST_F(TableTest, ConcurrentGetsShareOneReader) {
+    TableBuilderOptions options;
+    options.block_size = 512;
+    auto table = BuildTable("mt.sst", 0, 4000, options);
+
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            std::string value;
+            for (int i = t; i < 4000; i += 4) {
+                if (!table->Get(Key(0, i), value) || value != "value-" + std::to_string(i)) {
+                    ++mismatches[t];
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    for (int m : mismatches) EXPECT_EQ(m, 0);
+    EXPECT_EQ(table->data_block_reads(), 4000u);
+}
+
+TEST_F(TableTest, MmapReaderMatchesPreadReader) {
+    TableBuilderOptions options;
+    options.block_size = 512;
+    auto pread_table = BuildTable("mm.sst", 0, 2000, options);
+
+    FileOptions file_options;
+    file_options.use_mmap_reads = true;
+    file_options.access_pattern = AccessPattern::kRandom;
+    std::unique_ptr<IRandomAccessFile> in;
+    ASSERT_TRUE(file_manager_->NewRandomAccessFile(TestPath("mm.sst"), in, file_options));
+    auto mmap_table = TableReader::Open(std::move(in));
+
+    std::string a, b;
+    for (int i = 0; i < 2100; i += 3) {
+        const bool found = pread_table->Get(Key(0, i), a);
+        ASSERT_EQ(mmap_table->Get(Key(0, i), b), found) << i;
+        if (found) {
+            EXPECT_EQ(a, b);
+        }
+    }
+}
+
+TEST_F(TableTest, NoFilterWhenBitsPerKeyIsZero) {
+    TableBuilderOptions options;
+    options.bits_per_key = 0;
+    auto table = BuildTable("nofilter.sst", 0, 100, options);
+    EXPECT_FALSE(table->HasFilter());
+    EXPECT_EQ(table->FilterSize(), 0u);
+
+    std::string value;
+    EXPECT_TRUE(table->Get(Key(0, 42), value));
+    EXPECT_FALSE(table->Get(Key(1, 42), value));
+    EXPECT_EQ(table->data_block_reads(), 2u);
+}
+
+TEST_F(TableTest, RejectsOutOfOrderKeys) {
+    std::unique_ptr<IWritableFile> file;
+    ASSERT_TRUE(file_manager_->NewWritableFile(TestPath("bad.sst"), file));
+    TableBuilder builder(TableBuilderOptions{}, file.get());
+    builder.Add("b", "1");
+    EXPECT_THROW(builder.Add("a", "2"), std::runtime_error);
+    EXPECT_THROW(builder.Add("b", "2"), std::runtime_error);
+}
+
+/**
+ * @test Filter memory vs. lookup I/O on a multi-level dataset.
+ *
+ * Three levels with a 10x size ratio are built twice with the same average
+ * budget (4 bits/key): once uniformly, once with the per-level allocation.
+ * Absent-key lookups probe every level; we count data-block reads.
+ */
+TEST_F(TableTest, PerLevelFilterBudgetReducesLookupIO) {
+    const std::vector<int> sizes = {300, 3'000, 30'000};
+    const double avg_bits = 4.0;
+
+    FilterBudget budget(avg_bits);
+    budget.SetLevelEntries({300, 3'000, 30'000});
+
+    std::uint64_t uniform_bytes = 0, monkey_bytes = 0;
+    std::uint64_t uniform_reads = 0, monkey_reads = 0;
+
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<std::unique_ptr<TableReader>> tables;
+        for (int level = 0; level < static_cast<int>(sizes.size()); ++level) {
+            TableBuilderOptions options;
+            options.level = level;
+            if (pass == 0) {
+                options.bits_per_key = avg_bits;
+            } else {
+                options.filter_budget = &budget;
+            }
+            tables.push_back(BuildTable("p" + std::to_string(pass) + "_L" + std::to_string(level) + ".sst",
+                                        level, sizes[level], options));
+        }
+
+        std::string value;
+        for (int i = 0; i < 20'000; ++i) {
+            for (const auto& t : tables) {
+                // Same prefixes as the stored keys, but indices beyond every level.
+                EXPECT_FALSE(t->Get(Key(&t - tables.data(), 100'000 + i), value));
+            }
+        }
+
+        std::uint64_t bytes = 0, reads = 0;
+        for (const auto& t : tables) {
+            bytes += t->FilterSize();
+            reads += t->data_block_reads();
+        }
+        (pass == 0 ? uniform_bytes : monkey_bytes) = bytes;
+        (pass == 0 ? uniform_reads : monkey_reads) = reads;
+    }
+
+    // Same memory (allow header/rounding slack), markedly fewer wasted reads.
+    EXPECT_LE(monkey_bytes, uniform_bytes + 64);
+    EXPECT_LT(monkey_reads, uniform_reads * 9 / 10)
+        << "uniform=" << uniform_reads << " monkey=" << monkey_reads;
+}
+
+/**
+ * @test Partitioned filter: small resident index, partitions loaded on demand.
+ */
+TEST_F(TableTest, PartitionedFilterLoadsOnlyCoveringPartition) {
+    TableBuilderOptions options;
+    options.block_size = 512;
+    options.filter_partition_size = 1024;
+    const int n = 20'000;
+
+    std::unique_ptr<IWritableFile> file;
+    ASSERT_TRUE(file_manager_->NewWritableFile(TestPath("part.sst"), file));
+    TableBuilder builder(options, file.get());
+    for (int i = 0; i < n; ++i) builder.Add(Key(0, i), "value-" + std::to_string(i));
+    ASSERT_TRUE(builder.Finish());
+    ASSERT_TRUE(file->Close());
+    EXPECT_GT(builder.NumFilterPartitions(), 10u);
+
+    std::unique_ptr<IRandomAccessFile> in;
+    ASSERT_TRUE(file_manager_->NewRandomAccessFile(TestPath("part.sst"), in));
+    TableReaderOptions reader_options;
+    reader_options.filter_partition_cache_size = 4;
+    auto table = TableReader::Open(std::move(in), reader_options);
+
+    ASSERT_TRUE(table->HasPartitionedFilter());
+    // Only the top-level index is resident: a small fraction of all filter bytes.
+    EXPECT_LT(table->FilterSize() * 10, builder.FilterSize());
+    EXPECT_EQ(table->filter_partition_loads(), 0u);
+
+    // Lookups clustered in one key region touch a single partition.
+    std::string value;
+    for (int i = 100; i < 110; ++i) {
+        ASSERT_TRUE(table->Get(Key(0, i), value));
+    }
+    EXPECT_EQ(table->filter_partition_loads(), 1u);
+
+    // Every key is still found; absent keys in range are mostly filtered out.
+    for (int i = 0; i < n; ++i) {
+        ASSERT_TRUE(table->Get(Key(0, i), value)) << i;
+    }
+    const std::uint64_t reads_before = table->data_block_reads();
+    for (int i = 0; i < n; ++i) {
+        EXPECT_FALSE(table->Get(Key(0, i) + "x", value));
+    }
+    EXPECT_LT(table->data_block_reads() - reads_before, static_cast<std::uint64_t>(n / 20));
+
+    // Keys before the first partition are rejected without loading anything.
+    const std::uint64_t loads = table->filter_partition_loads();
+    EXPECT_FALSE(table->KeyMayMatch("A"));
+    EXPECT_EQ(table->filter_partition_loads(), loads);
+}
+
+/**
+ * @test Short-scan I/O on a sparse key space.
+ *
+ * Twenty tables each hold a handful of "users" spread over the whole key
+ * space, so every table's key range overlaps every scan. Scans over a single
+ * user must open every table without a range filter, but only the tables that
+ * actually hold that user with one.
+ */
+TEST_F(TableTest, RangeFilterSkipsTablesOnShortScans) {
+    auto user_key = [](int user, int item) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "user%04d:%05d", user, item);
+        return std::string(buf);
+    };
+    const int kTables = 20;
+
+    std::uint64_t opened[2] = {0, 0};
+    for (int with_filter = 0; with_filter < 2; ++with_filter) {
+        std::vector<std::unique_ptr<TableReader>> tables;
+        for (int t = 0; t < kTables; ++t) {
+            const std::string name = "scan" + std::to_string(with_filter) + "_" + std::to_string(t) + ".sst";
+            std::unique_ptr<IWritableFile> file;
+            ASSERT_TRUE(file_manager_->NewWritableFile(TestPath(name), file));
+            TableBuilderOptions options;
+            options.range_filter_prefix_len = with_filter ? 8 : 0;
+            TableBuilder builder(options, file.get());
+            // Users t, t+20, t+40, ... : sparse and interleaved across tables.
+            for (int u = t; u < 1000; u += kTables * 5) {
+                for (int i = 0; i < 50; ++i) builder.Add(user_key(u, i), "v");
+            }
+            ASSERT_TRUE(builder.Finish());
+            EXPECT_EQ(builder.RangeFilterSize() > 0, with_filter == 1);
+            ASSERT_TRUE(file->Close());
+
+            std::unique_ptr<IRandomAccessFile> in;
+            ASSERT_TRUE(file_manager_->NewRandomAccessFile(TestPath(name), in));
+            tables.push_back(TableReader::Open(std::move(in)));
+            EXPECT_EQ(tables.back()->HasRangeFilter(), with_filter == 1);
+        }
+
+        for (int u = 0; u < 1000; ++u) {
+            const std::string lo = user_key(u, 0), hi = user_key(u, 99999);
+            int matches = 0;
+            for (const auto& t : tables) {
+                if (t->RangeMayMatch(lo, hi)) ++matches;
+            }
+            // Exactly one table holds user u when u % 100 < 20; none otherwise.
+            const int expected = (u % (kTables * 5)) < kTables ? 1 : 0;
+            if (with_filter) {
+                EXPECT_EQ(matches, expected) << "user " << u;
+            } else {
+                EXPECT_EQ(matches, kTables);
+            }
+            opened[with_filter] += static_cast<std::uint64_t>(matches);
+        }
+    }
+    EXPECT_LT(opened[1] * 50, opened[0]);
+}
+
+/**
+ * @test The iterator visits every entry in order in both directions and
+ *       crosses data blocks when seeking and stepping.
+ */
+TEST_F(TableTest, IteratorWalksAllBlocks) {
+    TableBuilderOptions options;
+    options.block_size = 256;
+    constexpr int kN = 1000;
+    auto table = BuildTable("it.sst", 0, kN, options);
+    auto it = table->NewIterator();
+    EXPECT_FALSE(it->Valid());
+
+    int i = 0;
+    for (it->SeekToFirst(); it->Valid(); it->Next(), ++i) {
+        ASSERT_EQ(it->key(), Key(0, i));
+        ASSERT_EQ(it->value(), "value-" + std::to_string(i));
+    }
+    EXPECT_EQ(i, kN);
+
+    i = kN - 1;
+    for (it->SeekToLast(); it->Valid(); it->Prev(), --i) {
+        ASSERT_EQ(it->key(), Key(0, i));
+    }
+    EXPECT_EQ(i, -1);
+
+    it->Seek(Key(0, 500));
+    ASSERT_TRUE(it->Valid());
+    EXPECT_EQ(it->key(), Key(0, 500));
+    it->Prev();
+    ASSERT_TRUE(it->Valid());
+    EXPECT_EQ(it->key(), Key(0, 499));
+
+    it->Seek(Key(0, 500) + "x");  // between keys
+    ASSERT_TRUE(it->Valid());
+    EXPECT_EQ(it->key(), Key(0, 501));
+
+    it->Seek("A");
+    ASSERT_TRUE(it->Valid());
+    EXPECT_EQ(it->key(), Key(0, 0));
+
+    it->Seek("zzz");
+    EXPECT_FALSE(it->Valid());
+}
+
+/**
+ * @test A table whose footer uses the legacy magic (filter handle = Bloom block)
+ *       is still readable.
+ */
+TEST_F(TableTest, ReadsLegacyFooterLayout) {
+    DataBlockBuilder data;
+    data.Add("apple", "1");
+    data.Add("banana", "2");
+    const std::string data_bytes = data.Finish();
+
+    VrootKV::common::BloomFilter bloom(2, 0.01);
+    bloom.add("apple");
+    bloom.add("banana");
+    const std::string bloom_bytes = bloom.serialize();
+
+    IndexBlockBuilder index;
+    index.Add("apple", BlockHandle{0, data_bytes.size()});
+    const std::string index_bytes = index.Finish();
+
+    SSTableFooter footer;   // legacy magic by default
+    footer.filter_handle = BlockHandle{data_bytes.size(), bloom_bytes.size()};
+    footer.index_handle = BlockHandle{data_bytes.size() + bloom_bytes.size(), index_bytes.size()};
+
+    std::string file = data_bytes + bloom_bytes + index_bytes;
+    footer.EncodeTo(file);
+
+    auto table = TableReader::Open(file);
+    EXPECT_TRUE(table->HasFilter());
+    EXPECT_FALSE(table->HasRangeFilter());
+    std::string value;
+    EXPECT_TRUE(table->Get("banana", value));
+    EXPECT_EQ(value, "2");
+    EXPECT_FALSE(table->Get("cherry", value));
+    EXPECT_TRUE(table->RangeMayMatch("x", "y"));
+}
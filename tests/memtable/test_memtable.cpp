@@ -1,7 +1,7 @@
 /**
  * @file test_memtable.cpp
  * @author Vrutik Halani
- * @brief Unit tests for the single-threaded Skip List used by the Memtable.
+ * @brief Unit tests for the Skip List and the MemTable built on it.
  *
  * What these tests verify
  * -----------------------
@@ -9,16 +9,28 @@
  * • Duplicate insertion rejection on Insert()
  * • Ordered forward iteration over all keys
  * • Seek(target) positions at the first key >= target
+ * • MemTable: tombstones, ordered iteration, and the optional Bloom filter that
+ *   short-circuits lookups for absent keys
+ * • MemTable iterators: bidirectional, tag-preserving, unaffected by later
+ *   inserts and overwrites, and able to keep their memtable alive
+ * • One writer running alongside readers that iterate the same list
  */
 
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <random>
+#include <atomic>
+#include <cstdio>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "src/memtable/memtable.h"
 #include "src/memtable/skip_list.h"
 
+using VrootKV::memtable::MemTable;
+using VrootKV::memtable::MemTableOptions;
 using VrootKV::memtable::SkipList;
 
 TEST(SkipList, Empty_OnStart) {
@@ -171,3 +183,180 @@ TEST(SkipList, Many_Inserts_Random_Order) {
     EXPECT_TRUE(sl.Get("k50", v)); EXPECT_EQ(v, "vk50");
     EXPECT_TRUE(sl.Get("k99", v)); EXPECT_EQ(v, "vk99");
 }
+
+TEST(MemTable, Put_Delete_Get) {
+    MemTable mt;
+    std::string v;
+    EXPECT_EQ(mt.Get("a", v), MemTable::LookupResult::kNotFound);
+
+    mt.Put("a", "1");
+    mt.Put("b", "");
+    ASSERT_EQ(mt.Get("a", v), MemTable::LookupResult::kFound);
+    EXPECT_EQ(v, "1");
+    ASSERT_EQ(mt.Get("b", v), MemTable::LookupResult::kFound);
+    EXPECT_EQ(v, "");
+
+    mt.Delete("a");
+    EXPECT_EQ(mt.Get("a", v), MemTable::LookupResult::kDeleted);
+    mt.Put("a", "2");
+    ASSERT_EQ(mt.Get("a", v), MemTable::LookupResult::kFound);
+    EXPECT_EQ(v, "2");
+
+    // Tombstone for a never-written key is still recorded.
+    mt.Delete("c");
+    EXPECT_EQ(mt.Get("c", v), MemTable::LookupResult::kDeleted);
+    EXPECT_EQ(mt.size(), 3u);
+    EXPECT_GT(mt.ApproximateMemoryUsage(), 0u);
+}
+
+TEST(MemTable, Iteration_Exposes_Tombstones) {
+    MemTable mt;
+    mt.Put("b", "2");
+    mt.Delete("a");
+    mt.Put("c", "3");
+
+    std::vector<std::string> seen;
+    for (auto it = mt.Begin(); it.Valid(); it.Next()) {
+        seen.push_back(it.key() + (it.IsDeletion() ? "=DEL" : "=" + it.value()));
+    }
+    std::vector<std::string> expected = {"a=DEL", "b=2", "c=3"};
+    EXPECT_EQ(seen, expected);
+
+    auto it = mt.Seek("bb");
+    ASSERT_TRUE(it.Valid());
+    EXPECT_EQ(it.key(), "c");
+}
+
+TEST(MemTable, Iterator_Is_Bidirectional_And_Stable) {
+    MemTable mt;
+    mt.Put("b", "2");
+    mt.Delete("a");
+    mt.Put("d", "4");
+
+    auto it = mt.NewIterator();
+    EXPECT_FALSE(it->Valid());
+    mt.Put("c", "3");  // not visible to the iterator
+    mt.Put("d", "5");  // nor is the overwrite
+    mt.Put("0", "0");  // nor a key before the first one
+
+    std::vector<std::string> seen;
+    for (it->SeekToFirst(); it->Valid(); it->Next()) {
+        seen.emplace_back(it->key());
+    }
+    EXPECT_EQ(seen, (std::vector<std::string>{"a", "b", "d"}));
+
+    it->SeekToLast();
+    ASSERT_TRUE(it->Valid());
+    EXPECT_EQ(it->key(), "d");
+    EXPECT_EQ(it->value(), std::string(1, MemTable::kTypeValue) + "4");
+    it->Prev();
+    it->Prev();
+    ASSERT_TRUE(it->Valid());
+    EXPECT_EQ(it->value(), std::string(1, MemTable::kTypeDeletion));
+    it->Prev();
+    EXPECT_FALSE(it->Valid());
+
+    it->Seek("c");
+    ASSERT_TRUE(it->Valid());
+    EXPECT_EQ(it->key(), "d");
+    it->Prev();
+    ASSERT_TRUE(it->Valid());
+    EXPECT_EQ(it->key(), "b");
+
+    // A fresh iterator sees everything.
+    auto fresh = mt.NewIterator();
+    fresh->Seek("c");
+    ASSERT_TRUE(fresh->Valid());
+    EXPECT_EQ(fresh->key(), "c");
+    fresh->Next();
+    EXPECT_EQ(fresh->value(), std::string(1, MemTable::kTypeValue) + "5");
+}
+
+TEST(MemTable, Iterator_Keeps_MemTable_Alive) {
+    auto mt = std::make_shared<MemTable>();
+    mt->Put("k", "v");
+    auto it = mt->NewIterator(mt);
+    mt.reset();
+    it->SeekToFirst();
+    ASSERT_TRUE(it->Valid());
+    EXPECT_EQ(it->key(), "k");
+}
+
+TEST(SkipList, Readers_Run_Alongside_Writer) {
+    SkipList sl;
+    constexpr int kKeys = 20000;
+    auto key = [](int i) {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "k%06d", (i * 7919) % kKeys);  // scattered order
+        return std::string(buf);
+    };
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int i = 0; i < kKeys; ++i) sl.Put(key(i), "v1");
+        for (int i = 0; i < kKeys; i += 3) sl.Put(key(i), "v2");
+        done.store(true);
+    });
+
+    // Each scan must be strictly ordered and must not change under it. Only
+    // non-fatal checks run while the writer is live, so it is always joined.
+    int scans = 0;
+    bool consistent = true;
+    while (consistent && (!done.load() || scans < 2)) {
+        auto it = sl.NewIterator();
+        std::vector<std::string> forward;
+        for (it.SeekToFirst(); consistent && it.Valid(); it.Next()) {
+            consistent = (it.value() == "v1" || it.value() == "v2") &&
+                         (forward.empty() || forward.back() < it.key());
+            forward.push_back(it.key());
+        }
+        std::vector<std::string> backward;
+        for (it.SeekToLast(); it.Valid(); it.Prev()) backward.push_back(it.key());
+        std::reverse(backward.begin(), backward.end());
+        if (consistent && forward != backward) consistent = false;
+        EXPECT_TRUE(consistent) << "scan " << scans;
+        ++scans;
+    }
+    writer.join();
+    ASSERT_TRUE(consistent);
+
+    EXPECT_EQ(sl.size(), static_cast<std::size_t>(kKeys));
+    std::string v;
+    ASSERT_TRUE(sl.Get(key(3), v));
+    EXPECT_EQ(v, "v2");
+}
+
+TEST(MemTable, BloomFilter_Skips_Absent_Keys) {
+    MemTableOptions options;
+    options.bloom_expected_entries = 10000;
+    MemTable mt(options);
+    ASSERT_TRUE(mt.HasBloomFilter());
+
+    for (int i = 0; i < 10000; ++i) {
+        mt.Put("key" + std::to_string(i), "v" + std::to_string(i));
+    }
+    mt.Delete("key42");
+
+    // No false negatives, tombstones included.
+    std::string v;
+    for (int i = 0; i < 10000; ++i) {
+        if (i == 42) continue;
+        ASSERT_EQ(mt.Get("key" + std::to_string(i), v), MemTable::LookupResult::kFound);
+    }
+    EXPECT_EQ(mt.Get("key42", v), MemTable::LookupResult::kDeleted);
+    EXPECT_EQ(mt.bloom_skips(), 0u);
+
+    // Absent keys: nearly all are answered by the filter alone.
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_EQ(mt.Get("missing" + std::to_string(i), v), MemTable::LookupResult::kNotFound);
+    }
+    EXPECT_GT(mt.bloom_skips(), 9700u);
+}
+
+TEST(MemTable, Without_BloomFilter_Never_Skips) {
+    MemTable mt;
+    EXPECT_FALSE(mt.HasBloomFilter());
+    mt.Put("x", "1");
+    std::string v;
+    EXPECT_EQ(mt.Get("y", v), MemTable::LookupResult::kNotFound);
+    EXPECT_EQ(mt.bloom_skips(), 0u);
+}